@@ -62,10 +62,11 @@ int main(int argc, const char* argv[]) {
 	//float dbuf[buf_size];
 	while (true) {
 		size_t read = r.read_samples(buffer, buf_size);
-		//float comp_dB;
+		//float comp_dB[buf_size];
+		comp(buffer, buffer, read/*, comp_dB*/);
 		for (size_t i = 0; i < read; ++i) {
-			buffer[i] = lim(comp(buffer[i]/*, &comp_dB*/));
-			//dbuf[i] = 0.5f * std::pow(10.f, comp_dB / 20.f);
+			buffer[i] = lim(buffer[i]);
+			//dbuf[i] = 0.5f * std::pow(10.f, comp_dB[i] / 20.f);
 		}
 
 		w.write_samples(buffer, read);
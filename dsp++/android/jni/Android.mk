@@ -11,7 +11,10 @@ LOCAL_ARM_MODE := arm
 LOCAL_CFLAGS := -DDSPXX_EXPORTS -DNDEBUG -fPIC -fvisibility=hidden -DDSP_FFTW_DISABLED
 
 ifeq ($(TARGET_ARCH_ABI),x86)
-  LOCAL_CFLAGS += -msse4.1
+  LOCAL_CFLAGS += -msse4.1 -DDSP_SIMD_AVX_DISABLED=1
+endif
+ifeq ($(TARGET_ARCH_ABI),armeabi)
+  LOCAL_CFLAGS += -DDSP_SIMD_NEON_DISABLED=1
 endif
 
 LOCAL_CPPFLAGS := -std=gnu++11
@@ -25,12 +28,19 @@ SRC := ../../src
 LOCAL_SRC_FILES := $(SRC)/arch/arm/cpu_arm.cpp \
   $(SRC)/debug.cpp $(SRC)/fft.cpp $(SRC)/filter.cpp $(SRC)/fixed.cpp $(SRC)/flt_biquad.cpp \
 	$(SRC)/flt_fs.cpp $(SRC)/flt_iir.cpp $(SRC)/flt_pm.cpp $(SRC)/resample.cpp $(SRC)/sample.cpp \
-	$(SRC)/simd.cpp $(SRC)/vectmath.cpp $(SRC)/zeropole.cpp $(SRC)/arch/x86/cpu_x86.cpp \
-	$(SRC)/arch/x86/sse.cpp $(SRC)/arch/x86/sse3.cpp $(SRC)/arch/x86/sse41.cpp \
+	$(SRC)/simd.cpp $(SRC)/simd_kernels.cpp $(SRC)/vectmath.cpp $(SRC)/zeropole.cpp $(SRC)/arch/x86/cpu_x86.cpp \
+	$(SRC)/arch/x86/sse.cpp $(SRC)/arch/x86/sse2.cpp $(SRC)/arch/x86/sse3.cpp $(SRC)/arch/x86/sse41.cpp \
 	$(SRC)/mkfilter/mkfilter.cpp $(SRC)/remez/remez.cpp \
 	$(SRC)/rpoly/rpoly.cpp $(SRC)/snd/format.cpp $(SRC)/snd/io.cpp $(SRC)/snd/loudness.cpp \
 	$(SRC)/fftw/traits.cpp
 
+# NEON kernels are selected in runtime, the .neon suffix enables NEON code generation for this file only
+ifneq ($(filter armeabi-v7a%,$(TARGET_ARCH_ABI)),)
+  LOCAL_SRC_FILES += $(SRC)/arch/arm/neon.cpp.neon
+else
+  LOCAL_SRC_FILES += $(SRC)/arch/arm/neon.cpp
+endif
+
 LOCAL_MODULE := dsp++
 include $(BUILD_SHARED_LIBRARY)
 
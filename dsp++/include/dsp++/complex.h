@@ -53,6 +53,13 @@ template<class Real> struct remove_complex<complex<Real> volatile> {typedef Real
 /// @copydoc remove_complex
 template<class Real> struct remove_complex<complex<Real> const volatile> {typedef Real type;};
 
+/// @brief Type-traits check whether the type is a complex number.
+template<class Real> struct is_complex {static const bool value = false;};
+/// @copydoc is_complex
+template<class Real> struct is_complex<complex<Real> > {static const bool value = true;};
+/// @copydoc is_complex
+template<class Real> struct is_complex<complex<Real> const> {static const bool value = true;};
+
 }
 
 #endif /* DSP_COMPLEX_H_INCLUDED */
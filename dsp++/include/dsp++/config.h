@@ -38,6 +38,16 @@
 #define DSP_FFTW_DISABLED 		0
 #endif // DSP_FFTW_DISABLED
 
+#ifndef DSP_SIMD_AVX_DISABLED
+//! @brief Set to 1 to disable building of AVX/FMA code paths (e.g. when the compiler can't target these instruction sets).
+#define DSP_SIMD_AVX_DISABLED	0
+#endif // DSP_SIMD_AVX_DISABLED
+
+#ifndef DSP_SIMD_NEON_DISABLED
+//! @brief Set to 1 to disable building of ARM NEON code paths (e.g. for ARM targets without Advanced SIMD unit).
+#define DSP_SIMD_NEON_DISABLED	0
+#endif // DSP_SIMD_NEON_DISABLED
+
 #ifndef DSP_BOOST_DISABLED
 //! @brief Set to 1 to disable use of boost libraries entirely.
 #define DSP_BOOST_DISABLED		0
@@ -63,6 +73,11 @@
 #define DSP_FFTW_HAVE_LONG_DOUBLE 	1
 #endif // DSP_FFTW_HAVE_LONG_DOUBLE
 
+#ifndef DSP_FFTW_THREADS_DISABLED
+//! @brief Set to 1 if libfftw3_threads is not available (multi-threaded plans are then created with 1 thread).
+#define DSP_FFTW_THREADS_DISABLED 	0
+#endif // DSP_FFTW_THREADS_DISABLED
+
 #ifndef DSP_FFTW_HAVE_QUAD
 //! @brief Set to 1 if libfftwq is available
 #define DSP_FFTW_HAVE_QUAD 	0
@@ -10,12 +10,20 @@
 #include <dsp++/algorithm.h>
 #include <dsp++/mean.h>
 #include <dsp++/complex.h>
+#include <dsp++/simd.h>
+#include <dsp++/trivial_array.h>
+#include <dsp++/vectmath.h>
 
 #include <limits>
 #include <algorithm>
 
 namespace dsp {
 
+/*!
+ * @brief Feed-forward compressor with envelope detector and attack/release transition of the compression ratio.
+ * @tparam Sample type of samples this algorithm works with.
+ * @tparam Envelope envelope detector, a functor returning signal level for subsequent samples like dsp::quadratic_mean.
+ */
 template<class Sample, class Envelope = dsp::quadratic_mean<Sample> >
 class compressor: public dsp::sample_based_transform<Sample> {
 public:
@@ -28,6 +36,7 @@ public:
 	 ,	attack_delta_(1.)
 	 ,	release_delta_(1.)
 	 ,	transition_(0)
+	 ,	buf_(2 * chunk_length)
 	{
 	}
 
@@ -50,18 +59,13 @@ public:
 	Sample operator()(Sample x, float* compression_dB = NULL) 
 	{
 		float ref = static_cast<float>(std::abs(envelope_(x)));			// get signal level from envelope detector
-		if (ref > threshold_)
-			transition_ = std::min(1., transition_ + attack_delta_);	// adjust transition value according to attack or release time
-		else if (ref < threshold_)
-			transition_ = std::max(0., transition_ - release_delta_);
-
-		float ratio = 1.f + static_cast<float>(transition_) * (ratio_ - 1.f);	// calculate compression ratio based on current transition value
+		float ratio = next_ratio(ref);
 
 		float rel = ref / threshold_;			// signal level w/ reference to threshold
 		if (ratio != 1.f)
 			rel = std::pow(rel, 1.f / ratio);	// scale dB value by ratio (signal level w/reference to threshold after gain is applied)
 
-		float gain = threshold_ * rel / ref;	// calculate actual gain
+		float gain = (ref > 0.f ? threshold_ * rel / ref : 1.f);	// calculate actual gain, silence is left as it is
 		if (NULL != compression_dB)
 		{
 			if (0.f == gain)
@@ -75,7 +79,85 @@ public:
 		return x;
 	}
 
+	/*!
+	 * @brief Block version of operator()(Sample, float*).
+	 * The gain @f$(ref/threshold)^{1/ratio - 1}@f$ is evaluated in log domain with dsp::simd::log2() and
+	 * dsp::simd::exp2() over chunks of samples, so the results differ from the per-sample version only by
+	 * the approximation error of these kernels (relative error of the gain below 1e-5).
+	 * @param[in] in input samples (length).
+	 * @param[out] out output samples (length), may be the same as in.
+	 * @param[in] length number of samples.
+	 * @param[out] compression_dB if not NULL, compression applied to each of the samples in dB (length).
+	 */
+	void operator()(const Sample* in, Sample* out, size_t length, float* compression_dB = NULL)
+	{
+		float* const lg = buf_.get();
+		float* const e = lg + chunk_length;
+		// Envelope and transition are advanced in the same loop (like in next_ratio(), but on local copies
+		// kept in registers), so that their dependency chains overlap; gain is evaluated for the whole chunk.
+		const float threshold = threshold_;
+		const float inv_threshold = 1.f / threshold_;
+		const float ratio_1 = ratio_ - 1.f;
+		double transition = transition_;
+		while (0 != length) {
+			const size_t L = (length < chunk_length ? length : chunk_length);
+			const size_t L_pad = dsp::simd::aligned_count<float>(L);
+			bool compress = false;
+			for (size_t n = 0; n < L; ++n) {
+				const float ref = static_cast<float>(std::abs(envelope_(in[n])));
+				if (ref > threshold)
+					transition = std::min(1., transition + attack_delta_);
+				else if (ref < threshold)
+					transition = std::max(0., transition - release_delta_);
+				const float ratio = 1.f + static_cast<float>(transition) * ratio_1;
+				compress |= (ratio != 1.f);
+				lg[n] = (ref > 0.f ? ref * inv_threshold : 1.f);	// log2(1) = 0 leaves silence as it is
+				e[n] = 1.f / ratio - 1.f;
+			}
+			if (!compress) {	// released throughout the chunk, only the constant gain is applied
+				if (NULL != compression_dB) {
+					std::fill_n(compression_dB, L, 0.f);
+					compression_dB += L;
+				}
+				for (size_t n = 0; n < L; ++n)
+					out[n] = static_cast<Sample>(gain_ * in[n]);
+			}
+			else {
+				std::fill(lg + L, lg + L_pad, 1.f);
+				std::fill(e + L, e + L_pad, 0.f);
+				dsp::simd::log2(lg, lg, L_pad);
+				dsp::simd::mul(lg, lg, e, L_pad);		// log2 of the gain
+				if (NULL != compression_dB) {
+					const float dB_per_log2 = 6.02059991f;	// 20 * log10(2)
+					for (size_t n = 0; n < L; ++n)
+						compression_dB[n] = lg[n] * dB_per_log2;
+					compression_dB += L;
+				}
+				dsp::simd::exp2(lg, lg, L_pad);
+				dsp::simd::mul(lg, lg, gain_, L_pad);
+				for (size_t n = 0; n < L; ++n)
+					out[n] = static_cast<Sample>(lg[n] * in[n]);
+			}
+			in += L;
+			out += L;
+			length -= L;
+		}
+		transition_ = transition;
+	}
+
 private:
+	static const size_t chunk_length = 64;	//!< Number of samples processed at once by the block operator().
+
+	//! @brief Advance attack/release transition for signal level ref and calculate current compression ratio.
+	float next_ratio(float ref)
+	{
+		if (ref > threshold_)
+			transition_ = std::min(1., transition_ + attack_delta_);	// adjust transition value according to attack or release time
+		else if (ref < threshold_)
+			transition_ = std::max(0., transition_ - release_delta_);
+		return 1.f + static_cast<float>(transition_) * (ratio_ - 1.f);	// calculate compression ratio based on current transition value
+	}
+
 	Envelope envelope_;
 	float threshold_;
 	float gain_;
@@ -83,6 +165,7 @@ private:
 	double attack_delta_;
 	double release_delta_;
 	double transition_;
+	trivial_array<float, dsp::simd::allocator<float> > buf_;	//!< log2 of the gain and its exponent (2 * chunk_length).
 };
 
 template<class In> 
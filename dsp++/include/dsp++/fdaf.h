@@ -69,8 +69,8 @@ public:
 	 ,	d(d_, N_)
      ,	y(y_ + N_, N_)
      ,	e(e_, N_)
-	 ,	W(W_, 2*N_)
-	 ,	power(norm_, 2*N_)
+	 ,	W(W_, N_ + 1)
+	 ,	power(norm_, N_ + 1)
 	{
 		std::fill_n(rbuf_, 8*N_, value_type());
 		std::fill_n(cbuf_, 6*N_, complex_type());
@@ -111,7 +111,7 @@ public:
 	void operator()() 
 	{
 		dft_(x_, X_);															// X = FFT{x()}
-		std::transform(X_, X_ + 2*N_, W_, E_, std::multiplies<complex_type>());	// y() = IFFT{X * W}, using E_ as temporary variable
+		std::transform(X_, X_ + N_ + 1, W_, E_, std::multiplies<complex_type>());	// y() = IFFT{X * W}, using E_ as temporary variable
 		idft_(E_, y_);						
 		std::transform(y_ + N_, y_ + 2*N_, y_ + N_, std::bind2nd(std::divides<value_type>(), 2*N_)); // scale IFFT (only applied to 2nd half of y_, 1st one is irrelevant)
 		std::transform(d_, d_ + N_, y_ + N_, e_, std::minus<value_type>());		// e() = d() - y(), e_ is now ready
@@ -121,7 +121,7 @@ public:
 
 		value_type ombet = value_type(1) - beta_;
 		complex_iterator E = E_, N = norm_, X = X_;
-		for (size_t i = 0; i < 2*N_; ++i, ++E, ++N, ++X) {			
+		for (size_t i = 0; i <= N_; ++i, ++E, ++N, ++X) {			
 			complex_type cX = std::conj(*X);
 			(*N *= beta_) += ombet * std::real(*X * cX);	// update signal power 
 			(*E) *= (cX / (*N + offset_));					// multiply E with conjugate of X and normalize
@@ -131,7 +131,7 @@ public:
 		std::fill_n(w_ + N_, N_, value_type());							// discard and zero-fill 2nd half of w_
 		dft_(w_, E_);													// FFT w_ back to DFT domain
 		complex_iterator W = W_; E = E_;
-		for (size_t i = 0; i < 2*N_; ++i, ++W, ++E) 					// update W with forgetting-factor-multiplied error transform
+		for (size_t i = 0; i <= N_; ++i, ++W, ++E) 					// update W with forgetting-factor-multiplied error transform
 			(*W *= lambda_) += *E;
 
 		tick_input();
@@ -154,10 +154,10 @@ private:
 	value_type* const w_;	//!< (2N) real-valued work area
 	value_type* const e_;	//!< (N) error output vector, e() = d() - y()
 	value_type* const d_;	//!< (N) desired response input vector
-	complex_type* const X_;	//!< (2N) FFT(x()) output
-	complex_type* const E_;	//!< (2N) FFT(e()) output
-	complex_type* const W_; //!< (2N) adaptive weights transform
-	complex_type* const norm_;	//!< (2N) signal power for normalization
+	complex_type* const X_;	//!< (N + 1) FFT(x()) output (only non-redundant half of the spectrum is used)
+	complex_type* const E_;	//!< (N + 1) FFT(e()) output
+	complex_type* const W_; //!< (N + 1) adaptive weights transform
+	complex_type* const norm_;	//!< (N + 1) signal power for normalization
 
 	value_type mu_;				//!< step size mu
 	value_type lambda_;			//!< leakage factor 
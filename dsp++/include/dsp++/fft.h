@@ -18,6 +18,7 @@
 #include <memory>
 #include <algorithm>
 #include <functional>
+#include <vector>
 
 #include <dsp++/fft/detail.h>
 
@@ -41,12 +42,28 @@ class fft<Real, complex<Real> >;
 template<class Real>
 class fft<complex<Real>, Real >;
 
+/*!
+ * @brief Find the transform length not less than @p min_length which is the cheapest to compute.
+ * The result is a product of powers of 2, 3, 5 and 7 chosen according to the estimated cost of
+ * butterfly stages of dsp::dft::fft, so it is never greater than nextpow2(min_length). Such
+ * lengths are also handled efficiently by FFTW, so this may be used regardless of DFT implementation
+ * when choosing the size of zero-padded transform (e.g. for fast convolution).
+ * @param min_length minimum transform length.
+ * @return the cheapest transform length which is not less than min_length (and at least 2).
+ */
+DSPXX_API size_t fast_length(size_t min_length);
+
 
 /*!
  * @brief Functor for computing Discrete Fourier Transform (DFT).
  * This class implements DFT of complex sequences. The complex number domain
- * is determined by the template parameter Real. The DFT is calculated
- * through FFT algorithm (Cooley-Tukey) with Danielson-Lanczos recursion.
+ * is determined by the template parameter Real. The DFT of power-of-2 length is calculated
+ * through FFT algorithm (Cooley-Tukey) with Danielson-Lanczos recursion, or with radix-4 stages
+ * using SIMD instructions if the processor supports them (see dsp::simd::features()): SSE or AVX on x86,
+ * NEON on ARM (single precision only, double precision transforms are scalar there). Other lengths are
+ * handled with mixed-radix (2, 3, 4, 5, 7 and other small primes) Cooley-Tukey algorithm, and
+ * lengths having large prime factors with Bluestein's algorithm (which is considerably slower,
+ * so use fast_length() to choose the transform size whenever possible).
  * The "canonical" DFT equation is:
  * @f[
  * X_k = \sum_{n=0}^{N-1} x_n \cdot e^{-i2\pi\frac{k}{N}n}
@@ -76,7 +93,7 @@ public:
 	typedef std::allocator<output_type> output_allocator;
 
 	/*!
-	 * @brief Initialize FFT functor to calculate DFT via FFT of power-of-2 sized sequence.
+	 * @brief Initialize FFT functor to calculate DFT via FFT of N-point sequence.
 	 * @param N transform length (and the size of input/output vectors).
 	 * @param input the input samples (may be @c NULL if only operator()(input_type*, output_type*) const
 	 * is going to be used).
@@ -84,11 +101,39 @@ public:
 	 * May be @c NULL if only operator()(input_type*, output_type*) const is going to be used, or if the
 	 * input is not @c NULL, and the transform should be performed in-place.
 	 * @param sign transform direction (sign of the exponent in canonical DFT equation).
-	 * @throw std::domain_error is thrown if N is not an integer power of 2.
-	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{28}@f$.
+	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{26}@f$.
 	 */
 	fft(size_t N, input_type* input = NULL, output_type* output = NULL, sign::spec sign = sign::forward)
-	 :	size_(N), input_(input), output_(output), sign_(sign)
+	 :	size_(N), howmany_(1), istride_(1), idist_(N), ostride_(1), odist_(N)
+	 ,	input_(input), output_(output), sign_(sign)
+	 ,	impl_(&detail::fft_impl<Real>::get(N))
+	{}
+
+	/*!
+	 * @brief Initialize FFT functor to calculate a batch of N-point transforms of several sequences at once
+	 * (the same way as fftw_plan_many_dft() does for 1-dimensional transforms). The k-th sample of t-th
+	 * input sequence is input[t * idist + k * istride], and the output is stored the same way.
+	 * Sequences stored back-to-back (with unit stride and distance of N samples) are transformed stage
+	 * by stage, so that the dispatch and twiddle factor loads are shared by the whole batch.
+	 * @param N transform length.
+	 * @param howmany number of transformed sequences.
+	 * @param input the input samples (may be @c NULL if only operator()(input_type*, output_type*) const
+	 * is going to be used).
+	 * @param istride distance between consecutive samples of input sequence.
+	 * @param idist distance between the first samples of consecutive input sequences.
+	 * @param output the vector which will contain samples of calculated transforms (may be @c NULL for
+	 * in-place transform, in which case the output has the same layout as the input).
+	 * @param ostride distance between consecutive samples of output sequence.
+	 * @param odist distance between the first samples of consecutive output sequences.
+	 * @param sign transform direction (sign of the exponent in canonical DFT equation).
+	 * @note Output with non-unit stride needs N * howmany samples of temporary storage, which is allocated
+	 * upon each invocation.
+	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{26}@f$.
+	 */
+	fft(size_t N, size_t howmany, input_type* input, size_t istride, size_t idist,
+			output_type* output, size_t ostride, size_t odist, sign::spec sign = sign::forward)
+	 :	size_(N), howmany_(howmany), istride_(istride), idist_(idist), ostride_(ostride), odist_(odist)
+	 ,	input_(input), output_(output), sign_(sign)
 	 ,	impl_(&detail::fft_impl<Real>::get(N))
 	{}
 
@@ -98,7 +143,9 @@ public:
 	 * @param other the fft instance to copy.
 	 */
 	fft(const fft& other)
-	 : size_(other.size_), input_(other.input_), output_(other.output_), sign_(other.sign_)
+	 :	size_(other.size_), howmany_(other.howmany_), istride_(other.istride_), idist_(other.idist_)
+	 ,	ostride_(other.ostride_), odist_(other.odist_)
+	 ,	input_(other.input_), output_(other.output_), sign_(other.sign_)
 	 ,	impl_(other.impl_)
 	{}
 
@@ -109,11 +156,27 @@ public:
 	 */
 	void operator()(input_type* input, output_type* output) const
 	{
-		if (NULL == output)
-			output = input;
+		if (NULL != output && output != input)
+			operator()(static_cast<const input_type*>(input), output);
+		else if (1 != howmany_ || 1 != istride_)
+			transform_many(input, input, istride_, idist_);
 		else
-			std::copy(input, input + size_, output);
-		impl_->fft(output, sign_);
+			impl_->fft(input, sign_);
+	}
+
+	/*!
+	 * @brief Invoke the FFT algorithm for the specified input & output vectors, leaving the input intact.
+	 * Single transform of contiguous samples is performed out-of-place, so that the input is read directly by
+	 * the algorithm instead of being copied to the output first.
+	 * @param input input samples vector.
+	 * @param output output samples vector (must not overlap the input).
+	 */
+	void operator()(const input_type* input, output_type* output) const
+	{
+		if (1 != howmany_ || 1 != istride_ || 1 != ostride_)
+			transform_many(input, output, ostride_, odist_);
+		else
+			impl_->fft(input, output, sign_);
 	}
 
 	//! @brief Invoke the FFT algorithm for the input & output vectors set up in the constructor.
@@ -121,23 +184,44 @@ public:
 
 	//! @return the transform size (N in the equation above).
 	size_t size() const {return size_;}
+	//! @return number of sequences transformed by each invocation.
+	size_t howmany() const {return howmany_;}
 
 private:
 	size_t size_;
+	size_t howmany_;
+	size_t istride_, idist_;
+	size_t ostride_, odist_;
 	input_type* input_;
 	output_type* output_;
 	sign::spec sign_;
 	const detail::fft_impl<Real>* impl_;
-	friend class fft<Real, complex<Real> >;
-	friend class fft<complex<Real>, Real >;
+
+	void transform_many(const input_type* input, output_type* output, size_t ostride, size_t odist) const
+	{
+		if (1 != ostride) {
+			std::vector<output_type> buf(size_ * howmany_);
+			detail::copy_many(input, istride_, idist_, &buf[0], 1, size_, size_, howmany_);
+			impl_->fft_many(&buf[0], howmany_, size_, sign_);
+			detail::copy_many(&buf[0], 1, size_, output, ostride, odist, size_, howmany_);
+			return;
+		}
+		if (input != output)
+			detail::copy_many(input, istride_, idist_, output, 1, odist, size_, howmany_);
+		impl_->fft_many(output, howmany_, odist, sign_);
+	}
 };
 
 /*!
- * @brief Forward FFT of real data. The resulting complex output sequence will have Hermitian symmetry.
+ * @brief Forward FFT of real data. The resulting complex output sequence will have Hermitian symmetry,
+ * therefore only the first N/2 + 1 bins are calculated.
+ * For even N the transform is computed through N/2-point complex FFT of the input viewed as complex
+ * sequence (even samples as real part, odd samples as imaginary part), followed by a post-processing
+ * pass which splits the spectra of even and odd samples and combines them into the N-point one. This
+ * takes roughly half of the time and memory bandwidth of the complex transform of the same length.
  */
 template<class Real>
 class fft<Real, complex<Real> > {
-	typedef fft<complex<Real>, complex<Real> > fft_type;
 public:
 	typedef Real domain_type;
 	typedef Real input_type;
@@ -147,17 +231,38 @@ public:
 
 	/*!
 	 * @brief Initialize FFT functor to perform forward, real-to-complex data DFT of specified transform length.
-	 * @param N transform length (and the size of input/output vectors). Must be the integer power of 2.
-	 * @param input the input samples (may be @c NULL if only operator()(input_type*, output_type*) const
+	 * @param N transform length (and the size of input vector).
+	 * @param input the input samples (may be @c NULL if only operator()(const input_type*, output_type*) const
 	 * is going to be used).
-	 * @param output the vector which will contain samples of calculated transform.
-	 * May be @c NULL if only operator()(input_type*, output_type*) const is going to be used, or if the
-	 * input is not @c NULL, and the transform should be performed in-place.
-	 * @throw std::domain_error is thrown if N is not an integer power of 2.
-	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{28}@f$.
+	 * @param output the vector which will contain N/2 + 1 samples of calculated transform.
+	 * May be @c NULL if only operator()(const input_type*, output_type*) const is going to be used.
+	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{26}@f$.
 	 */
 	fft(size_t N, input_type* input = NULL, output_type* output = NULL, sign::spec = sign::forward)
-	 :	fft_(N, reinterpret_cast<typename fft_type::input_type*>(input), output, sign::forward)
+	 :	size_(N), howmany_(1), istride_(1), idist_(N), ostride_(1), odist_(N / 2 + 1)
+	 ,	input_(input), output_(output)
+	 ,	impl_(&detail::real_fft_impl<Real>::get(N))
+	{}
+
+	/*!
+	 * @brief Initialize FFT functor to perform a batch of forward, real-to-complex data DFTs (the same way as
+	 * fftw_plan_many_dft_r2c() does for 1-dimensional transforms), see fft<complex<Real>, complex<Real> >.
+	 * @param N transform length.
+	 * @param howmany number of transformed sequences.
+	 * @param input the input samples (N samples per sequence).
+	 * @param istride distance between consecutive samples of input sequence.
+	 * @param idist distance between the first samples of consecutive input sequences.
+	 * @param output the vector which will contain the transforms (N/2 + 1 samples per sequence).
+	 * @param ostride distance between consecutive samples of output sequence.
+	 * @param odist distance between the first samples of consecutive output sequences.
+	 * @note Non-unit strides need temporary storage, which is allocated upon each invocation.
+	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{26}@f$.
+	 */
+	fft(size_t N, size_t howmany, input_type* input, size_t istride, size_t idist,
+			output_type* output, size_t ostride, size_t odist, sign::spec = sign::forward)
+	 :	size_(N), howmany_(howmany), istride_(istride), idist_(idist), ostride_(ostride), odist_(odist)
+	 ,	input_(input), output_(output)
+	 ,	impl_(&detail::real_fft_impl<Real>::get(N))
 	{}
 
 	/*!
@@ -165,36 +270,64 @@ public:
 	 * Since only references to const, preallocated objects are used this is cheap.
 	 * @param other the fft instance to copy.
 	 */
-	fft(const fft& other): fft_(other.fft_) {}
+	fft(const fft& other)
+	 :	size_(other.size_), howmany_(other.howmany_), istride_(other.istride_), idist_(other.idist_)
+	 ,	ostride_(other.ostride_), odist_(other.odist_)
+	 ,	input_(other.input_), output_(other.output_)
+	 ,	impl_(other.impl_)
+	{}
 
 	/*!
-	 * @brief Invoke FFT algorithm on the vectors provided in the constructor (which must not be @c NULL in this case).
+	 * @brief Invoke FFT algorithm on the specified input & output vectors.
 	 * @note Contrary to the version of this  operator specialized for complex-to-complex transform,
 	 * output param must not be set to @c NULL, as the input and output types (and the byte sizes of vectors) differ.
-	 * @param input input samples vector.
-	 * @param output output samples vector.
+	 * The output vector may however start at the same address as the input one, provided it is big enough to hold
+	 * N/2 + 1 complex samples.
+	 * @param input input samples vector (N samples).
+	 * @param output output samples vector (N/2 + 1 samples).
 	 */
-	void operator()(input_type* input, output_type* output) const
+	void operator()(const input_type* input, output_type* output) const
 	{
-		std::copy(input, input + fft_.size_, output);
-		fft_.operator()(output, NULL);
+		if (1 == istride_ && 1 == ostride_)
+			impl_->forward_many(input, idist_, output, odist_, howmany_);
+		else
+			transform_strided(input, output);
 	}
 
 	//! @brief Invoke the FFT algorithm for the input & output vectors set up in the constructor.
-	void operator()() const	{operator()(const_cast<input_type*>(reinterpret_cast<const input_type*>(fft_.input_)), fft_.output_);}
+	void operator()() const	{operator()(input_, output_);}
 
 	//! @return the transform size (N in the equation above).
-	size_t size() const {return fft_.size();}
+	size_t size() const {return size_;}
+	//! @return number of sequences transformed by each invocation.
+	size_t howmany() const {return howmany_;}
 private:
-	fft_type fft_;
+	size_t size_;
+	size_t howmany_;
+	size_t istride_, idist_;
+	size_t ostride_, odist_;
+	input_type* input_;
+	output_type* output_;
+	const detail::real_fft_impl<Real>* impl_;
+
+	void transform_strided(const input_type* input, output_type* output) const
+	{
+		const size_t K = size_ / 2 + 1;
+		std::vector<input_type> in(size_ * howmany_);
+		std::vector<output_type> out(K * howmany_);
+		detail::copy_many(input, istride_, idist_, &in[0], 1, size_, size_, howmany_);
+		impl_->forward_many(&in[0], size_, &out[0], K, howmany_);
+		detail::copy_many(&out[0], 1, K, output, ostride_, odist_, K, howmany_);
+	}
 };
 
 /*!
  * @brief Inverse FFT of complex, Hermitian symmetry data.
+ * Only the first N/2 + 1 input bins are used (the remaining ones are implied by the symmetry).
+ * For even N the transform is computed through N/2-point complex inverse FFT, see fft<Real, complex<Real> >.
  */
 template<class Real>
 class fft<complex<Real>, Real> {
-	typedef fft<complex<Real>, complex<Real> > fft_type;
 public:
 	typedef Real domain_type;
 	typedef complex<Real> input_type;
@@ -204,17 +337,38 @@ public:
 
 	/*!
 	 * @brief Initialize FFT functor to perform backward, complex-to-real data DFT of specified transform length.
-	 * @param N transform length (and the size of input/output vectors). Must be the integer power of 2.
+	 * @param N transform length (and the size of output vector).
 	 * @param input the input samples (may be @c NULL if only operator()(input_type*, output_type*) const
 	 * is going to be used).
 	 * @param output the vector which will contain samples of calculated transform.
-	 * May be @c NULL if only operator()(input_type*, output_type*) const is going to be used, or if the
-	 * input is not @c NULL, and the transform should be performed in-place.
-	 * @throw std::domain_error is thrown if N is not an integer power of 2.
-	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{28}@f$.
+	 * May be @c NULL if only operator()(input_type*, output_type*) const is going to be used.
+	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{26}@f$.
 	 */
 	fft(size_t N, input_type* input = NULL, output_type* output = NULL, sign::spec = sign::backward)
-	 :	fft_(N, input, reinterpret_cast<complex<Real>*>(output), sign::backward)
+	 :	size_(N), howmany_(1), istride_(1), idist_(N / 2 + 1), ostride_(1), odist_(N)
+	 ,	input_(input), output_(output)
+	 ,	impl_(&detail::real_fft_impl<Real>::get(N))
+	{}
+
+	/*!
+	 * @brief Initialize FFT functor to perform a batch of backward, complex-to-real data DFTs (the same way as
+	 * fftw_plan_many_dft_c2r() does for 1-dimensional transforms), see fft<complex<Real>, complex<Real> >.
+	 * @param N transform length.
+	 * @param howmany number of transformed sequences.
+	 * @param input the input samples (N/2 + 1 samples per sequence, overwritten upon invocation).
+	 * @param istride distance between consecutive samples of input sequence.
+	 * @param idist distance between the first samples of consecutive input sequences.
+	 * @param output the vector which will contain the transforms (N samples per sequence).
+	 * @param ostride distance between consecutive samples of output sequence.
+	 * @param odist distance between the first samples of consecutive output sequences.
+	 * @note Non-unit strides need temporary storage, which is allocated upon each invocation.
+	 * @throw std::out_of_range is thrown if @f$N < 2@f$ or @f$N > 2^{26}@f$.
+	 */
+	fft(size_t N, size_t howmany, input_type* input, size_t istride, size_t idist,
+			output_type* output, size_t ostride, size_t odist, sign::spec = sign::backward)
+	 :	size_(N), howmany_(howmany), istride_(istride), idist_(idist), ostride_(ostride), odist_(odist)
+	 ,	input_(input), output_(output)
+	 ,	impl_(&detail::real_fft_impl<Real>::get(N))
 	{}
 
 	/*!
@@ -222,36 +376,57 @@ public:
 	 * Since only references to const, preallocated objects are used this is cheap.
 	 * @param other the fft instance to copy.
 	 */
-	fft(const fft& other): fft_(other.fft_) {}
+	fft(const fft& other)
+	 :	size_(other.size_), howmany_(other.howmany_), istride_(other.istride_), idist_(other.idist_)
+	 ,	ostride_(other.ostride_), odist_(other.odist_)
+	 ,	input_(other.input_), output_(other.output_)
+	 ,	impl_(other.impl_)
+	{}
 
 	/*!
-	 * @brief Invoke FFT algorithm on the vectors provided in the constructor (which must not be @c NULL in this case).
+	 * @brief Invoke FFT algorithm on the specified input & output vectors.
 	 * @note Contrary to the version of this  operator specialized for complex-to-complex transform,
 	 * output param must not be set to @c NULL, as the input and output types (and the byte sizes of vectors) differ.
-	 * It is enough to provide N/2 + 1 complex samples in the input vector, as the remaining ones will be ignored
-	 * (they are assumed to have Hermitian symmetry), nevertheless the vector still must be big enough to store all N
-	 * complex samples, as it is used for as temporary space. Consequently, be prepared that its contents will be
-	 * overwritten.
-	 * @param input input samples vector.
-	 * @param output output samples vector.
+	 * It is enough to provide N/2 + 1 complex samples in the input vector, as the remaining ones are implied by
+	 * Hermitian symmetry. The input vector is used as temporary space, so be prepared that its contents will be
+	 * overwritten (the same way as FFTW does for complex-to-real transforms). The output vector may start at the same
+	 * address as the input one.
+	 * @param input input samples vector (N/2 + 1 samples).
+	 * @param output output samples vector (N samples).
 	 */
 	void operator()(input_type* input, output_type* output) const
 	{
-		for (size_t i = fft_.size_ / 2 + 1; i < fft_.size_; ++i)
-			input[i] = std::conj(input[fft_.size_ - i]);
-		fft_.operator()(reinterpret_cast<input_type*>(input), NULL);
-		for (size_t i = 0; i < fft_.size_; ++i)
-			*output++ = (input++)->real();
+		if (1 == istride_ && 1 == ostride_)
+			impl_->backward_many(input, idist_, output, odist_, howmany_);
+		else
+			transform_strided(input, output);
 	}
 
 	//! @brief Invoke the FFT algorithm for the input & output vectors set up in the constructor.
-	void operator()() const
-	{operator()(fft_.input_, const_cast<output_type*>(reinterpret_cast<const output_type*>(fft_.output_)));}
+	void operator()() const {operator()(input_, output_);}
 
 	//! @return the transform size (N in the equation above).
-	size_t size() const {return fft_.size();}
+	size_t size() const {return size_;}
+	//! @return number of sequences transformed by each invocation.
+	size_t howmany() const {return howmany_;}
 private:
-	fft_type fft_;
+	size_t size_;
+	size_t howmany_;
+	size_t istride_, idist_;
+	size_t ostride_, odist_;
+	input_type* input_;
+	output_type* output_;
+	const detail::real_fft_impl<Real>* impl_;
+
+	void transform_strided(input_type* input, output_type* output) const
+	{
+		const size_t K = size_ / 2 + 1;
+		std::vector<input_type> in(K * howmany_);
+		std::vector<output_type> out(size_ * howmany_);
+		detail::copy_many(input, istride_, idist_, &in[0], 1, K, K, howmany_);
+		impl_->backward_many(&in[0], K, &out[0], size_, howmany_);
+		detail::copy_many(&out[0], 1, size_, output, ostride_, odist_, size_, howmany_);
+	}
 };
 
 }} // namespace dsp::dft
@@ -16,10 +16,26 @@ namespace dft {
 
 template<class Input, class Output> class fft;
 template<class Real> class fft<complex<Real>, complex<Real> >;
+template<class Real> class fft<Real, complex<Real> >;
+template<class Real> class fft<complex<Real>, Real>;
 
 /// @internal Implementation details. Do not use.
 namespace detail {
 
+template<class Real> class real_fft_impl;
+
+/// @internal Copy howmany sequences of n samples between strided layouts.
+template<class Input, class Output>
+void copy_many(const Input* in, size_t istride, size_t idist, Output* out, size_t ostride, size_t odist, size_t n, size_t howmany)
+{
+	for (size_t t = 0; t < howmany; ++t, in += idist, out += odist) {
+		const Input* i = in;
+		Output* o = out;
+		for (size_t k = 0; k < n; ++k, i += istride, o += ostride)
+			*o = *i;
+	}
+}
+
 /// @internal
 template<class Real>
 class fft_impl {
@@ -28,7 +44,13 @@ public:
 
 private:
 	virtual void fft(complex<Real>* in_out, sign::spec sign) const = 0;
+	/// @internal Out-of-place transform, in and out must not overlap.
+	virtual void fft(const complex<Real>* in, complex<Real>* out, sign::spec sign) const = 0;
+	/// @internal In-place transform of howmany sequences of contiguous samples, starting dist samples apart.
+	/// The default implementation simply invokes fft() for each of them.
+	virtual void fft_many(complex<Real>* in_out, size_t howmany, size_t dist, sign::spec sign) const;
 	friend class dsp::dft::fft<complex<Real>, complex<Real> >;
+	friend class real_fft_impl<Real>;
 	static const fft_impl& get(size_t n);
 };
 
@@ -39,7 +61,10 @@ public:
 	virtual ~fft_impl();
 private:
 	virtual void fft(complex<float>* in_out, sign::spec sign) const = 0;
+	virtual void fft(const complex<float>* in, complex<float>* out, sign::spec sign) const = 0;
+	virtual void fft_many(complex<float>* in_out, size_t howmany, size_t dist, sign::spec sign) const;
 	friend class dsp::dft::fft<complex<float>, complex<float> >;
+	friend class real_fft_impl<float>;
 	static const fft_impl& get(size_t n);
 };
 
@@ -50,10 +75,83 @@ public:
 	virtual ~fft_impl();
 private:
 	virtual void fft(complex<double>* in_out, sign::spec sign) const = 0;
+	virtual void fft(const complex<double>* in, complex<double>* out, sign::spec sign) const = 0;
+	virtual void fft_many(complex<double>* in_out, size_t howmany, size_t dist, sign::spec sign) const;
 	friend class dsp::dft::fft<complex<double>, complex<double> >;
+	friend class real_fft_impl<double>;
 	static const fft_impl& get(size_t n);
 };
 
+/// @internal Real-data transform, computed through N/2-point complex FFT.
+template<class Real>
+class real_fft_impl {
+public:
+	virtual ~real_fft_impl();
+
+protected:
+	/// @internal Access to batched complex transform for the implementations.
+	static const fft_impl<Real>& complex_impl(size_t n) {return fft_impl<Real>::get(n);}
+	static void fft_many(const fft_impl<Real>& impl, complex<Real>* in_out, size_t howmany, size_t dist, sign::spec sign)
+	{impl.fft_many(in_out, howmany, dist, sign);}
+	static void fft(const fft_impl<Real>& impl, const complex<Real>* in, complex<Real>* out, sign::spec sign)
+	{impl.fft(in, out, sign);}
+
+private:
+	virtual void forward(const Real* in, complex<Real>* out) const = 0;
+	virtual void backward(complex<Real>* in, Real* out) const = 0;
+	/// @internal Batched versions of forward() and backward() for sequences of contiguous samples, dist samples apart.
+	/// The default implementations simply invoke forward() or backward() for each of them.
+	virtual void forward_many(const Real* in, size_t idist, complex<Real>* out, size_t odist, size_t howmany) const;
+	virtual void backward_many(complex<Real>* in, size_t idist, Real* out, size_t odist, size_t howmany) const;
+	friend class dsp::dft::fft<Real, complex<Real> >;
+	friend class dsp::dft::fft<complex<Real>, Real>;
+	static const real_fft_impl& get(size_t n);
+};
+
+/// @internal
+template<>
+class DSPXX_API real_fft_impl<float> {
+public:
+	virtual ~real_fft_impl();
+protected:
+	static const fft_impl<float>& complex_impl(size_t n) {return fft_impl<float>::get(n);}
+	static void fft_many(const fft_impl<float>& impl, complex<float>* in_out, size_t howmany, size_t dist, sign::spec sign)
+	{impl.fft_many(in_out, howmany, dist, sign);}
+	static void fft(const fft_impl<float>& impl, const complex<float>* in, complex<float>* out, sign::spec sign)
+	{impl.fft(in, out, sign);}
+
+private:
+	virtual void forward(const float* in, complex<float>* out) const = 0;
+	virtual void backward(complex<float>* in, float* out) const = 0;
+	virtual void forward_many(const float* in, size_t idist, complex<float>* out, size_t odist, size_t howmany) const;
+	virtual void backward_many(complex<float>* in, size_t idist, float* out, size_t odist, size_t howmany) const;
+	friend class dsp::dft::fft<float, complex<float> >;
+	friend class dsp::dft::fft<complex<float>, float>;
+	static const real_fft_impl& get(size_t n);
+};
+
+/// @internal
+template<>
+class DSPXX_API real_fft_impl<double> {
+public:
+	virtual ~real_fft_impl();
+protected:
+	static const fft_impl<double>& complex_impl(size_t n) {return fft_impl<double>::get(n);}
+	static void fft_many(const fft_impl<double>& impl, complex<double>* in_out, size_t howmany, size_t dist, sign::spec sign)
+	{impl.fft_many(in_out, howmany, dist, sign);}
+	static void fft(const fft_impl<double>& impl, const complex<double>* in, complex<double>* out, sign::spec sign)
+	{impl.fft(in, out, sign);}
+
+private:
+	virtual void forward(const double* in, complex<double>* out) const = 0;
+	virtual void backward(complex<double>* in, double* out) const = 0;
+	virtual void forward_many(const double* in, size_t idist, complex<double>* out, size_t odist, size_t howmany) const;
+	virtual void backward_many(complex<double>* in, size_t idist, double* out, size_t odist, size_t howmany) const;
+	friend class dsp::dft::fft<double, complex<double> >;
+	friend class dsp::dft::fft<complex<double>, double>;
+	static const real_fft_impl& get(size_t n);
+};
+
 }}}
 
 #endif /* DSP_FFT_DETAIL_H_INCLUDED */
@@ -14,8 +14,13 @@
 #include <dsp++/export.h>
 #include <dsp++/fftw/traits.h>
 #include <dsp++/fftw/allocator.h>
+#include <dsp++/fftw/plan_cache.h>
+#include <dsp++/noncopyable.h>
 #include <boost/shared_ptr.hpp>
 #include <dsp++/dft.h>
+#include <limits>
+#include <new>
+#include <string>
 
 namespace dsp { namespace dft { namespace fftw {
 
@@ -63,19 +68,106 @@ namespace dsp { namespace dft { namespace fftw {
 		 * wisdom.
 		 * @see fftw_forget_wisdom()
 		 */
-		static void forget_wisdom() {traits_type::forget_wisdom();}
+		static void forget_wisdom() {plan_cache::lock l; traits_type::forget_wisdom();}
 		/*!
 		 * @brief Calls @c traits::cleanup() to perform libfftw cleanup for this type's
-		 * variant of library.
+		 * variant of library. The plan cache is cleared first, but all the plans in use must
+		 * be destroyed before calling this function.
 		 * @see fftw_cleanup()
 		 */
-		static void cleanup() {traits_type::cleanup();}
+		static void cleanup()
+		{
+			plan_cache::clear();
+			plan_cache::lock l;
+			thread_state& s = threads_state();
+			if (s.initialized) {
+				traits_type::cleanup_threads();
+				s.initialized = false;
+			}
+			else
+				traits_type::cleanup();
+		}
 		/*!
 		 * @brief Calls @c traits::set_timelimit() to configure maximum time (in seconds)
 		 * the planner is allowed to run (-1 for no limit).
 		 * @see fftw_set_timelimit()
 		 */
-		static void set_planner_timelimit(double t) {traits_type::set_timelimit(t);}
+		static void set_planner_timelimit(double t) {plan_cache::lock l; traits_type::set_timelimit(t);}
+
+		//! @brief Value of nthreads constructor parameter selecting the number of threads set with set_planner_threads().
+		static const unsigned threads_default = 0;
+		/*!
+		 * @brief Calls @c traits::init_threads() once to enable multi-threaded plans in this type's variant of library.
+		 * This is done implicitly when the first plan using more than 1 thread is created.
+		 * @return true if libfftw threads are available (false if dsp++ is built with DSP_FFTW_THREADS_DISABLED).
+		 * @see fftw_init_threads()
+		 */
+		static bool init_threads()
+		{
+			plan_cache::lock l;
+			thread_state& s = threads_state();
+			if (!s.initialized)
+				s.initialized = (0 != traits_type::init_threads());
+			return s.initialized;
+		}
+		/*!
+		 * @brief Configure the number of threads used by the plans constructed with nthreads = threads_default
+		 * (1 initially). This applies also to the plans created by algorithms parameterized with the DFT type
+		 * (xcorr, lpc, overlap_add etc.), which don't specify the number of threads themselves.
+		 * @note Multi-threaded execution pays off only for large transforms (tens of thousands of points and more).
+		 * @see fftw_plan_with_nthreads()
+		 */
+		static void set_planner_threads(unsigned nthreads)
+		{plan_cache::lock l; threads_state().count = (threads_default == nthreads ? 1 : nthreads);}
+		//! @return number of threads used by the plans constructed with nthreads = threads_default.
+		static unsigned planner_threads() {plan_cache::lock l; return threads_state().count;}
+
+		/*!
+		 * @brief Import wisdom accumulated by earlier runs from a file, so that plans created with flag::measure
+		 * or flag::patient for the already seen transforms don't need the measurements to be repeated.
+		 * @param filename path of the wisdom file.
+		 * @return true if the wisdom was imported successfully.
+		 * @see fftw_import_wisdom_from_filename()
+		 */
+		static bool import_wisdom(const char* filename)
+		{plan_cache::lock l; return 0 != traits_type::import_wisdom_from_filename(filename);}
+		/*!
+		 * @brief Export the accumulated wisdom to a file (to be read with import_wisdom() by subsequent runs).
+		 * @param filename path of the wisdom file.
+		 * @return true if the wisdom was exported successfully.
+		 * @see fftw_export_wisdom_to_filename()
+		 */
+		static bool export_wisdom(const char* filename)
+		{plan_cache::lock l; return 0 != traits_type::export_wisdom_to_filename(filename);}
+		/*!
+		 * @brief Import system-wide wisdom (e.g. /etc/fftw/wisdom on Unix).
+		 * @return true if the wisdom was imported successfully.
+		 * @see fftw_import_system_wisdom()
+		 */
+		static bool import_system_wisdom()
+		{plan_cache::lock l; return 0 != traits_type::import_system_wisdom();}
+		/*!
+		 * @brief Import wisdom from a string obtained with export_wisdom_string().
+		 * @return true if the wisdom was imported successfully.
+		 * @see fftw_import_wisdom_from_string()
+		 */
+		static bool import_wisdom_string(const std::string& wisdom)
+		{plan_cache::lock l; return 0 != traits_type::import_wisdom_from_string(wisdom.c_str());}
+		/*!
+		 * @return the accumulated wisdom serialized to a string.
+		 * @throw std::bad_alloc if libfftw was unable to allocate the string.
+		 * @see fftw_export_wisdom_to_string()
+		 */
+		static std::string export_wisdom_string()
+		{
+			plan_cache::lock l;
+			char* str = traits_type::export_wisdom_to_string();
+			if (NULL == str)
+				throw std::bad_alloc();
+			const std::string res(str);
+			traits_type::free(str);
+			return res;
+		}
 
 		static const size_t size_not_1d = 0;
 		//! @return size of 1-dimensional transform (length of input/output vectors), size_not_1d if not 1-dimensional transform.
@@ -91,10 +183,15 @@ namespace dsp { namespace dft { namespace fftw {
 		 * to prepare the plan for specified input params).
 		 */
 		explicit plan(typename traits_type::plan_type plan, size_t size1d = size_not_1d)
-		 : 	plan_(plan, &traits_type::destroy_plan), size_1d_(size1d)
+		 : 	plan_(plan, destroyer()), size_1d_(size1d)
 		{detail::verify_plan_available(get_pointer(plan_));}
 		//! Type of smart pointer used for copying the plan instance.
 		typedef boost::shared_ptr<typename traits_type::plan_value_type> ref_type;
+		//! Deleter of the plans, serialized with other planner calls.
+		struct destroyer {
+			void operator()(typename traits_type::plan_type plan) const
+			{plan_cache::lock l; traits_type::destroy_plan(plan);}
+		};
 		//! Plan pointer (wrapped up in boost::shared_ptr to enable copying) for use by subclasses.
 		ref_type plan_;
 		/*!
@@ -117,8 +214,72 @@ namespace dsp { namespace dft { namespace fftw {
 		{detail::verify_plan_available(get_pointer(plan_));}
 
 		static size_t find_size_1d(size_t rank, const unsigned* n) {return ((1 == rank) ? *n: size_not_1d);}
+
+		/*!
+		 * @brief Scoped guard serializing the planner call and configuring the number of threads of the plan.
+		 * Used within the constructor initializers as left operand of comma operator, so that it lives until
+		 * the planner function returns.
+		 */
+		class planner: private noncopyable {
+		public:
+			explicit planner(unsigned nthreads)
+			 :	nthreads_(threads_default == nthreads ? threads_state().count : nthreads)
+			{
+				if (1 == nthreads_)
+					return;
+				if (init_threads())
+					traits_type::plan_with_nthreads(nthreads_);
+				else
+					nthreads_ = 1;
+			}
+			~planner() {if (1 != nthreads_) traits_type::plan_with_nthreads(1);}
+			//! @return number of threads the plan is created with.
+			unsigned threads() const {return nthreads_;}
+		private:
+			plan_cache::lock lock_;
+			unsigned nthreads_;
+		};
+
+		//! @return plan_cache key of unidimensional transform of given kind (see plan_key::kind) and parameters.
+		template<class Input, class Output>
+		static plan_key cache_key(int kind, size_t n, Input* in, Output* out, unsigned flags, unsigned nthreads)
+		{
+			plan_key key;
+			key.domain = static_cast<int>(sizeof(Domain)) * 256 + std::numeric_limits<Domain>::digits;
+			key.kind = kind;
+			key.size = n;
+			key.flags = flags;
+			key.in_alignment = traits_type::alignment_of(reinterpret_cast<Domain*>(in));
+			key.out_alignment = traits_type::alignment_of(reinterpret_cast<Domain*>(out));
+			key.in_place = (static_cast<void*>(in) == static_cast<void*>(out));
+			key.threads = nthreads;
+			return key;
+		}
+		//! @return plan found in plan_cache (must be called with plan_cache::lock held).
+		static ref_type find_cached(const plan_key& key)
+		{return boost::static_pointer_cast<typename traits_type::plan_value_type>(plan_cache::find(key));}
+		//! @brief Store newly created plan in plan_cache (must be called with plan_cache::lock held).
+		//! @return the plan reference, empty if the plan is @c NULL.
+		static ref_type insert_cached(const plan_key& key, typename traits_type::plan_type plan)
+		{
+			if (NULL == plan)
+				return ref_type();
+			ref_type ref(plan, destroyer());
+			plan_cache::insert(key, ref);
+			return ref;
+		}
 	private:
 		size_t size_1d_;
+
+		struct thread_state {
+			bool initialized;	//!< whether traits::init_threads() succeeded
+			unsigned count;		//!< number of threads used with threads_default
+		};
+		static thread_state& threads_state()
+		{
+			static thread_state s = {false, 1};
+			return s;
+		}
 	};
 
 	/*!
@@ -146,13 +307,13 @@ namespace dsp { namespace dft { namespace fftw {
 		typedef dsp::dft::fftw::allocator<output_type> output_allocator;
 
 
-		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, unsigned flags = 0);
-		dft(size_t n, input_type* in, output_type* out, sign::spec, unsigned flags = 0); //!< For compatibility with dsp::dft::fft
-		dft(size_t n, input_type* in, output_type* out, unsigned flags = 0);
-		dft(size_t n0, size_t n1, input_type* in, output_type* out, unsigned flags = 0);
-		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, unsigned flags = 0);
+		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default);
+		dft(size_t n, input_type* in, output_type* out, sign::spec, unsigned flags = 0, unsigned nthreads = base_type::threads_default); //!< For compatibility with dsp::dft::fft
+		dft(size_t n, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default);
+		dft(size_t n0, size_t n1, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default);
+		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default);
 		dft(size_t rank, const unsigned* n, size_t howmany, input_type* in, const int* inembed, int istride, int idist,
-				output_type* out, const int* onembed, int ostride, int odist, unsigned flags = 0);
+				output_type* out, const int* onembed, int ostride, int odist, unsigned flags = 0, unsigned nthreads = base_type::threads_default);
 
 		using base_type::operator ();
 		void operator()(input_type* in, output_type* out) const;
@@ -177,30 +338,35 @@ namespace dsp { namespace dft { namespace fftw {
 		typedef Real input_type;
 		typedef Real output_type;
 		typedef traits<Real> traits_type;
+		typedef typename base_type::planner planner;
 		typedef dsp::dft::fftw::allocator<input_type> input_allocator;
 		typedef dsp::dft::fftw::allocator<output_type> output_allocator;
 		typedef dft<input_type, output_type> this_type;
 
 		//!@see fftw_plan_r2r()
-		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, const r2r::kind* kind, unsigned flags = 0)
-		 :	base_type(traits_type::plan_r2r(rank, n, in, out, kind, flags), base_type::find_size_1d(rank, n)) {}
+		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, const r2r::kind* kind, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_r2r(rank, n, in, out, kind, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
 		//!@see fftw_plan_r2r_1d()
-		dft(size_t n, input_type* in, output_type* out, r2r::kind kind, unsigned flags = 0)
-		 :	base_type(traits_type::plan_r2r_1d(static_cast<int>(n), in, out, kind, flags), n) {}
+		//!@note The plan is shared through plan_cache with other unidimensional transforms of the same parameters.
+		dft(size_t n, input_type* in, output_type* out, r2r::kind kind, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_1d(n, in, out, kind, flags, nthreads), n), in_(in), out_(out) {}
 		//!@see fftw_plan_r2r_2d()
-		dft(size_t n0, size_t n1, input_type* in, output_type* out, r2r::kind kind0, r2r::kind kind1, unsigned flags = 0)
-		 :	base_type(traits_type::plan_r2r_2d(n0, n1, in, out, kind0, kind1, flags)) {}
+		dft(size_t n0, size_t n1, input_type* in, output_type* out, r2r::kind kind0, r2r::kind kind1, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_r2r_2d(n0, n1, in, out, kind0, kind1, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_r2r_3d()
 		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out,
-				r2r::kind kind0, r2r::kind kind1, r2r::kind kind2, unsigned flags = 0)
-		 :	base_type(traits_type::plan_r2r_3d(n0, n1, n2, in, out, kind0, kind1, kind2, flags)) {}
+				r2r::kind kind0, r2r::kind kind1, r2r::kind kind2, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_r2r_3d(n0, n1, n2, in, out, kind0, kind1, kind2, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_many_r2r()
+		//!@note Batched plans are not shared through plan_cache (see its description for the reason).
 		dft(size_t rank, const unsigned* n, size_t howmany, input_type* in, const int* inembed, int istride, int idist,
-				output_type* out, const int* onembed, int ostride, int odist, const r2r::kind* kind, unsigned flags = 0)
-		 :	base_type(traits_type::plan_many_r2r(rank, n, howmany, in, inembed, istride, idist,
-				 out, onembed, ostride, odist, kind, flags), base_type::find_size_1d(rank, n)) {}
+				output_type* out, const int* onembed, int ostride, int odist, const r2r::kind* kind, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_many_r2r(rank, n, howmany, in, inembed, istride, idist,
+				 out, onembed, ostride, odist, kind, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
 
-		using base_type::operator ();
+		//! @brief Perform the transform of the arrays given upon construction.
+		//! New-array execute function is used, since the plan may be shared with other dft objects.
+		void operator()() const {operator()(in_, out_);}
 
 		//!@see fftw_execute_r2r()
 		void operator()(input_type* in, output_type* out) const
@@ -211,7 +377,21 @@ namespace dsp { namespace dft { namespace fftw {
 		 * @param other dft_r2r plan to copy.
 		 */
 		explicit dft(const dft& other)
-		 : 	base_type(static_cast<const base_type&>(other)) {}
+		 : 	base_type(static_cast<const base_type&>(other)), in_(other.in_), out_(other.out_) {}
+
+	private:
+		input_type* in_;
+		output_type* out_;
+
+		static typename base_type::ref_type plan_1d(size_t n, input_type* in, output_type* out, r2r::kind kind, unsigned flags, unsigned nthreads)
+		{
+			planner p(nthreads);
+			const plan_key key = base_type::cache_key(plan_key::kind_r2r + kind, n, in, out, flags, p.threads());
+			typename base_type::ref_type plan = base_type::find_cached(key);
+			if (!plan)
+				plan = base_type::insert_cached(key, traits_type::plan_r2r_1d(static_cast<int>(n), in, out, kind, flags));
+			return plan;
+		}
 	};
 
 	/*!
@@ -224,33 +404,44 @@ namespace dsp { namespace dft { namespace fftw {
 		typedef Real input_type;
 		typedef std::complex<Real> output_type;
 		typedef traits<Real> traits_type;
+		typedef typename base_type::planner planner;
 		typedef dsp::dft::fftw::allocator<input_type> input_allocator;
 		typedef dsp::dft::fftw::allocator<output_type> output_allocator;
 		typedef dft<input_type, output_type> this_type;
 
 		//!@see fftw_plan_dft_r2c()
-		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_r2c(rank, n, in, out, flags), base_type::find_size_1d(rank, n)) {}
+		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_r2c(rank, n, in, out, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_r2c_1d()
-		dft(size_t n, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_r2c_1d(n, in, out, flags), n) {}
+		//!@note The plan is shared through plan_cache with other unidimensional transforms of the same parameters.
+		dft(size_t n, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_1d(n, in, out, flags, nthreads), n), in_(in), out_(out) {}
 		//!Compatibility constructor for use as an alternative to dsp::dft::fft
 		//!@see fftw_plan_dft_r2c_1d()
-		dft(size_t n, input_type* in, output_type* out, sign::spec, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_r2c_1d(n, in, out, flags), n) {}
+		dft(size_t n, input_type* in, output_type* out, sign::spec, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_1d(n, in, out, flags, nthreads), n), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_r2c_2d()
-		dft(size_t n0, size_t n1, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_r2c_2d(n0, n1, in, out, flags)) {}
+		dft(size_t n0, size_t n1, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_r2c_2d(n0, n1, in, out, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_r2c_3d()
-		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_r2c_3d(n0, n1, n2, in, out, flags)) {}
+		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_r2c_3d(n0, n1, n2, in, out, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_many_dft_r2c()
+		//!@note Batched plans are not shared through plan_cache (see its description for the reason).
 		dft(size_t rank, const unsigned* n, size_t howmany, input_type* in, const int* inembed, int istride, int idist,
-                output_type* out, const int* onembed, int ostride, int odist, unsigned flags = 0)
-		 :	base_type(traits_type::plan_many_dft_r2c(rank, n, howmany, in, inembed, istride, idist,
-				 out, onembed, ostride, odist, flags), base_type::find_size_1d(rank, n)) {}
+                output_type* out, const int* onembed, int ostride, int odist, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_many_dft_r2c(rank, n, howmany, in, inembed, istride, idist,
+				 out, onembed, ostride, odist, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
+		//!Compatibility constructor for use as an alternative to batched dsp::dft::fft
+		//!@see fftw_plan_many_dft_r2c()
+		//!@note Batched plans are not shared through plan_cache (see its description for the reason).
+		dft(size_t n, size_t howmany, input_type* in, size_t istride, size_t idist,
+				output_type* out, size_t ostride, size_t odist, sign::spec, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_many_1d(n, howmany, in, istride, idist, out, ostride, odist, flags, nthreads), n), in_(in), out_(out) {}
 
-		using base_type::operator ();
+		//! @brief Perform the transform of the arrays given upon construction.
+		//! New-array execute function is used, since the plan may be shared with other dft objects.
+		void operator()() const {operator()(in_, out_);}
 
 		//!@see fftw_execute_dft_r2c()
 		void operator()(input_type* in, output_type* out) const
@@ -261,7 +452,30 @@ namespace dsp { namespace dft { namespace fftw {
 		 * @param other dft_r2c plan to copy.
 		 */
 		explicit dft(const dft& other)
-		 : 	base_type(static_cast<const base_type&>(other)) {}
+		 : 	base_type(static_cast<const base_type&>(other)), in_(other.in_), out_(other.out_) {}
+
+	private:
+		input_type* in_;
+		output_type* out_;
+
+		static typename base_type::ref_type plan_1d(size_t n, input_type* in, output_type* out, unsigned flags, unsigned nthreads)
+		{
+			planner p(nthreads);
+			const plan_key key = base_type::cache_key(plan_key::kind_r2c, n, in, out, flags, p.threads());
+			typename base_type::ref_type plan = base_type::find_cached(key);
+			if (!plan)
+				plan = base_type::insert_cached(key, traits_type::plan_dft_r2c_1d(n, in, out, flags));
+			return plan;
+		}
+
+		static typename traits_type::plan_type plan_many_1d(size_t n, size_t howmany, input_type* in, size_t istride, size_t idist,
+				output_type* out, size_t ostride, size_t odist, unsigned flags, unsigned nthreads)
+		{
+			planner p(nthreads);
+			const unsigned nn = static_cast<unsigned>(n);
+			return traits_type::plan_many_dft_r2c(1, &nn, howmany, in, NULL, static_cast<int>(istride), static_cast<int>(idist),
+					out, NULL, static_cast<int>(ostride), static_cast<int>(odist), flags);
+		}
 	};
 
 	/*!
@@ -274,33 +488,44 @@ namespace dsp { namespace dft { namespace fftw {
 		typedef std::complex<Real> input_type;
 		typedef Real output_type;
 		typedef traits<Real> traits_type;
+		typedef typename base_type::planner planner;
 		typedef dsp::dft::fftw::allocator<input_type> input_allocator;
 		typedef dsp::dft::fftw::allocator<output_type> output_allocator;
 		typedef dft<input_type, output_type> this_type;
 
 		//!@see fftw_plan_dft_c2r()
-		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_c2r(rank, n, in, out, flags), base_type::find_size_1d(rank, n)) {}
+		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_c2r(rank, n, in, out, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_c2r_1d()
-		dft(size_t n, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_c2r_1d(n, in, out, flags), n) {}
+		//!@note The plan is shared through plan_cache with other unidimensional transforms of the same parameters.
+		dft(size_t n, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_1d(n, in, out, flags, nthreads), n), in_(in), out_(out) {}
 		//!Compatibility constructor for use as an alternative to dsp::dft::fft
 		//!@see fftw_plan_dft_c2r_1d()
-		dft(size_t n, input_type* in, output_type* out, sign::spec, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_c2r_1d(n, in, out, flags), n) {}
+		dft(size_t n, input_type* in, output_type* out, sign::spec, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_1d(n, in, out, flags, nthreads), n), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_c2r_2d()
-		dft(size_t n0, size_t n1, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_c2r_2d(n0, n1, in, out, flags)) {}
+		dft(size_t n0, size_t n1, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_c2r_2d(n0, n1, in, out, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_c2r_3d()
-		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_c2r_3d(n0, n1, n2, in, out, flags)) {}
+		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_c2r_3d(n0, n1, n2, in, out, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_many_dft_c2r()
+		//!@note Batched plans are not shared through plan_cache (see its description for the reason).
 		dft(size_t rank, const unsigned* n, size_t howmany, input_type* in, const int* inembed, int istride, int idist,
-				output_type* out, const int* onembed, int ostride, int odist, unsigned flags = 0)
-		 :	base_type(traits_type::plan_many_dft_c2r(rank, n, howmany, in, inembed, istride, idist,
-				 out, onembed, ostride, odist, flags), base_type::find_size_1d(rank, n)) {}
+				output_type* out, const int* onembed, int ostride, int odist, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_many_dft_c2r(rank, n, howmany, in, inembed, istride, idist,
+				 out, onembed, ostride, odist, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
+		//!Compatibility constructor for use as an alternative to batched dsp::dft::fft
+		//!@see fftw_plan_many_dft_c2r()
+		//!@note Batched plans are not shared through plan_cache (see its description for the reason).
+		dft(size_t n, size_t howmany, input_type* in, size_t istride, size_t idist,
+				output_type* out, size_t ostride, size_t odist, sign::spec, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_many_1d(n, howmany, in, istride, idist, out, ostride, odist, flags, nthreads), n), in_(in), out_(out) {}
 
-		using base_type::operator ();
+		//! @brief Perform the transform of the arrays given upon construction.
+		//! New-array execute function is used, since the plan may be shared with other dft objects.
+		void operator()() const {operator()(in_, out_);}
 
 		//!@see fftw_execute_dft_c2r()
 		void operator()(input_type* in, output_type* out) const
@@ -311,7 +536,30 @@ namespace dsp { namespace dft { namespace fftw {
 		 * @param other dft_c2r plan to copy.
 		 */
 		explicit dft(const dft& other)
-		 : 	base_type(static_cast<const base_type&>(other)) {}
+		 : 	base_type(static_cast<const base_type&>(other)), in_(other.in_), out_(other.out_) {}
+
+	private:
+		input_type* in_;
+		output_type* out_;
+
+		static typename base_type::ref_type plan_1d(size_t n, input_type* in, output_type* out, unsigned flags, unsigned nthreads)
+		{
+			planner p(nthreads);
+			const plan_key key = base_type::cache_key(plan_key::kind_c2r, n, in, out, flags, p.threads());
+			typename base_type::ref_type plan = base_type::find_cached(key);
+			if (!plan)
+				plan = base_type::insert_cached(key, traits_type::plan_dft_c2r_1d(n, in, out, flags));
+			return plan;
+		}
+
+		static typename traits_type::plan_type plan_many_1d(size_t n, size_t howmany, input_type* in, size_t istride, size_t idist,
+				output_type* out, size_t ostride, size_t odist, unsigned flags, unsigned nthreads)
+		{
+			planner p(nthreads);
+			const unsigned nn = static_cast<unsigned>(n);
+			return traits_type::plan_many_dft_c2r(1, &nn, howmany, in, NULL, static_cast<int>(istride), static_cast<int>(idist),
+					out, NULL, static_cast<int>(ostride), static_cast<int>(odist), flags);
+		}
 	};
 
 	/*!
@@ -324,29 +572,40 @@ namespace dsp { namespace dft { namespace fftw {
 		typedef std::complex<Real> input_type;
 		typedef std::complex<Real> output_type;
 		typedef traits<Real> traits_type;
+		typedef typename base_type::planner planner;
 		typedef dsp::dft::fftw::allocator<input_type> input_allocator;
 		typedef dsp::dft::fftw::allocator<output_type> output_allocator;
 		typedef dft<input_type, output_type> this_type;
 
 		//!@see fftw_plan_dft()
-		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, sign::spec sign, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft(rank, n, in, out, sign, flags), base_type::find_size_1d(rank, n)) {}
+		dft(size_t rank, const unsigned* n, input_type* in, output_type* out, sign::spec sign, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft(rank, n, in, out, sign, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_1d()
-		dft(size_t n, input_type* in, output_type* out, sign::spec sign = sign::forward, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_1d(n, in, out, sign, flags), n) {}
+		//!@note The plan is shared through plan_cache with other unidimensional transforms of the same parameters.
+		dft(size_t n, input_type* in, output_type* out, sign::spec sign = sign::forward, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_1d(n, in, out, sign, flags, nthreads), n), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_2d()
-		dft(size_t n0, size_t n1, input_type* in, output_type* out, sign::spec sign, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_2d(n0, n1, in, out, sign, flags)) {}
+		dft(size_t n0, size_t n1, input_type* in, output_type* out, sign::spec sign, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_2d(n0, n1, in, out, sign, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_dft_3d()
-		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, sign::spec sign, unsigned flags = 0)
-		 :	base_type(traits_type::plan_dft_3d(n0, n1, n2, in, out, sign, flags)) {}
+		dft(size_t n0, size_t n1, size_t n2, input_type* in, output_type* out, sign::spec sign, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_dft_3d(n0, n1, n2, in, out, sign, flags))), in_(in), out_(out) {}
 		//!@see fftw_plan_many_dft()
+		//!@note Batched plans are not shared through plan_cache (see its description for the reason).
 		dft(size_t rank, const unsigned* n, size_t howmany, input_type* in, const int* inembed, int istride, int idist,
-				output_type* out, const int* onembed, int ostride, int odist, sign::spec sign, unsigned flags = 0)
-		 :	base_type(traits_type::plan_many_dft(rank, n, howmany, in, inembed, istride, idist,
-				 out, onembed, ostride, odist, sign, flags), base_type::find_size_1d(rank, n)) {}
+				output_type* out, const int* onembed, int ostride, int odist, sign::spec sign, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type((planner(nthreads), traits_type::plan_many_dft(rank, n, howmany, in, inembed, istride, idist,
+				 out, onembed, ostride, odist, sign, flags)), base_type::find_size_1d(rank, n)), in_(in), out_(out) {}
+		//!Compatibility constructor for use as an alternative to batched dsp::dft::fft
+		//!@see fftw_plan_many_dft()
+		//!@note Batched plans are not shared through plan_cache (see its description for the reason).
+		dft(size_t n, size_t howmany, input_type* in, size_t istride, size_t idist,
+				output_type* out, size_t ostride, size_t odist, sign::spec sign = sign::forward, unsigned flags = 0, unsigned nthreads = base_type::threads_default)
+		 :	base_type(plan_many_1d(n, howmany, in, istride, idist, out, ostride, odist, sign, flags, nthreads), n), in_(in), out_(out) {}
 
-		using base_type::operator ();
+		//! @brief Perform the transform of the arrays given upon construction.
+		//! New-array execute function is used, since the plan may be shared with other dft objects.
+		void operator()() const {operator()(in_, out_);}
 
 		//!@see fftw_execute_dft()
 		void operator()(input_type* in, output_type* out) const
@@ -357,7 +616,30 @@ namespace dsp { namespace dft { namespace fftw {
 		 * @param other dft plan to copy.
 		 */
 		explicit dft(const dft& other)
-		 : 	base_type(static_cast<const base_type&>(other)) {}
+		 : 	base_type(static_cast<const base_type&>(other)), in_(other.in_), out_(other.out_) {}
+
+	private:
+		input_type* in_;
+		output_type* out_;
+
+		static typename base_type::ref_type plan_1d(size_t n, input_type* in, output_type* out, sign::spec sign, unsigned flags, unsigned nthreads)
+		{
+			planner p(nthreads);
+			const plan_key key = base_type::cache_key(sign, n, in, out, flags, p.threads());
+			typename base_type::ref_type plan = base_type::find_cached(key);
+			if (!plan)
+				plan = base_type::insert_cached(key, traits_type::plan_dft_1d(n, in, out, sign, flags));
+			return plan;
+		}
+
+		static typename traits_type::plan_type plan_many_1d(size_t n, size_t howmany, input_type* in, size_t istride, size_t idist,
+				output_type* out, size_t ostride, size_t odist, sign::spec sign, unsigned flags, unsigned nthreads)
+		{
+			planner p(nthreads);
+			const unsigned nn = static_cast<unsigned>(n);
+			return traits_type::plan_many_dft(1, &nn, howmany, in, NULL, static_cast<int>(istride), static_cast<int>(idist),
+					out, NULL, static_cast<int>(ostride), static_cast<int>(odist), sign, flags);
+		}
 	};
 
 } } }
@@ -0,0 +1,116 @@
+/*!
+ * @file dsp++/fftw/plan_cache.h
+ * @brief Process-wide cache of FFTW3 plans and serialization of planner calls.
+ * @author Andrzej Ciarkowski <mailto:andrzej.ciarkowski@gmail.com>
+ */
+#ifndef DSP_FFTW_PLAN_CACHE_H_INCLUDED
+#define DSP_FFTW_PLAN_CACHE_H_INCLUDED
+
+#include <dsp++/config.h>
+
+#if !DSP_FFTW_DISABLED
+
+#include <dsp++/export.h>
+#include <dsp++/noncopyable.h>
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
+
+namespace dsp { namespace dft { namespace fftw {
+
+	/*!
+	 * @brief Key identifying a cached plan of unidimensional transform.
+	 * Plans created by FFTW3 may be executed on other arrays than the ones they were created for (with the
+	 * new-array execute functions), as long as the transform parameters, in-place/out-of-place layout and
+	 * alignment of the arrays are the same, so all of these are part of the key.
+	 */
+	struct plan_key {
+		//! @brief Values of kind field other than c2c transforms (which use sign::spec value).
+		enum {
+			kind_r2c = 2,	//!< real-to-complex transform
+			kind_c2r = 3,	//!< complex-to-real transform
+			kind_r2r = 16,	//!< real-to-real transform, r2r::kind value is added to this
+		};
+
+		int domain;			//!< identifier of real type (FFTW3 library variant)
+		int kind;			//!< transform kind (c2c forward/backward, r2c, c2r, r2r of given kind)
+		size_t size;		//!< transform length
+		unsigned flags;		//!< planner flags
+		int in_alignment;	//!< alignment of input array, as reported by fftw_alignment_of()
+		int out_alignment;	//!< alignment of output array, as reported by fftw_alignment_of()
+		bool in_place;		//!< whether input and output arrays are the same
+		unsigned threads;	//!< number of threads the plan uses
+
+		bool operator<(const plan_key& other) const
+		{
+			if (domain != other.domain) return domain < other.domain;
+			if (kind != other.kind) return kind < other.kind;
+			if (size != other.size) return size < other.size;
+			if (flags != other.flags) return flags < other.flags;
+			if (in_alignment != other.in_alignment) return in_alignment < other.in_alignment;
+			if (out_alignment != other.out_alignment) return out_alignment < other.out_alignment;
+			if (in_place != other.in_place) return in_place < other.in_place;
+			return threads < other.threads;
+		}
+	};
+
+	/*!
+	 * @brief Process-wide, thread-safe cache of FFTW3 plans.
+	 * Unidimensional dsp::dft::fftw::dft plans are looked up in the cache before invoking the planner, so that
+	 * the (possibly very expensive with flag::measure or flag::patient) planning is performed only once for each
+	 * set of transform parameters. The cached plans are shared by all the dft objects using them and released
+	 * when the cache is cleared and all these objects are destroyed.
+	 *
+	 * The cache is bounded: when a plan is inserted and there are already capacity() plans cached, the least
+	 * recently used ones which are not held by any dft object are released. The plans in use are never evicted
+	 * (they are not released by FFTW until their dft objects are destroyed anyway), so the cache may exceed
+	 * its capacity while all of them are used.
+	 *
+	 * Multi-dimensional and batched (plan-many/guru) transforms are not cached. Their key would have to
+	 * contain the whole array layout (dimensions, embedding, strides and distances), such plans are created
+	 * once by the objects owning the batch buffers and are hardly ever repeated with the same layout.
+	 * @note FFTW3 planner is not thread-safe, so all the planner calls made by dsp::dft::fftw are serialized with
+	 * plan_cache::lock.
+	 */
+	class DSPXX_API plan_cache {
+	public:
+		//! @brief Type-erased reference to a plan (shared pointer with plan-destroying deleter).
+		typedef boost::shared_ptr<void> ref_type;
+
+		//! @brief Scoped lock serializing the use of FFTW3 planner (and wisdom) between threads.
+		class DSPXX_API lock: private noncopyable {
+		public:
+			lock();
+			~lock();
+		};
+
+		/*!
+		 * @brief Find a cached plan (must be called with lock held).
+		 * @return the plan stored for the key or empty reference if there is none.
+		 */
+		static ref_type find(const plan_key& key);
+		/*!
+		 * @brief Store a plan for the key (must be called with lock held).
+		 * Least recently used plans not in use are released first if the cache is full.
+		 */
+		static void insert(const plan_key& key, const ref_type& plan);
+		//! @brief Release all the cached plans.
+		static void clear();
+		//! @return number of cached plans.
+		static size_t size();
+
+		//! @brief Initial value of capacity().
+		static const size_t default_capacity = 64;
+		/*!
+		 * @brief Set the maximum number of cached plans, releasing the least recently used ones not in use
+		 * if there are more of them. Capacity of 0 disables caching.
+		 */
+		static void set_capacity(size_t capacity);
+		//! @return maximum number of cached plans.
+		static size_t capacity();
+	};
+
+}}}
+
+#endif // !DSP_FFTW_DISABLED
+
+#endif /* DSP_FFTW_PLAN_CACHE_H_INCLUDED */
@@ -287,6 +287,7 @@ namespace dft { namespace fftw {
 		static real_type* alloc_real(size_t n);
 		static complex_type* alloc_complex(size_t n);
 		static void free(void* p);
+		static int alignment_of(real_type* p);
 
 		static void flops(const plan_type p,
 		                          double* add, double* mul, double* fmas);
@@ -493,6 +494,7 @@ namespace dft { namespace fftw {
 		static real_type* alloc_real(size_t n);
 		static complex_type* alloc_complex(size_t n);
 		static void free(void* p);
+		static int alignment_of(real_type* p);
 
 		static void flops(const plan_type p,
 		                          double* add, double* mul, double* fmas);
@@ -719,6 +721,7 @@ namespace dft { namespace fftw {
 		static real_type* alloc_real(size_t n);
 		static complex_type* alloc_complex(size_t n);
 		static void free(void* p);
+		static int alignment_of(real_type* p);
 
 		static void flops(const plan_type p,
 		                          double* add, double* mul, double* fmas);
@@ -945,6 +948,7 @@ namespace dft { namespace fftw {
 		static real_type* alloc_real(size_t n);
 		static complex_type* alloc_complex(size_t n);
 		static void free(void* p);
+		static int alignment_of(real_type* p);
 
 		static void flops(const plan_type p,
 		                          double* add, double* mul, double* fmas);
@@ -1172,6 +1176,7 @@ namespace dft { namespace fftw {
 		static real_type* alloc_real(size_t n);
 		static complex_type* alloc_complex(size_t n);
 		static void free(void* p);
+		static int alignment_of(real_type* p);
 
 		static void flops(const plan_type p,
 		                          double* add, double* mul, double* fmas);
@@ -13,6 +13,7 @@
 #include <dsp++/algorithm.h>
 #include <dsp++/simd.h>
 #include <dsp++/ioport.h>
+#include <dsp++/snd/buffer.h>
 
 #include <algorithm>
 #include <functional>
@@ -49,6 +50,32 @@ Sample filter_sample_df2(Sample* w, const Sample* b, const size_t M, const Sampl
 	return r;
 }
 
+/*!
+ * @brief Filter a single input sample with a Transposed Direct-Form II AR/MA digital filter of order P.
+ * Contrary to Direct-Form II, the state is updated in place (s[i - 1] = s[i] + b[i] * x - a[i] * y), so it needs no shifting.
+ * @param[in] x input sample.
+ * @param[in,out] s filter state of length max(M, N), s[max(M, N) - 1] must be 0.
+ * @param[in] b MA filter (FIR) coefficients vector (difference equation numerator), M > 0.
+ * @param[in] M number of MA coefficients (length of b vector).
+ * @param[in] a AR filter (IIR) coefficients vector (difference equation denominator), a[0] is assumed to be 1 (coefficients are normalized).
+ * @param[in] N number of AR coefficients (length of a vector).
+ * @return filtered sample.
+ */
+template<class Sample> inline
+Sample filter_sample_tdf2(Sample x, Sample* s, const Sample* b, const size_t M, const Sample* a, const size_t N)
+{
+	const Sample y = b[0] * x + s[0];
+	const size_t L = std::min(M, N);
+	size_t i = 1;
+	for (; i < L; ++i)
+		s[i - 1] = s[i] + b[i] * x - a[i] * y;
+	for (; i < M; ++i)
+		s[i - 1] = s[i] + b[i] * x;
+	for (; i < N; ++i)
+		s[i - 1] = s[i] - a[i] * y;
+	return y;
+}
+
 const size_t sos_length = 3; //!< Length of coefficient vector of a single second-order-section (SOS) filter (3).
 
 /*!
@@ -81,6 +108,82 @@ Sample filter_sample_sos_df2(Sample x, size_t N, const bool* scale_only, Sample*
 	return x;
 }
 
+/*!
+ * @brief Filter a block of input samples with a FIR filter, computing y[n] = sum(b[i] * x[n - i]) for i in [0, M).
+ * @param[out] y output vector (L), must not overlap with x.
+ * @param[in] x input vector (L), preceded in memory by M - 1 past input samples (x[-M+1] ... x[-1]), i.e. the input
+ * is stored in the natural (oldest first) order, contrary to the delay line used by filter_sample_df2().
+ * @param[in] L number of samples to filter.
+ * @param[in] b FIR filter coefficients vector (M).
+ * @param[in] M number of FIR filter coefficients.
+ */
+template<class Sample> inline
+void filter_block_fir(Sample* y, const Sample* x, size_t L, const Sample* b, size_t M)
+{
+	for (size_t n = 0; n < L; ++n, ++x, ++y) {
+		Sample r = Sample();
+		for (size_t i = 0; i < M; ++i)
+			r += b[i] * *(x - i);
+		*y = r;
+	}
+}
+
+/*!
+ * @brief Filter a block of samples in place through a single second-order section realized in Transposed Direct-Form II.
+ * @param[in,out] x block of samples to filter (L), upon output filtered samples.
+ * @param[in] L number of samples in the block.
+ * @param[in,out] s section state (2).
+ * @param[in] b section MA coefficients (sos_length).
+ * @param[in] a section AR coefficients (sos_length), a[0] is assumed to be 1 (coefficients are normalized).
+ */
+template<class Sample> inline
+void filter_block_biquad_tdf2(Sample* x, size_t L, Sample* s, const Sample* b, const Sample* a)
+{
+	Sample s1 = s[0], s2 = s[1];
+	for (size_t n = 0; n < L; ++n, ++x) {
+		const Sample in = *x;
+		const Sample y = b[0] * in + s1;
+		s1 = b[1] * in - a[1] * y + s2;
+		s2 = b[2] * in - a[2] * y;
+		*x = y;
+	}
+	s[0] = s1;
+	s[1] = s2;
+}
+
+const size_t sos_lanes_length = 8; //!< Length of coefficient vector of a single section used by filter_sos_lanes_tdf2() (8).
+
+/*!
+ * @brief Filter a block of multichannel frames in place through a cascade of second-order sections realized in Transposed Direct-Form II,
+ * with the same coefficients used for each channel.
+ * @param[in,out] x block of frames (L * stride), channel k of frame n is stored at x[n * stride + k].
+ * @param[in] L number of frames in the block.
+ * @param[in] stride distance between consecutive frames (stride >= C).
+ * @param[in] C number of channels.
+ * @param[in] N number of sections in a cascade.
+ * @param[in] c {b0, b1, b2, a1, a2} coefficients of each section, sos_lanes_length apart (sos_lanes_length * N).
+ * @param[in,out] s state of each section: first state variable of each channel followed by the second one (2 * C * N).
+ */
+template<class Sample> inline
+void filter_sos_lanes_tdf2(Sample* x, size_t L, size_t stride, size_t C, size_t N, const Sample* c, Sample* s)
+{
+	for (size_t j = 0; j < N; ++j, c += sos_lanes_length, s += 2 * C) {
+		for (size_t k = 0; k < C; ++k) {
+			Sample s1 = s[k], s2 = s[C + k];
+			Sample* p = x + k;
+			for (size_t n = 0; n < L; ++n, p += stride) {
+				const Sample in = *p;
+				const Sample y = c[0] * in + s1;
+				s1 = c[1] * in - c[3] * y + s2;
+				s2 = c[2] * in - c[4] * y;
+				*p = y;
+			}
+			s[k] = s1;
+			s[C + k] = s2;
+		}
+	}
+}
+
 
 namespace simd {
 
@@ -103,6 +206,24 @@ DSPXX_API float filter_sample_df2(float* w, const float* b, const size_t M, cons
  */
 DSPXX_API float filter_sample_df2(float* w, const float* b, const size_t M, const float* a, const size_t N, int feat_flags);
 
+/*!
+ * @brief Filter a single input sample with a Transposed Direct-Form II AR/MA digital filter using SIMD instructions.
+ * @param[in] x input sample.
+ * @param[in,out] s filter state of length max(M, N), s[max(M, N) - 1] must be 0, needs not to be aligned.
+ * @param[in] b FIR filter coefficients vector, needs not to be aligned (M).
+ * @param[in] M Length of b vector, M > 0, needs not to include padding.
+ * @param[in] a IIR filter coefficients vector, needs not to be aligned, a[0] is ignored (N).
+ * @param[in] N Length of a vector, needs not to include padding.
+ * @return filtered sample.
+ * @see dsp::filter_sample_tdf2()
+ */
+DSPXX_API float filter_sample_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N);
+/*!
+ * @param[in] feat_flags override runtime CPU feature flags detection and run as if the specified features were present.
+ * @copydoc filter_sample_tdf2(float, float*, const float*, const size_t, const float*, const size_t)
+ */
+DSPXX_API float filter_sample_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N, int feat_flags);
+
 /*!
  * @brief Filter a single input sample through a cascade of Second-order Sections, optimized with SIMD instructions.
  * @param[in] x input sample.
@@ -122,6 +243,171 @@ DSPXX_API float filter_sample_sos_df2(float x, size_t N, const bool* scale_only,
  */
 DSPXX_API float filter_sample_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step, int feat_flags);
 
+/*!
+ * @brief Filter a block of input samples with a FIR filter using SIMD instructions.
+ * Several consecutive outputs are computed at once (vectorized across output samples rather than across coefficients),
+ * so contrary to filter_sample_df2() no horizontal reduction is needed per sample.
+ * @param[out] y output vector (L), must not overlap with x, needs not to be aligned.
+ * @param[in] x input vector (L) preceded in memory by M - 1 past input samples, needs not to be aligned.
+ * @param[in] L number of samples to filter, needs not to be a multiple of vector length.
+ * @param[in] b FIR filter coefficients vector (M), needs not to be aligned.
+ * @param[in] M number of FIR filter coefficients, needs not to include padding.
+ * @see dsp::filter_block_fir()
+ */
+DSPXX_API void filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M);
+/*!
+ * @param[in] feat_flags override runtime CPU feature flags detection and run as if the specified features were present.
+ * @copydoc filter_block_fir(float*, const float*, size_t, const float*, size_t)
+ */
+DSPXX_API void filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M, int feat_flags);
+
+const size_t biquad_block_length = 56; //!< Length of coefficient vector prepared by biquad_block_coeffs() (56).
+
+/*!
+ * @brief Prepare coefficients of a second-order section for filter_block_biquad().
+ * The section is represented in state-space form, so that 4 consecutive output samples and the state after them are linear
+ * combinations of 4 input samples and the state before them: m[8 * k + j] for k in [0, 4) holds the contribution of
+ * input sample k to output j (j in [0, 4)) and to the state (j in [4, 6)), m[32 ... 47] hold the contributions of the
+ * 2 state variables; m[48 ... 53] hold the original {b0, b1, b2, 1, a1, a2} coefficients used for the trailing samples.
+ * @param[out] m coefficient vector (biquad_block_length), should be aligned.
+ * @param[in] b section MA coefficients (sos_length).
+ * @param[in] a section AR coefficients (sos_length), a[0] is assumed to be 1 (coefficients are normalized).
+ */
+DSPXX_API void biquad_block_coeffs(float* m, const float* b, const float* a);
+
+/*!
+ * @brief Filter a block of samples in place through a single second-order section, optimized with SIMD instructions.
+ * Blocks of 4 samples are computed at once from the state-space representation of the section, which breaks the
+ * per-sample dependency of Transposed Direct-Form II on previous output; the results (and state) are identical
+ * (up to rounding) to these of dsp::filter_block_biquad_tdf2().
+ * @param[in,out] x block of samples to filter (L), needs not to be aligned.
+ * @param[in] L number of samples in the block, needs not to be a multiple of 4.
+ * @param[in,out] s Transposed Direct-Form II section state (2).
+ * @param[in] m coefficient vector prepared with biquad_block_coeffs(), must be aligned (biquad_block_length).
+ */
+DSPXX_API void filter_block_biquad(float* x, size_t L, float* s, const float* m);
+/*!
+ * @param[in] feat_flags override runtime CPU feature flags detection and run as if the specified features were present.
+ * @copydoc filter_block_biquad(float*, size_t, float*, const float*)
+ */
+DSPXX_API void filter_block_biquad(float* x, size_t L, float* s, const float* m, int feat_flags);
+
+/*!
+ * @brief Filter a block of multichannel frames in place through a cascade of second-order sections, optimized with SIMD instructions.
+ * Channels are processed in vector lanes, so that all of them are filtered at the cost of a single channel.
+ * @param[in,out] x block of frames (L * stride), needs not to be aligned.
+ * @param[in] L number of frames in the block.
+ * @param[in] stride distance between consecutive frames, stride >= C.
+ * @param[in] C number of channels (lanes), must be a multiple of 4.
+ * @param[in] N number of sections in a cascade.
+ * @param[in] c coefficients of each section (sos_lanes_length * N).
+ * @param[in,out] s state of each section (2 * C * N).
+ * @see dsp::filter_sos_lanes_tdf2()
+ */
+DSPXX_API void filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s);
+/*!
+ * @param[in] feat_flags override runtime CPU feature flags detection and run as if the specified features were present.
+ * @copydoc filter_sos_lanes(float*, size_t, size_t, size_t, size_t, const float*, float*)
+ */
+DSPXX_API void filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s, int feat_flags);
+
+}
+
+/*!
+ * @brief Structures (realizations) of AR/MA digital filters, used as a policy by dsp::filter and dsp::block_filter.
+ * Each structure provides:
+ * - delay_lines: number of P-length vectors of the filter state (P is filter order + 1);
+ * - filter_sample(x, w, P, b, M, a, N): filter a single sample x, updating the state w;
+ * - filter_block(x, L, w, P, b, M, a, N): filter a block of L samples in place, w has room for additional L - 1 samples.
+ * Coefficients are normalized (a[0] is assumed to be 1).
+ */
+namespace filter_structure {
+
+/*!
+ * @brief Direct-Form I: separate delay lines for input and output samples, no internal state which could overflow,
+ * at the cost of twice the memory of other structures.
+ */
+struct df1
+{
+	static const size_t delay_lines = 2;
+
+	template<class Sample>
+	static Sample filter_sample(Sample x, Sample* w, size_t P, const Sample* b, size_t M, const Sample* a, size_t N)
+	{
+		Sample* const y = w + P;	// y[i] is output delayed by i + 1 samples
+		delay(w, P);
+		*w = x;
+		Sample r = Sample();
+		for (size_t i = 0; i < M; ++i)
+			r += b[i] * w[i];
+		for (size_t i = 1; i < N; ++i)
+			r -= a[i] * y[i - 1];
+		delay(y, P);
+		*y = r;
+		return r;
+	}
+
+	template<class Sample>
+	static void filter_block(Sample* x, size_t L, Sample* w, size_t P, const Sample* b, size_t M, const Sample* a, size_t N)
+	{
+		for (size_t n = 0; n != L; ++n, ++x)
+			*x = filter_sample(*x, w, P, b, M, a, N);
+	}
+};
+
+//! @brief Direct-Form II: single delay line shared by AR and MA parts, shifted with each sample (see filter_sample_df2()).
+struct df2
+{
+	static const size_t delay_lines = 1;
+
+	template<class Sample>
+	static Sample filter_sample(Sample x, Sample* w, size_t P, const Sample* b, size_t M, const Sample* a, size_t N)
+	{
+		delay(w, P);
+		*w = x;
+		return filter_sample_df2(w, b, M, a, N);
+	}
+
+	template<class Sample>
+	static void filter_block(Sample* x, size_t L, Sample* w, size_t P, const Sample* b, size_t M, const Sample* a, size_t N)
+	{
+		// the delay line slides backwards over the additional L - 1 samples, so that it is moved once per block
+		std::copy(w, w + P - 1, w + L);
+		w += L - 1;
+		for (size_t n = 0; n != L; ++n, --w, ++x) {
+			*w = *x;
+			*x = filter_sample_df2(w, b, M, a, N);
+		}
+	}
+};
+
+/*!
+ * @brief Transposed Direct-Form II: state updated in place without shifting (see filter_sample_tdf2()), which has
+ * better numerical properties than Direct-Form II for floating-point samples.
+ */
+struct tdf2
+{
+	static const size_t delay_lines = 1;
+
+	template<class Sample>
+	static Sample filter_sample(Sample x, Sample* w, size_t /* P */, const Sample* b, size_t M, const Sample* a, size_t N)
+	{
+		return filter_sample_tdf2(x, w, b, M, a, N);
+	}
+
+	static float filter_sample(float x, float* w, size_t /* P */, const float* b, size_t M, const float* a, size_t N)
+	{
+		return dsp::simd::filter_sample_tdf2(x, w, b, M, a, N);
+	}
+
+	template<class Sample>
+	static void filter_block(Sample* x, size_t L, Sample* w, size_t P, const Sample* b, size_t M, const Sample* a, size_t N)
+	{
+		for (size_t n = 0; n != L; ++n, ++x)
+			*x = filter_sample(*x, w, P, b, M, a, N);
+	}
+};
+
 }
 
 template<class Sample, class BufferTraits = dsp::buffer_traits<Sample> >
@@ -229,22 +515,23 @@ public:
 
 protected:
 
+	// lines is the number of P_-length delay lines of the filter structure (see filter_structure::df1::delay_lines)
 	template<class BIterator, class AIterator>
-	df2_filter_base(BIterator b_begin, BIterator b_end, AIterator a_begin, AIterator a_end, size_t L);
+	df2_filter_base(BIterator b_begin, BIterator b_end, AIterator a_begin, AIterator a_end, size_t L, size_t lines = 1);
 
 	template<class BIterator>
-	df2_filter_base(BIterator b_begin, BIterator b_end, size_t L);
+	df2_filter_base(BIterator b_begin, BIterator b_end, size_t L, size_t lines = 1);
 
 	template<class BSample, class ASample>
-	df2_filter_base(const BSample* b_vec, size_t b_len, const ASample* a_vec, size_t a_len, size_t L);
+	df2_filter_base(const BSample* b_vec, size_t b_len, const ASample* a_vec, size_t a_len, size_t L, size_t lines = 1);
 
 	template<class BSample>
-	df2_filter_base(const BSample* b_vec, size_t b_len, size_t L);
+	df2_filter_base(const BSample* b_vec, size_t b_len, size_t L, size_t lines = 1);
 
-	df2_filter_base(size_t N, size_t M, size_t P, size_t L)
+	df2_filter_base(size_t N, size_t M, size_t P, size_t L, size_t lines = 1)
 	 :	N_(N), N_pad_(BufferTraits::aligned_count(N_))
 	 ,	M_(M), M_pad_(BufferTraits::aligned_count(M_))
-	 ,	P_(P), W_pad_(BufferTraits::aligned_count(P_ + L -1))
+	 ,	P_(P), W_pad_(BufferTraits::aligned_count(lines * P_ + L -1))
 	 ,	buffer_(N_pad_ + M_pad_ + W_pad_)
 	 ,	a_(buffer_.get())
 	 ,	b_(a_ + N_pad_)
@@ -261,16 +548,16 @@ protected:
 	trivial_array<Sample, typename BufferTraits::allocator_type> buffer_;	//!< Buffer of size P_ + N_ + M_ (+ L_ - 1 in case of block filter)
 	Sample* const a_;				//!< AR coefficients
 	Sample* const b_;				//!< MA coefficients
-	Sample* const w_;				//!< delay line (P_ (+ L_ - 1 in case of block filter))
+	Sample* const w_;				//!< delay line (lines * P_ (+ L_ - 1 in case of block filter))
 
 };
 
 template<class Sample, class BufferTraits>
 template<class BIterator, class AIterator>
-df2_filter_base<Sample, BufferTraits>::df2_filter_base(BIterator b_begin, BIterator b_end, AIterator a_begin, AIterator a_end, size_t L)
+df2_filter_base<Sample, BufferTraits>::df2_filter_base(BIterator b_begin, BIterator b_end, AIterator a_begin, AIterator a_end, size_t L, size_t lines)
  :	N_(std::distance(a_begin, a_end)), N_pad_(BufferTraits::aligned_count(N_))
  ,	M_(std::distance(b_begin, b_end)), M_pad_(BufferTraits::aligned_count(M_))
- ,	P_(std::max(N_, M_)), W_pad_(BufferTraits::aligned_count(P_ + L - 1))
+ ,	P_(std::max(N_, M_)), W_pad_(BufferTraits::aligned_count(lines * P_ + L - 1))
  ,	buffer_(N_pad_ + M_pad_ + W_pad_)
  ,	a_(buffer_.get())
  ,	b_(a_ + N_pad_)
@@ -288,10 +575,10 @@ df2_filter_base<Sample, BufferTraits>::df2_filter_base(BIterator b_begin, BItera
 
 template<class Sample, class BufferTraits>
 template<class BIterator>
-df2_filter_base<Sample, BufferTraits>::df2_filter_base(BIterator b_begin, BIterator b_end, size_t L)
+df2_filter_base<Sample, BufferTraits>::df2_filter_base(BIterator b_begin, BIterator b_end, size_t L, size_t lines)
  :	N_(0), N_pad_(0)
  ,	M_(std::distance(b_begin, b_end)), M_pad_(BufferTraits::aligned_count(M_))
- ,	P_(M_), W_pad_(BufferTraits::aligned_count(P_ + L - 1))
+ ,	P_(M_), W_pad_(BufferTraits::aligned_count(lines * P_ + L - 1))
  ,	buffer_(N_pad_ + M_pad_ + W_pad_)
  ,	a_(buffer_.get())
  ,	b_(a_)
@@ -306,10 +593,10 @@ df2_filter_base<Sample, BufferTraits>::df2_filter_base(BIterator b_begin, BItera
 
 template<class Sample, class BufferTraits>
 template<class BSample, class ASample>
-df2_filter_base<Sample, BufferTraits>::df2_filter_base(const BSample* b_vec, size_t b_len, const ASample* a_vec, size_t a_len, size_t L)
+df2_filter_base<Sample, BufferTraits>::df2_filter_base(const BSample* b_vec, size_t b_len, const ASample* a_vec, size_t a_len, size_t L, size_t lines)
  :	N_(a_len), N_pad_(BufferTraits::aligned_count(N_))
  ,	M_(b_len), M_pad_(BufferTraits::aligned_count(M_))
- ,	P_(std::max(N_, M_)), W_pad_(BufferTraits::aligned_count(P_ + L - 1))
+ ,	P_(std::max(N_, M_)), W_pad_(BufferTraits::aligned_count(lines * P_ + L - 1))
  ,	buffer_(N_pad_ + M_pad_ + W_pad_)
  ,	a_(buffer_.get())
  ,	b_(a_ + N_pad_)
@@ -327,10 +614,10 @@ df2_filter_base<Sample, BufferTraits>::df2_filter_base(const BSample* b_vec, siz
 
 template<class Sample, class BufferTraits>
 template<class BSample>
-df2_filter_base<Sample, BufferTraits>::df2_filter_base(const BSample* b_vec, size_t b_len, size_t L)
+df2_filter_base<Sample, BufferTraits>::df2_filter_base(const BSample* b_vec, size_t b_len, size_t L, size_t lines)
  :	N_(0), N_pad_(0)
  ,	M_(b_len), M_pad_(BufferTraits::aligned_count(M_))
- ,	P_(M_), W_pad_(BufferTraits::aligned_count(P_ + L - 1))
+ ,	P_(M_), W_pad_(BufferTraits::aligned_count(lines * P_ + L - 1))
  ,	buffer_(N_pad_ + M_pad_ + W_pad_)
  ,	a_(buffer_.get())
  ,	b_(a_)
@@ -344,9 +631,12 @@ df2_filter_base<Sample, BufferTraits>::df2_filter_base(const BSample* b_vec, siz
 }
 
 /*!
- * @brief Implementation of Direct-Form II digital filter.
+ * @brief Implementation of AR/MA digital filter.
+ * @tparam Sample type of samples this filter operates on.
+ * @tparam Structure filter structure (realization), one of filter_structure::df1, filter_structure::df2
+ * (default) or filter_structure::tdf2.
  */
-template<class Sample>
+template<class Sample, class Structure = filter_structure::df2>
 class filter: public df2_filter_base<Sample>, public sample_based_transform<Sample>
 {
 	typedef df2_filter_base<Sample> base;
@@ -365,7 +655,7 @@ public:
 	 */
 	template<class BIterator, class AIterator>
 	filter(BIterator b_begin, BIterator b_end, AIterator a_begin, AIterator a_end)
-	 :	base(b_begin, b_end, a_begin, a_end, 1)
+	 :	base(b_begin, b_end, a_begin, a_end, 1, Structure::delay_lines)
     {}
 
 	/*!
@@ -377,7 +667,7 @@ public:
 	 */
 	template<class BIterator>
 	filter(BIterator b_begin, BIterator b_end)
-	 :	base(b_begin, b_end, 1)
+	 :	base(b_begin, b_end, 1, Structure::delay_lines)
     {}
 
 	/*!
@@ -389,7 +679,7 @@ public:
 	 */
 	template<class BSample, class ASample>
 	filter(const BSample* b_vec, size_t b_len, const ASample* a_vec, size_t a_len)
-	 :	base(b_vec, b_len, a_vec, a_len, 1)
+	 :	base(b_vec, b_len, a_vec, a_len, 1, Structure::delay_lines)
     {}
 
 	/*!
@@ -399,7 +689,7 @@ public:
 	 */
 	template<class BSample>
 	filter(const BSample* b_vec, size_t b_len)
-	 :	base(b_vec, b_len, 1)
+	 :	base(b_vec, b_len, 1, Structure::delay_lines)
     {}
 
 	/*!
@@ -409,7 +699,7 @@ public:
 	 * @see use set() to actually initialize to coefficient values
 	 */
 	explicit filter(size_t b_len, size_t a_len)
-     :	base(a_len, b_len, std::max(a_len, b_len), 1)
+     :	base(a_len, b_len, std::max(a_len, b_len), 1, Structure::delay_lines)
     {}
 
 	/*!
@@ -419,14 +709,13 @@ public:
 	 */
 	Sample operator()(Sample x)
 	{
-		delay(base::w_, base::P_);
-		*base::w_ = x;
-		return filter_sample_df2(base::w_, base::b_, base::M_, base::a_, base::N_);
+		return Structure::filter_sample(x, base::w_, base::P_, base::b_, base::M_, base::a_, base::N_);
 	}
 };
 
+//! @brief Direct-Form II filter<float> specialization using SIMD kernel with padded coefficient vectors.
 template<>
-class DSPXX_API filter<float>: public df2_filter_base<float, dsp::simd::buffer_traits<float> >, public sample_based_transform<float>
+class DSPXX_API filter<float, filter_structure::df2>: public df2_filter_base<float, dsp::simd::buffer_traits<float> >, public sample_based_transform<float>
 {
 	typedef df2_filter_base<float, dsp::simd::buffer_traits<float> > base;
 public:
@@ -731,9 +1020,12 @@ public:
 };
 
 /*!
- * @brief Implementation of Direct-Form II digital filter.
+ * @brief Implementation of AR/MA digital filter operating on blocks of samples.
+ * @tparam Sample type of samples this filter operates on.
+ * @tparam Structure filter structure (realization), one of filter_structure::df1, filter_structure::df2
+ * (default) or filter_structure::tdf2.
  */
-template<class Sample>
+template<class Sample, class Structure = filter_structure::df2>
 class block_filter: public df2_filter_base<Sample>
 {
 	typedef df2_filter_base<Sample> base;
@@ -756,9 +1048,9 @@ public:
 	 */
 	template<class BIterator, class AIterator>
 	block_filter(size_t L, BIterator b_begin, BIterator b_end, AIterator a_begin, AIterator a_end)
-	 :	base(b_begin, b_end, a_begin, a_end, L * 2)
+	 :	base(b_begin, b_end, a_begin, a_end, L * 2, Structure::delay_lines)
 	 ,	L_(L)
-	 ,	x_(base::w_ + base::P_ + L_ - 1)
+	 ,	x_(base::w_ + Structure::delay_lines * base::P_ + L_ - 1)
 	 ,	x(x_, L_) 
 	 ,	y(x_, L_) 
 	{}
@@ -773,9 +1065,9 @@ public:
 	 */
 	template<class BIterator>
 	block_filter(size_t L, BIterator b_begin, BIterator b_end)
-	 :	base(b_begin, b_end, L * 2)
+	 :	base(b_begin, b_end, L * 2, Structure::delay_lines)
 	 ,	L_(L)
-	 ,	x_(base::w_ + base::P_ + L_ - 1)
+	 ,	x_(base::w_ + Structure::delay_lines * base::P_ + L_ - 1)
 	 ,	x(x_, L_) 
 	 ,	y(x_, L_) 
 	{}
@@ -790,9 +1082,9 @@ public:
 	 */
 	template<class BSample, class ASample>
 	block_filter(size_t L, const BSample* b_vec, size_t b_len, const ASample* a_vec, size_t a_len)
-	 :	base(b_vec, b_len, a_vec, a_len, L * 2)
+	 :	base(b_vec, b_len, a_vec, a_len, L * 2, Structure::delay_lines)
 	 ,	L_(L)
-	 ,	x_(base::w_ + base::P_ + L_ - 1)
+	 ,	x_(base::w_ + Structure::delay_lines * base::P_ + L_ - 1)
 	 ,	x(x_, L_) 
 	 ,	y(x_, L_) 
 	{}
@@ -805,9 +1097,9 @@ public:
 	 */
 	template<class BSample>
 	block_filter(size_t L, const BSample* b_vec, size_t b_len)
-	 :	base(b_vec, b_len, L * 2)
+	 :	base(b_vec, b_len, L * 2, Structure::delay_lines)
 	 ,	L_(L)
-	 ,	x_(base::w_ + base::P_ + L_ - 1)
+	 ,	x_(base::w_ + Structure::delay_lines * base::P_ + L_ - 1)
 	 ,	x(x_, L_) 
 	 ,	y(x_, L_) 
 	{}
@@ -820,9 +1112,9 @@ public:
 	 * @see use set() to actually initialize to coefficient values
 	 */
 	block_filter(size_t L, size_t b_len, size_t a_len)
-	 :	base(a_len, b_len, std::max(b_len, a_len), L * 2)
+	 :	base(a_len, b_len, std::max(b_len, a_len), L * 2, Structure::delay_lines)
 	 ,	L_(L)
-	 ,	x_(base::w_ + base::P_ + L_ - 1)
+	 ,	x_(base::w_ + Structure::delay_lines * base::P_ + L_ - 1)
 	 ,	x(x_, L_) 
 	 ,	y(x_, L_) 
 	{}
@@ -830,13 +1122,7 @@ public:
 	//! @brief Apply the filter to the sample sequence specified by [begin(), end()) range.
 	inline void operator()()
 	{
-		std::copy(base::w_, base::w_ + base::P_ - 1, base::w_ + L_);
-		Sample* w = base::w_ + L_ - 1;
-		Sample* x = x_;
-		for (size_t n = 0; n != L_; ++n, --w, ++x) {
-			*w = *x;
-			*x = filter_sample_df2(w, base::b_, base::M_, base::a_, base::N_);
-		}
+		Structure::filter_block(x_, L_, base::w_, base::P_, base::b_, base::M_, base::a_, base::N_);
 	}
 
 private:
@@ -849,8 +1135,9 @@ public:
 	ioport_ro<const_iterator> y;
 };
 
+//! @brief Direct-Form II block_filter<float> specialization using SIMD kernels.
 template<>
-class DSPXX_API block_filter<float>: public df2_filter_base<float, dsp::simd::buffer_traits<float> >
+class DSPXX_API block_filter<float, filter_structure::df2>: public df2_filter_base<float, dsp::simd::buffer_traits<float> >
 {
 	typedef df2_filter_base<float, dsp::simd::buffer_traits<float> > base;
 
@@ -920,6 +1207,403 @@ public:
 	ioport_ro<const_iterator> y;
 };
 
+/*!
+ * @brief Implementation of digital filter realized as a bank of second-order-sections (SOS), operating on blocks of samples.
+ * Contrary to filter_sos, each section is applied to the whole block before moving to the next one and the sections
+ * are realized in Transposed Direct-Form II, which needs no delay line shifting.
+ * @tparam Sample type of samples this filter operates on.
+ */
+template<class Sample>
+class block_filter_sos: public sos_filter_base<Sample>
+{
+	typedef sos_filter_base<Sample> base;
+public:
+	typedef Sample* iterator;
+	typedef const Sample* const_iterator;
+
+	using base::section_length;
+
+	/*!
+	 * @brief Construct SOS-bank filter given coefficients provided as a matrix in a form compatible with
+	 * MATLAB fdatool output.
+	 * @param L processing block length.
+	 * @param N number of second-order-sections (rows in num, numl, den and denl arrays).
+	 * @param num @f$N{\times}section\_length@f$ matrix with N rows of numerator coefficients.
+	 * @param numl N-row array with lengths of each coefficient vector in matrix num.
+	 * @param den @f$N{\times}section\_length@f$ matrix with N rows of denominator coefficients.
+	 * @param denl N-row array with lengths of each coefficient vector in matrix den.
+	 */
+	template<class CoeffSample, class CoeffSize>
+	block_filter_sos(size_t L, size_t N, const CoeffSample (*num)[section_length], const CoeffSize* numl, const CoeffSample (*den)[section_length], const CoeffSize* denl)
+	 :	base(N, num, numl, den, denl)
+	 ,	L_(L)
+	 ,	buf_(L_)
+	 ,	x(buf_.get(), L_)
+	 ,	y(buf_.get(), L_)
+	{}
+
+	template<class CoeffSample>
+	block_filter_sos(size_t L, size_t N, const CoeffSample* num, const CoeffSample* den)
+	 :	base(N, num, den)
+	 ,	L_(L)
+	 ,	buf_(L_)
+	 ,	x(buf_.get(), L_)
+	 ,	y(buf_.get(), L_)
+	{}
+
+	/*!
+	 * @brief Prepare filter for operation with given number of sections without actually initializing them.
+	 * @param[in] L processing block length.
+	 * @param[in] N number of second order sections
+	 * @see use set() to actually initialize to coefficient values
+	 */
+	block_filter_sos(size_t L, size_t N)
+	 :	base(N)
+	 ,	L_(L)
+	 ,	buf_(L_)
+	 ,	x(buf_.get(), L_)
+	 ,	y(buf_.get(), L_)
+	{}
+
+	//! @brief Apply the filter to the sample sequence specified by [x.begin(), x.end()) range.
+	void operator()()
+	{
+		Sample* const buf = buf_.get();
+		Sample* s = base::w_;
+		const Sample* b = base::b_;
+		const Sample* a = base::a_;
+		for (size_t j = 0; j < base::N_; ++j, s += base::step_, b += base::step_, a += base::step_) {
+			if (base::scale_only_[j])
+				std::transform(buf, buf + L_, buf, std::bind2nd(std::multiplies<Sample>(), *b));
+			else
+				filter_block_biquad_tdf2(buf, L_, s, b, a);
+		}
+	}
+
+private:
+	const size_t L_;
+	trivial_array<Sample> buf_;
+
+public:
+
+	ioport_rw<const_iterator, iterator> x;
+	ioport_ro<const_iterator> y;
+};
+
+template<>
+class DSPXX_API block_filter_sos<float>: public sos_filter_base<float, dsp::simd::buffer_traits<float> >
+{
+	typedef sos_filter_base<float, dsp::simd::buffer_traits<float> > base;
+public:
+	typedef float* iterator;
+	typedef const float* const_iterator;
+
+	using base::section_length;
+
+	template<class CoeffSample, class CoeffSize>
+	block_filter_sos(size_t L, size_t N, const CoeffSample (*num)[section_length], const CoeffSize* numl, const CoeffSample (*den)[section_length], const CoeffSize* denl)
+	 :	base(N, num, numl, den, denl)
+	 ,	L_(L)
+	 ,	buf_(N_ * dsp::simd::biquad_block_length + dsp::simd::aligned_count<float>(L_))
+	 ,	m_(buf_.get())
+	 ,	x_(m_ + N_ * dsp::simd::biquad_block_length)
+	 ,	x(x_, L_)
+	 ,	y(x_, L_)
+	{
+		prepare();
+	}
+
+	template<class CoeffSample>
+	block_filter_sos(size_t L, size_t N, const CoeffSample* num, const CoeffSample* den)
+	 :	base(N, num, den)
+	 ,	L_(L)
+	 ,	buf_(N_ * dsp::simd::biquad_block_length + dsp::simd::aligned_count<float>(L_))
+	 ,	m_(buf_.get())
+	 ,	x_(m_ + N_ * dsp::simd::biquad_block_length)
+	 ,	x(x_, L_)
+	 ,	y(x_, L_)
+	{
+		prepare();
+	}
+
+	/*!
+	 * @brief Prepare filter for operation with given number of sections without actually initializing them.
+	 * @param[in] L processing block length.
+	 * @param[in] N number of second order sections
+	 * @see use set() to actually initialize to coefficient values
+	 */
+	block_filter_sos(size_t L, size_t N)
+	 :	base(N)
+	 ,	L_(L)
+	 ,	buf_(N_ * dsp::simd::biquad_block_length + dsp::simd::aligned_count<float>(L_))
+	 ,	m_(buf_.get())
+	 ,	x_(m_ + N_ * dsp::simd::biquad_block_length)
+	 ,	x(x_, L_)
+	 ,	y(x_, L_)
+	{}
+
+	template<class CoeffSample, class CoeffSize>
+	void set(const CoeffSample (*num)[section_length], const CoeffSize* numl, const CoeffSample (*den)[section_length], const CoeffSize* denl)
+	{
+		base::set(num, numl, den, denl);
+		prepare();
+	}
+
+	template<class CoeffSample>
+	void set(const CoeffSample* num, const CoeffSample* den)
+	{
+		base::set(num, den);
+		prepare();
+	}
+
+	//! @brief Apply the filter to the sample sequence specified by [x.begin(), x.end()) range.
+	void operator()();
+
+private:
+	//! @brief Compute state-space coefficients of each section with dsp::simd::biquad_block_coeffs().
+	void prepare();
+
+	const size_t L_;
+	trivial_array<float, dsp::simd::allocator<float> > buf_;
+	float* const m_;				//!< state-space coefficients of each section (N_ * biquad_block_length).
+	float* const x_;
+
+public:
+
+	ioport_rw<const_iterator, iterator> x;
+	ioport_ro<const_iterator> y;
+};
+
+/*!
+ * @brief Digital filter realized as a bank of second-order-sections (SOS) applied with the same coefficients to multiple
+ * channels of the audio stream, described by snd::buffer_layout (interleaved or planar).
+ * @tparam Sample type of samples this filter operates on.
+ */
+template<class Sample>
+class filter_sos_multichannel: public sos_filter_base<Sample>
+{
+	typedef sos_filter_base<Sample> base;
+public:
+
+	using base::section_length;
+
+	/*!
+	 * @brief Construct SOS-bank filter given coefficients provided as a matrix in a form compatible with
+	 * MATLAB fdatool output.
+	 * @param C number of channels.
+	 * @param N number of second-order-sections (rows in num, numl, den and denl arrays).
+	 * @param num @f$N{\times}section\_length@f$ matrix with N rows of numerator coefficients.
+	 * @param numl N-row array with lengths of each coefficient vector in matrix num.
+	 * @param den @f$N{\times}section\_length@f$ matrix with N rows of denominator coefficients.
+	 * @param denl N-row array with lengths of each coefficient vector in matrix den.
+	 */
+	template<class CoeffSample, class CoeffSize>
+	filter_sos_multichannel(size_t C, size_t N, const CoeffSample (*num)[section_length], const CoeffSize* numl, const CoeffSample (*den)[section_length], const CoeffSize* denl)
+	 :	base(N, num, numl, den, denl)
+	 ,	C_(C)
+	 ,	buf_(base::N_ * (sos_lanes_length + 2 * C_) + chunk_length * C_)
+	 ,	c_(buf_.get())
+	 ,	s_(c_ + base::N_ * sos_lanes_length)
+	 ,	x_(s_ + 2 * base::N_ * C_)
+	{
+		prepare();
+	}
+
+	template<class CoeffSample>
+	filter_sos_multichannel(size_t C, size_t N, const CoeffSample* num, const CoeffSample* den)
+	 :	base(N, num, den)
+	 ,	C_(C)
+	 ,	buf_(base::N_ * (sos_lanes_length + 2 * C_) + chunk_length * C_)
+	 ,	c_(buf_.get())
+	 ,	s_(c_ + base::N_ * sos_lanes_length)
+	 ,	x_(s_ + 2 * base::N_ * C_)
+	{
+		prepare();
+	}
+
+	/*!
+	 * @brief Prepare filter for operation with given number of sections without actually initializing them.
+	 * @param[in] C number of channels.
+	 * @param[in] N number of second order sections
+	 * @see use set() to actually initialize to coefficient values
+	 */
+	filter_sos_multichannel(size_t C, size_t N)
+	 :	base(N)
+	 ,	C_(C)
+	 ,	buf_(base::N_ * (sos_lanes_length + 2 * C_) + chunk_length * C_)
+	 ,	c_(buf_.get())
+	 ,	s_(c_ + base::N_ * sos_lanes_length)
+	 ,	x_(s_ + 2 * base::N_ * C_)
+	{}
+
+	template<class CoeffSample, class CoeffSize>
+	void set(const CoeffSample (*num)[section_length], const CoeffSize* numl, const CoeffSample (*den)[section_length], const CoeffSize* denl)
+	{
+		base::set(num, numl, den, denl);
+		prepare();
+	}
+
+	template<class CoeffSample>
+	void set(const CoeffSample* num, const CoeffSample* den)
+	{
+		base::set(num, den);
+		prepare();
+	}
+
+	//! @return number of channels this filter is configured for.
+	size_t channel_count() const {return C_;}
+
+	/*!
+	 * @brief Filter length frames of the buffer in place.
+	 * @param[in,out] x audio buffer with channel_count() channels.
+	 * @param[in] bl layout of the buffer (strides are in bytes).
+	 * @param[in] length number of frames to filter.
+	 */
+	void operator()(Sample* x, const snd::buffer_layout& bl, size_t length) {operator()(x, bl, x, bl, length);}
+
+	/*!
+	 * @brief Filter length frames of the input buffer into the output buffer, which may use different layout.
+	 * @param[in] in input audio buffer with channel_count() channels.
+	 * @param[in] bl_in layout of the input buffer (strides are in bytes).
+	 * @param[out] out output audio buffer with channel_count() channels.
+	 * @param[in] bl_out layout of the output buffer (strides are in bytes).
+	 * @param[in] length number of frames to filter.
+	 * @pre in and out are either the same buffer with the same layout (filtering in place) or they don't overlap;
+	 * partially overlapping buffers are not supported.
+	 */
+	void operator()(const Sample* in, const snd::buffer_layout& bl_in, Sample* out, const snd::buffer_layout& bl_out, size_t length)
+	{
+		const char* i = reinterpret_cast<const char*>(in);
+		char* o = reinterpret_cast<char*>(out);
+		while (0 != length) {
+			const size_t L = (length < chunk_length ? length : chunk_length);
+			Sample* x = x_;
+			for (size_t n = 0; n < L; ++n, i += bl_in.sample_stride)
+				for (size_t k = 0; k < C_; ++k, ++x)
+					*x = *reinterpret_cast<const Sample*>(i + k * bl_in.channel_stride);
+			filter_sos_lanes_tdf2(x_, L, C_, C_, base::N_, c_, s_);
+			x = x_;
+			for (size_t n = 0; n < L; ++n, o += bl_out.sample_stride)
+				for (size_t k = 0; k < C_; ++k, ++x)
+					*reinterpret_cast<Sample*>(o + k * bl_out.channel_stride) = *x;
+			length -= L;
+		}
+	}
+
+private:
+	static const size_t chunk_length = 64;	//!< Number of frames gathered and filtered at once.
+
+	void prepare()
+	{
+		Sample* c = c_;
+		const Sample* b = base::b_;
+		const Sample* a = base::a_;
+		for (size_t j = 0; j < base::N_; ++j, c += sos_lanes_length, b += base::step_, a += base::step_) {
+			std::fill_n(c, sos_lanes_length, Sample());
+			c[0] = b[0];
+			if (!base::scale_only_[j]) {
+				c[1] = b[1]; c[2] = b[2];
+				c[3] = a[1]; c[4] = a[2];
+			}
+		}
+	}
+
+	const size_t C_;
+	trivial_array<Sample> buf_;
+	Sample* const c_;				//!< Coefficients of each section (N_ * sos_lanes_length).
+	Sample* const s_;				//!< State of each section (2 * C_ * N_).
+	Sample* const x_;				//!< Frames gathered from the input buffer (chunk_length * C_).
+};
+
+template<>
+class DSPXX_API filter_sos_multichannel<float>: public sos_filter_base<float, dsp::simd::buffer_traits<float> >
+{
+	typedef sos_filter_base<float, dsp::simd::buffer_traits<float> > base;
+public:
+
+	using base::section_length;
+
+	template<class CoeffSample, class CoeffSize>
+	filter_sos_multichannel(size_t C, size_t N, const CoeffSample (*num)[section_length], const CoeffSize* numl, const CoeffSample (*den)[section_length], const CoeffSize* denl)
+	 :	base(N, num, numl, den, denl)
+	 ,	C_(C)
+	 ,	C_pad_(lanes(C_))
+	 ,	buf_(N_ * (sos_lanes_length + 2 * C_pad_) + chunk_length * C_pad_)
+	 ,	c_(buf_.get())
+	 ,	s_(c_ + N_ * sos_lanes_length)
+	 ,	x_(s_ + 2 * N_ * C_pad_)
+	{
+		prepare();
+	}
+
+	template<class CoeffSample>
+	filter_sos_multichannel(size_t C, size_t N, const CoeffSample* num, const CoeffSample* den)
+	 :	base(N, num, den)
+	 ,	C_(C)
+	 ,	C_pad_(lanes(C_))
+	 ,	buf_(N_ * (sos_lanes_length + 2 * C_pad_) + chunk_length * C_pad_)
+	 ,	c_(buf_.get())
+	 ,	s_(c_ + N_ * sos_lanes_length)
+	 ,	x_(s_ + 2 * N_ * C_pad_)
+	{
+		prepare();
+	}
+
+	/*!
+	 * @brief Prepare filter for operation with given number of sections without actually initializing them.
+	 * @param[in] C number of channels.
+	 * @param[in] N number of second order sections
+	 * @see use set() to actually initialize to coefficient values
+	 */
+	filter_sos_multichannel(size_t C, size_t N)
+	 :	base(N)
+	 ,	C_(C)
+	 ,	C_pad_(lanes(C_))
+	 ,	buf_(N_ * (sos_lanes_length + 2 * C_pad_) + chunk_length * C_pad_)
+	 ,	c_(buf_.get())
+	 ,	s_(c_ + N_ * sos_lanes_length)
+	 ,	x_(s_ + 2 * N_ * C_pad_)
+	{}
+
+	template<class CoeffSample, class CoeffSize>
+	void set(const CoeffSample (*num)[section_length], const CoeffSize* numl, const CoeffSample (*den)[section_length], const CoeffSize* denl)
+	{
+		base::set(num, numl, den, denl);
+		prepare();
+	}
+
+	template<class CoeffSample>
+	void set(const CoeffSample* num, const CoeffSample* den)
+	{
+		base::set(num, den);
+		prepare();
+	}
+
+	//! @return number of channels this filter is configured for.
+	size_t channel_count() const {return C_;}
+
+	//! @copydoc filter_sos_multichannel::operator()(Sample*, const snd::buffer_layout&, size_t)
+	void operator()(float* x, const snd::buffer_layout& bl, size_t length) {operator()(x, bl, x, bl, length);}
+
+	//! @copydoc filter_sos_multichannel::operator()(const Sample*, const snd::buffer_layout&, Sample*, const snd::buffer_layout&, size_t)
+	void operator()(const float* in, const snd::buffer_layout& bl_in, float* out, const snd::buffer_layout& bl_out, size_t length);
+
+private:
+	static const size_t chunk_length = 64;	//!< Number of frames gathered and filtered at once.
+
+	//! @return number of vector lanes used for C channels (C rounded up to a multiple of 4).
+	static size_t lanes(size_t C) {return (C + 3) & ~size_t(3);}
+
+	void prepare();
+
+	const size_t C_;
+	const size_t C_pad_;			//!< Number of lanes, C_ rounded up to a multiple of 4.
+	trivial_array<float, dsp::simd::allocator<float> > buf_;
+	float* const c_;				//!< Coefficients of each section (N_ * sos_lanes_length).
+	float* const s_;				//!< State of each section (2 * C_pad_ * N_).
+	float* const x_;				//!< Frames gathered from the input buffer, padded to C_pad_ lanes (chunk_length * C_pad_).
+};
+
 template<class InputIterator, class OutputIterator, class BlockAlgorithm> inline 
 #if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
 BOOST_CONCEPT_REQUIRES(
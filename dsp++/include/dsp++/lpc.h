@@ -121,7 +121,7 @@ private:
 
 		dft_();
 		complex_t* c = interm_.get();
-		for (size_t i = 0; i < N_; ++i, ++c) 
+		for (size_t i = 0; i < K_; ++i, ++c) 
 			*c = pow(abs(*c), 2);
 		idft_();
 
@@ -133,7 +133,8 @@ private:
 	}
 
 	const size_t L_;					//!< input sequence length
-	const size_t N_;		 			//!< DFT/IDFT transform length (nextpow2(L_ * 2 - 1))
+	const size_t N_;		 			//!< DFT/IDFT transform length (dft::fast_length(L_ * 2 - 1))
+	const size_t K_;					//!< number of non-redundant transform bins (N_ / 2 + 1 for real Sample type)
 	const size_t P_;					//!< prediction order
 	sample_buffer_t in_out_;
 	complex_buffer_t interm_;
@@ -174,10 +175,11 @@ size_t lpc<Sample, DFT>::verify_dft_length(const size_t dft_size, const size_t i
 template<class Sample, template <class, class> class DFT> inline
 lpc<Sample, DFT>::lpc(size_t L, size_t P)
  :	L_(verify_length(L))
- ,	N_(dsp::nextpow2(L_ * 2 - 1))
+ ,	N_(dsp::dft::fast_length(L_ * 2 - 1))
+ ,	K_(dsp::is_complex<Sample>::value ? N_ : N_ / 2 + 1)
  ,	P_(verify_order(P))
  ,	in_out_(N_)
- ,	interm_(N_)
+ ,	interm_(K_)
  ,	dft_(N_, in_out_.get(), interm_.get(), dsp::dft::sign::forward)
  ,	idft_(N_, interm_.get(), in_out_.get(), dsp::dft::sign::backward)
  ,	lev_(N_, P_)
@@ -188,9 +190,10 @@ template<class Sample, template <class, class> class DFT> inline
 lpc<Sample, DFT>::lpc(size_t L, const dft_t& dft, const idft_t& idft, size_t P)
  :	L_(verify_length(L))
  ,	N_(verify_dft_length(dft.size(), idft.size()))
+ ,	K_(dsp::is_complex<Sample>::value ? N_ : N_ / 2 + 1)
  ,	P_(verify_order(P))
  ,	in_out_(N_)
- ,	interm_(N_)
+ ,	interm_(K_)
  ,	dft_(dft)
  ,	idft_(idft)
  ,	lev_(N_, P_)
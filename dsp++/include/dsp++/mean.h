@@ -60,6 +60,7 @@ public:
 	 ,	pmean_(L * buffer_[0])
      , 	L_(L)
  	 , 	n_(0)
+	 ,	scale_(Sample(1) / Sample(L))
 	{
 	}
 
@@ -69,6 +70,7 @@ public:
 	 ,	pmean_(L * buffer_[0])
      , 	L_(L)
  	 , 	n_(0)
+	 ,	scale_(Sample(1) / Sample(L))
 	{
 	}
 
@@ -79,21 +81,50 @@ public:
 	 */
 	Sample operator()(Sample x)
 	{
-		Sample p = functor_.power(x) / L_;
-		pmean_ -= buffer_[n_];	// subtract oldest intermediate value from previous step result
-		pmean_ += p;			// add current intermediate value
+		Sample p = functor_.power(x) * scale_;
+		pmean_ += p - buffer_[n_];	// replace oldest intermediate value in previous step result with current one
 		buffer_[n_] = p;		// and store it in circular buffer so that it can be subtracted when we advance by L_ samples
-		++n_;					// move circular buffer to next index
-		n_ %= L_;
+		if (++n_ == L_)			// move circular buffer to next index
+			n_ = 0;
 		return functor_.root(pmean_); // return the appropriate root of the intermediate sum
 	}
 
+	/*!
+	 * @brief Block version of operator()(Sample), gives the same results.
+	 * Powers and roots are calculated in separate passes over the block, so that only the running sum
+	 * remains sequential.
+	 * @param x subsequent samples (len).
+	 * @param y mean values for each of the samples (len), may be the same as x.
+	 * @param len number of samples.
+	 */
+	void operator()(const Sample* x, Sample* y, size_t len)
+	{
+		for (size_t i = 0; i < len; ++i)
+			y[i] = functor_.power(x[i]) * scale_;
+		Sample* const buffer = buffer_.get();
+		Sample pmean = pmean_;	// local copies, stores to y and buffer might alias the members otherwise
+		size_t n = n_;
+		for (size_t i = 0; i < len; ++i) {
+			const Sample p = y[i];
+			pmean += p - buffer[n];
+			buffer[n] = p;
+			if (++n == L_)
+				n = 0;
+			y[i] = pmean;
+		}
+		pmean_ = pmean;
+		n_ = n;
+		for (size_t i = 0; i < len; ++i)
+			y[i] = functor_.root(y[i]);
+	}
+
 private:
 	Functor functor_;
 	trivial_array<Sample, Allocator> buffer_;	//!< L_-length (circular) buffer holding intermediate values (averaged powers or logs if p_ == 0)
 	Sample pmean_;					//!< previous step mean value
 	const size_t L_;				//!< averaging period and buffer_ length
 	size_t n_;						//!< index of current sample in the circular buffer
+	const Sample scale_;			//!< 1/L_, so that the powers are scaled with multiplication
 };
 
 
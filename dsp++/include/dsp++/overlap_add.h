@@ -12,10 +12,18 @@
 #include <dsp++/algorithm.h>
 #include <dsp++/noncopyable.h>
 #include <dsp++/ioport.h>
+#include <dsp++/simd.h>
+#include <dsp++/vectmath.h>
 
 #include <algorithm>
 #include <functional>
 
+#if DSP_CXX_CONFORM_CXX11
+#include <atomic>
+#else
+#include <boost/atomic.hpp>
+#endif
+
 #if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
 #include <boost/concept/requires.hpp>
 #include <boost/concept_check.hpp>
@@ -23,6 +31,193 @@
 
 namespace dsp {
 
+namespace detail {
+
+#if DSP_CXX_CONFORM_CXX11
+using std::atomic;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::memory_order_acq_rel;
+#else
+using boost::atomic;
+using boost::memory_order_acquire;
+using boost::memory_order_release;
+using boost::memory_order_acq_rel;
+#endif
+
+/*!
+ * @brief Double-buffered impulse response transform used by overlap_add and multichannel_overlap_add.
+ * One of the banks is used by the processing thread, while the new impulse response may be transformed
+ * into the other one by a (single) control thread through stage(). Handing over the staged bank is
+ * synchronized through single atomic state word, so neither of the threads ever blocks or allocates
+ * (the processing thread may only retry compare-and-swap if the control thread withdraws staged transform
+ * at the same time).
+ * Both banks are scaled by the IDFT normalization factor 1/N and zero-padded up to SIMD-aligned length.
+ */
+template<class Real, template<class, class> class DFT>
+class ir_spectrum: private noncopyable
+{
+public:
+	typedef Real value_type;
+	typedef std::complex<value_type> complex_type;
+	typedef DFT<value_type, complex_type> transform_type;
+	typedef typename transform_type::input_allocator real_allocator;
+	typedef dsp::simd::allocator<complex_type> complex_allocator;
+
+	//! @brief Bits of the state word returned by poll().
+	enum {
+		bank_mask = 1,		//!< Index of the bank in use by the processing thread.
+		pending = 2,		//!< The other bank holds staged transform which should be activated with the next frame.
+		crossfade = 4,		//!< The output of the next frame should be crossfaded from the current to the staged transform.
+		claimed = 8			//!< The processing thread is activating the staged transform.
+	};
+
+	/*!
+	 * @param N transform size.
+	 * @param M maximum length of impulse response.
+	 * @param staging_count number of transform-sized real buffers to allocate for staging_buffer().
+	 */
+	ir_spectrum(size_t N, size_t M, size_t staging_count = 1)
+	 :	N_(N)
+	 ,	M_(M)
+	 ,	K_(N / 2 + 1)
+	 ,	Kp_(dsp::simd::aligned_count<complex_type>(K_))
+	 ,	Np_(dsp::simd::aligned_count<value_type>(N_))
+	 ,	S_(staging_count)
+	 ,	rbuf_(ralloc_.allocate(S_ * Np_))
+	 ,	cbuf_(calloc_.allocate(3 * Kp_))
+	 ,	dft_(N_, rbuf_, cbuf_)
+	 ,	state_(0)
+	{
+		std::fill_n(cbuf_, 3 * Kp_, complex_type());
+	}
+
+	~ir_spectrum()
+	{
+		calloc_.deallocate(cbuf_, 3 * Kp_);
+		ralloc_.deallocate(rbuf_, S_ * Np_);
+	}
+
+	//! @return padded length of the transform banks.
+	size_t padded_size() const {return Kp_;}
+	//! @return transform bank with the specified index.
+	complex_type* bank(unsigned index) const {return cbuf_ + index * Kp_;}
+	//! @return spectrum-sized scratch buffer, which is owned by the processing thread.
+	complex_type* scratch() const {return cbuf_ + 2 * Kp_;}
+	/*!
+	 * @return real-valued, transform-sized buffer used for staging. While the staged transform is claimed by
+	 * poll(), staging buffers are not used by the control thread, so the processing thread may use them as
+	 * a scratch space.
+	 */
+	value_type* staging_buffer(size_t index = 0) const {return rbuf_ + index * Np_;}
+
+	/*!
+	 * @brief Replace the transform in bank currently in use. May only be used when no other thread calls stage().
+	 * @return the updated bank.
+	 */
+	template<class Sample>
+	complex_type* assign(const Sample* ir, size_t ir_length)
+	{
+		complex_type* h = bank(state_.load(memory_order_acquire) & bank_mask);
+		transform(ir, ir_length, h);
+		return h;
+	}
+
+	/*!
+	 * @brief Calculate the transform of new impulse response into the bank not being used by the processing
+	 * thread and schedule its activation. Called from the control thread.
+	 * @param ir impulse response vector.
+	 * @param ir_length length of impulse response vector (truncated to M).
+	 * If previously staged transform hasn't been picked up by the processing thread yet, it is withdrawn
+	 * and replaced with the new one.
+	 * @param fade whether to crossfade the output when activating the new transform.
+	 * @return false if previously staged transform is being activated by the processing thread at the very
+	 * moment (nothing is changed then, the call should be retried).
+	 */
+	template<class Sample>
+	bool stage(const Sample* ir, size_t ir_length, bool fade)
+	{
+		unsigned s = state_.load(memory_order_acquire);
+		while (s & pending)
+		{
+			if (s & claimed)
+				return false;
+			if (state_.compare_exchange_weak(s, s & bank_mask, memory_order_acq_rel, memory_order_acquire))
+				s &= bank_mask;
+		}
+		transform(ir, ir_length, bank(~s & bank_mask));
+		state_.store(s | pending | (fade ? crossfade : 0), memory_order_release);
+		return true;
+	}
+
+	/*!
+	 * @brief Called from the processing thread at the start of each frame. If there's a staged transform,
+	 * it is claimed for activation, so that the control thread won't withdraw it until commit() is called.
+	 * @return current state word (without the claimed bit).
+	 */
+	unsigned poll()
+	{
+		unsigned s = state_.load(memory_order_acquire);
+		while ((s & pending) && !state_.compare_exchange_weak(s, s | claimed, memory_order_acq_rel, memory_order_acquire))
+			;
+		return s;
+	}
+
+	/*!
+	 * @brief Mark the staged bank as the one in use, releasing the previous one and the staging buffers
+	 * to the control thread. Called from the processing thread after the frame is processed.
+	 * @param s state word obtained from poll(), with pending bit set.
+	 * @return the activated bank.
+	 */
+	complex_type* commit(unsigned s)
+	{
+		const unsigned b = ~s & bank_mask;
+		state_.store(b, memory_order_release);
+		return bank(b);
+	}
+
+private:
+	template<class Sample>
+	void transform(const Sample* ir, size_t ir_length, complex_type* h)
+	{
+		ir_length = std::min(M_, ir_length);
+		std::copy(ir, ir + ir_length, rbuf_);
+		std::fill_n(rbuf_ + ir_length, N_ - ir_length, value_type());
+		dft_(rbuf_, h);
+		const value_type scale = value_type(1) / static_cast<value_type>(N_);
+		for (size_t k = 0; k < K_; ++k)
+			h[k] *= scale;
+		std::fill(h + K_, h + Kp_, complex_type());
+	}
+
+	real_allocator ralloc_;
+	complex_allocator calloc_;
+	const size_t N_;
+	const size_t M_;
+	const size_t K_;
+	const size_t Kp_;
+	const size_t Np_;		//!< N_ with SIMD padding included.
+	const size_t S_;		//!< Number of staging buffers.
+	value_type* rbuf_;		//!< Staging buffers (S_ * Np_).
+	complex_type* cbuf_;	//!< Two transform banks followed by scratch spectrum (3 * Kp_).
+	transform_type dft_;
+	atomic<unsigned> state_;
+};
+
+/*!
+ * @brief Crossfade linearly from old to new output frame, storing the result in the new frame.
+ * The last sample is taken entirely from the new frame.
+ */
+template<class Real> inline
+void crossfade(Real* res, const Real* prev, size_t L)
+{
+	const Real step = Real(1) / static_cast<Real>(L);
+	for (size_t i = 0; i < L; ++i)
+		res[i] = prev[i] + static_cast<Real>(i + 1) * step * (res[i] - prev[i]);
+}
+
+}
+
 /*!
  * @brief Implementation of Overlapp-Add convolution (FIR filtering via frequency-domain multiplication).
  * @tparam Real real-number type representing input & output signal samples.
@@ -38,7 +233,8 @@ public:
 	typedef DFT<value_type, complex_type> transform_type;
 	typedef DFT<complex_type, value_type> inverse_transform_type;
 	typedef typename transform_type::input_allocator real_allocator;
-	typedef typename transform_type::output_allocator complex_allocator;
+	//! @brief Spectra are kept in SIMD-aligned and padded vectors, so that they may be multiplied with dsp::simd::mul().
+	typedef dsp::simd::allocator<complex_type> complex_allocator;
 	typedef value_type* iterator;
 	typedef const value_type* const_iterator;
 	typedef complex_type* complex_iterator;
@@ -105,14 +301,14 @@ public:
 	set_impulse_response(Iterator begin, Iterator end)
 	{
 		size_t n = dsp::copy_at_most_n(begin, end, M_, rbuf_);
-		std::fill_n(rbuf_ + n, N_ - n, value_type());
-		prepare_ir_dft(false);
+		h_ = spec_.assign(rbuf_, n);
 	}
 
 	/*!
 	 * @brief Replace filter's impulse response with a new one (of the same or shorter length).
-	 * Invocation of this function will cause new impulse response transform to be calculated,
-	 * which, as a side-effect will cause samples of current frame to be overwritten.
+	 * Invocation of this function will cause new impulse response transform to be calculated
+	 * (samples of current frame are left intact). The change takes effect abruptly, with the next frame.
+	 * Must not be called concurrently with operator()() or stage_impulse_response().
 	 * @param ir start of impulse response vector.
 	 * @param ir_length length of impulse response vector.
 	 * @tparam Sample type convertible to value_type, which represents impulse response vector elements.
@@ -125,14 +321,37 @@ public:
 #endif
 	set_impulse_response(const Sample* ir, size_t ir_length)
 	{
-		ir_length = std::min(M_, ir_length);
-		std::copy(ir, ir + ir_length, rbuf_);
-		std::fill_n(rbuf_ + ir_length, N_ - ir_length, value_type());
-		prepare_ir_dft(false);
+		h_ = spec_.assign(ir, ir_length);
+	}
+
+	/*!
+	 * @brief Prepare new impulse response (of the same or shorter length) to be used starting with the next
+	 * frame. The transform is calculated into the spare buffer, so this may be called from a control thread
+	 * while another thread keeps calling operator()(), without locking. Only one control thread may stage
+	 * impulse responses at a time.
+	 * @param ir start of impulse response vector.
+	 * @param ir_length length of impulse response vector.
+	 * @param crossfade if true, the output of the frame activating new impulse response is linearly
+	 * crossfaded from the output of previous one, which costs one additional spectrum multiplication and IDFT.
+	 * @return false if previously staged impulse response is being activated at the moment by the thread calling
+	 * operator()() (nothing is changed then and the call should be retried). Impulse response which wasn't picked
+	 * up yet is simply replaced.
+	 * @tparam Sample type convertible to value_type, which represents impulse response vector elements.
+	 */
+	template<class Sample>
+	bool stage_impulse_response(const Sample* ir, size_t ir_length, bool crossfade = false)
+	{
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+		BOOST_CONCEPT_ASSERT((boost::Convertible<Sample, Real>));
+#endif
+		return spec_.stage(ir, ir_length, crossfade);
 	}
 
 private:
-	void prepare_ir_dft(bool zero_tail);
+	template<class R, template<class, class> class D> friend class multichannel_overlap_add;
+	typedef detail::ir_spectrum<Real, DFT> spectrum_type;
+
+	void activate_staged(unsigned state);
 
 	/*!
 	 * @brief Find length of the non-zero portion of impulse response given it as an iterator range.
@@ -176,13 +395,16 @@ private:
 	complex_allocator calloc_;
 	const size_t L_; 	//!< Frame length.
 	const size_t M_;	//!< Impulse response length.
-	const size_t N_;	//!< DFT Transform length (nextpow2(L_ + M_)).
+	const size_t N_;	//!< DFT Transform length (dft::fast_length(L_ + M_)).
+	const size_t K_;	//!< Number of non-redundant DFT bins of real sequence (N_ / 2 + 1).
+	const size_t Kp_;	//!< K_ with SIMD padding included.
 	value_type* rbuf_;		//!< Real-valued buffer (of length N_ + M_, first N_ samples serve as input buffer
 							//!< for DFT and output buffer for IDFT, last M_ samples are used for storing overlapping
 							//!< fragment of previous frame.
-	complex_type* cbuf_; 	//!< Complex-valued buffer (of length 2 * N_), first N_ samples serve as
-							//!< output buffer for DFT and input buffer for IDFT, last N_ samples
-							//!< are used for storing pre-computed transform of impulse response.
+	complex_type* cbuf_; 	//!< Complex-valued buffer (of length Kp_), serves as output buffer for DFT and
+							//!< input buffer for IDFT.
+	spectrum_type spec_;	//!< Double-buffered transform of impulse response.
+	complex_type* h_;		//!< Impulse response transform vector in use (scaled by 1/N_).
 	transform_type dft_;	//!< DFT functor
 	inverse_transform_type idft_; //!< IDFT functor
 
@@ -190,46 +412,43 @@ public:
 	ioport_rw<const_iterator, iterator> x;
 	ioport_ro<const_iterator> y;
 
-	//! @brief Access/modify impulse response transform \f$H(z)\f$.
+	//! @brief Access/modify impulse response transform \f$H(z)\f$, scaled by the IDFT normalization factor 1/transform_size().
+	//! @note This is rebound to the other buffer when impulse response passed to stage_impulse_response() is activated.
 	ioport_rw<const_complex_iterator, complex_iterator> H;
 };
 
 template<class Real, template<class, class> class DFT> inline
 overlap_add<Real, DFT>::~overlap_add()
 {
-	calloc_.deallocate(cbuf_, 2 * N_);
+	calloc_.deallocate(cbuf_, Kp_);
 	ralloc_.deallocate(rbuf_, N_ + M_);
 }
 
-template<class Real, template<class, class> class DFT> inline
-void overlap_add<Real, DFT>::prepare_ir_dft(bool zero_tail)
-{
-	std::fill_n(rbuf_ + M_, (zero_tail ? N_ : N_ - M_), value_type()); 	 // pad impulse response with
-												// 0's up to length N and initialize
-												// overlapping region to 0's too (if zero_tail is set)
-	dft_();										// calculate the DFT of impulse response
-	std::copy(cbuf_, cbuf_ + N_, cbuf_ + N_);	// copy calculated transform to the destination
-}
-
 template<class Real, template<class, class> class DFT>
 template<class Iterator> inline
 overlap_add<Real, DFT>::overlap_add(size_t frame_length, Iterator ir_begin, Iterator ir_end, bool preserve_ir_length)
  :	L_(frame_length)
  , 	M_(preserve_ir_length ? std::distance(ir_begin, ir_end) : nonzero_length(ir_begin, ir_end))	// find real length of the impulse response
- ,	N_(nextpow2(L_ + M_))				// calculate transform size
+ ,	N_(dft::fast_length(L_ + M_))				// calculate transform size
+ ,	K_(N_ / 2 + 1)						// only half of the spectrum of real sequence is needed
+ ,	Kp_(dsp::simd::aligned_count<complex_type>(K_))
  , 	rbuf_(ralloc_.allocate(N_ + M_))	// don't even bother with calling construct() on these, they are just numbers
- , 	cbuf_(calloc_.allocate(2 * N_))
+ , 	cbuf_(calloc_.allocate(Kp_))
+ ,	spec_(N_, M_)
+ ,	h_(spec_.bank(0))
  ,	dft_(N_, rbuf_, cbuf_)
  , 	idft_(N_, cbuf_, rbuf_)
  ,	x(rbuf_, L_)
  ,	y(rbuf_, L_)
- ,	H(cbuf_ + N_, cbuf_ + 2*N_)
+ ,	H(h_, K_)
 {
 #if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
 	BOOST_CONCEPT_ASSERT((boost::BidirectionalIterator<Iterator>));
 #endif
 	std::copy_n(ir_begin, M_, rbuf_); 		// copy impulse response to rbuf to calculate its DFT
-	prepare_ir_dft(true);
+	spec_.assign(rbuf_, M_);
+	std::fill_n(rbuf_, N_ + M_, value_type());	// initialize overlapping region to 0's
+	std::fill_n(cbuf_, Kp_, complex_type());	// padding isn't touched by DFT but it's multiplied too
 }
 
 template<class Real, template<class, class> class DFT>
@@ -237,20 +456,44 @@ template<class Sample> inline
 overlap_add<Real, DFT>::overlap_add(size_t frame_length, const Sample* ir, size_t ir_length, bool preserve_ir_length)
  :	L_(frame_length)
  ,	M_(preserve_ir_length ? ir_length : nonzero_length(ir, ir + ir_length))
- ,	N_(nextpow2(L_ + M_))
+ ,	N_(dft::fast_length(L_ + M_))
+ ,	K_(N_ / 2 + 1)
+ ,	Kp_(dsp::simd::aligned_count<complex_type>(K_))
  ,	rbuf_(ralloc_.allocate(N_ + M_))
- ,	cbuf_(calloc_.allocate(2 * N_))
+ ,	cbuf_(calloc_.allocate(Kp_))
+ ,	spec_(N_, M_)
+ ,	h_(spec_.bank(0))
  ,	dft_(N_, rbuf_, cbuf_)
  ,	idft_(N_, cbuf_, rbuf_)
  ,	x(rbuf_, L_)
  ,	y(rbuf_, L_)
- ,	H(cbuf_ + N_, cbuf_ + 2*N_)
+ ,	H(h_, K_)
 {
 #if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
 	BOOST_CONCEPT_ASSERT((boost::Convertible<Sample, Real>));
 #endif
-	std::copy_n(ir, M_, rbuf_); 		// copy impulse response to rbuf to calculate its DFT
-	prepare_ir_dft(true);
+	spec_.assign(ir, M_);
+	std::fill_n(rbuf_, N_ + M_, value_type());	// initialize overlapping region to 0's
+	std::fill_n(cbuf_, Kp_, complex_type());	// padding isn't touched by DFT but it's multiplied too
+}
+
+template<class Real, template<class, class> class DFT> inline
+void overlap_add<Real, DFT>::activate_staged(unsigned state)
+{
+	complex_type* const h = spec_.bank(~state & spectrum_type::bank_mask);
+	value_type* const prev = spec_.staging_buffer();
+	if (state & spectrum_type::crossfade)
+	{
+		complex_type* const c = spec_.scratch();		// calculate the output with previous transform too,
+		dsp::simd::mul(c, cbuf_, h_, Kp_);				// before the frame spectrum is overwritten
+		idft_(c, prev);
+	}
+	dsp::simd::mul(cbuf_, cbuf_, h, Kp_);
+	idft_(cbuf_, rbuf_);
+	if (state & spectrum_type::crossfade)
+		detail::crossfade(rbuf_, prev, L_);
+	h_ = spec_.commit(state);
+	H = ioport_rw<const_complex_iterator, complex_iterator>(h_, K_);
 }
 
 template<class Real, template<class, class> class DFT> inline
@@ -258,13 +501,272 @@ void overlap_add<Real, DFT>::operator ()()
 {
 	std::fill_n(rbuf_ + L_, N_ - L_, value_type()); 	// fill the input vector with 0's starting from L up to N
 	dft_(rbuf_, cbuf_);									// obtain DFT of the current (zero-padded) frame
-	std::transform(cbuf_, cbuf_ + N_, cbuf_ + N_, cbuf_, std::multiplies<complex_type>()); // multiply the transforms
-	idft_(cbuf_, rbuf_);								// perform IDFT
-	std::transform(rbuf_, rbuf_ + N_, rbuf_, std::bind2nd(std::divides<value_type>(), static_cast<value_type>(N_)));
-														// normalize the IDFT by a factor of 1/N
-	std::transform(rbuf_, rbuf_ + M_, rbuf_ + N_, rbuf_, std::plus<value_type>());	// add the "tail" M samples
-														// left from previous step
-	std::copy(rbuf_ + L_, rbuf_ + L_ + M_, rbuf_ + N_);	// save the "tail" M samples for next step
+	const unsigned state = spec_.poll();
+	if (state & spectrum_type::pending)					// switch to the staged transform, if there's any
+		activate_staged(state);
+	else
+	{
+		dsp::simd::mul(cbuf_, cbuf_, h_, Kp_);			// multiply the transforms, H is already normalized by 1/N
+		idft_(cbuf_, rbuf_);							// perform IDFT
+	}
+
+	// Add the "tail" M samples left from previous step to the output frame and save the new "tail" for
+	// the next step in a single pass: the new tail is the IDFT result past the frame, plus the part of
+	// the old tail extending past the frame (if M > L), which is read before it is overwritten.
+	value_type* const t = rbuf_ + N_;
+	const size_t n = std::min(L_, M_);
+	for (size_t i = 0; i < n; ++i)
+		rbuf_[i] += t[i];
+	const size_t m = (M_ > L_ ? M_ - L_ : 0);
+	for (size_t i = 0; i < m; ++i)
+		t[i] = rbuf_[L_ + i] + t[L_ + i];
+	std::copy(rbuf_ + L_ + m, rbuf_ + L_ + M_, t + m);
+}
+
+/*!
+ * @brief Implementation of Overlap-Add convolution of several channels with the same impulse response.
+ * Compared to using one overlap_add object per channel, a single (normalized) impulse response transform
+ * is shared by all the channels, and the transforms of all the channels are computed by a single batched
+ * DFT/IDFT invocation each.
+ * Channel frames are kept in planar layout: the samples of channel c are stored in range [begin(c), end(c)).
+ * @tparam Real real-number type representing input & output signal samples.
+ * @tparam DFT type of DFT algorithm implementation used for frequency-domain filtering, which must support
+ * batched (howmany) transforms.
+ * @see overlap_add
+ */
+template<class Real, template<class, class> class DFT = dsp::dft::fft>
+class multichannel_overlap_add: private noncopyable
+{
+public:
+	typedef Real value_type;
+	typedef std::complex<value_type> complex_type;
+	typedef DFT<value_type, complex_type> transform_type;
+	typedef DFT<complex_type, value_type> inverse_transform_type;
+	typedef typename transform_type::input_allocator real_allocator;
+	typedef dsp::simd::allocator<complex_type> complex_allocator;
+	typedef value_type* iterator;
+	typedef const value_type* const_iterator;
+	typedef complex_type* complex_iterator;
+	typedef const complex_type* const_complex_iterator;
+
+	/*!
+	 * @brief Construct multichannel Overlap-Add algorithm functor with the specified operation frame length,
+	 * number of channels and filter impulse response.
+	 * @param frame_length number of samples in a single operation frame (per channel).
+	 * @param channel_count number of channels processed in each invocation.
+	 * @param ir start of impulse response vector.
+	 * @param ir_length length of impulse response vector.
+	 * @param preserve_ir_length if true, the impulse response is not checked against possible trailing
+	 * 0's, see overlap_add::overlap_add().
+	 * @tparam Sample type convertible to value_type, which represents impulse response vector elements.
+	 */
+	template<class Sample>
+	multichannel_overlap_add(size_t frame_length, size_t channel_count, const Sample* ir, size_t ir_length, bool preserve_ir_length = false);
+
+	//! @brief Free up allocated memory.
+	~multichannel_overlap_add();
+
+	//! @return length of input/output frame of a single channel.
+	size_t frame_length() const {return L_;}
+	//! @return number of processed channels.
+	size_t channel_count() const {return C_;}
+	//! @return length of the impulse response of implemented FIR filter.
+	size_t impulse_response_length() const {return M_;}
+	//! @return transform size (N_)
+	size_t transform_size() const {return N_;}
+
+	//! @return start of the input/output frame of the specified channel.
+	iterator begin(size_t channel) {return rbuf_ + channel * N_;}
+	//! @return end of the input/output frame of the specified channel.
+	iterator end(size_t channel) {return rbuf_ + channel * N_ + L_;}
+	//! @return start of the input/output frame of the specified channel.
+	const_iterator begin(size_t channel) const {return rbuf_ + channel * N_;}
+	//! @return end of the input/output frame of the specified channel.
+	const_iterator end(size_t channel) const {return rbuf_ + channel * N_ + L_;}
+
+	/*!
+	 * @brief Perform filtration of the current input frames of all the channels, represented as samples
+	 * in the ranges [begin(c), end(c)), and store the result in the same sequences.
+	 */
+	void operator()();
+
+	/*!
+	 * @brief Perform filtration of the interleaved (channel-first) input frame and store the result as
+	 * interleaved output frame.
+	 * @param input frame_length() * channel_count() interleaved input samples.
+	 * @param output frame_length() * channel_count() interleaved output samples (may be the same as input).
+	 * @tparam Sample type convertible to/from value_type.
+	 */
+	template<class Sample>
+	void operator()(const Sample* input, Sample* output)
+	{
+		for (size_t c = 0; c < C_; ++c)
+			for (size_t i = 0; i < L_; ++i)
+				rbuf_[c * N_ + i] = input[i * C_ + c];
+		operator()();
+		for (size_t c = 0; c < C_; ++c)
+			for (size_t i = 0; i < L_; ++i)
+				output[i * C_ + c] = static_cast<Sample>(rbuf_[c * N_ + i]);
+	}
+
+	/*!
+	 * @brief Replace filter's impulse response with a new one (of the same or shorter length).
+	 * Must not be called concurrently with operator()() or stage_impulse_response().
+	 * @param ir start of impulse response vector.
+	 * @param ir_length length of impulse response vector.
+	 * @tparam Sample type convertible to value_type, which represents impulse response vector elements.
+	 */
+	template<class Sample>
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+	BOOST_CONCEPT_REQUIRES(((boost::Convertible<Sample, Real>)),(void))
+#else
+	void
+#endif
+	set_impulse_response(const Sample* ir, size_t ir_length)
+	{
+		h_ = spec_.assign(ir, ir_length);
+	}
+
+	/*!
+	 * @brief Prepare new impulse response to be used by all the channels starting with the next frame,
+	 * see overlap_add::stage_impulse_response().
+	 * @note The frame which activates impulse response staged with crossfade is processed channel by channel,
+	 * with two single-sequence IDFTs each, instead of the batched transform.
+	 */
+	template<class Sample>
+	bool stage_impulse_response(const Sample* ir, size_t ir_length, bool crossfade = false)
+	{
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+		BOOST_CONCEPT_ASSERT((boost::Convertible<Sample, Real>));
+#endif
+		return spec_.stage(ir, ir_length, crossfade);
+	}
+
+private:
+	typedef detail::ir_spectrum<Real, DFT> spectrum_type;
+
+	void activate_staged(unsigned state);
+
+	real_allocator ralloc_;
+	complex_allocator calloc_;
+	const size_t L_; 	//!< Frame length.
+	const size_t C_;	//!< Number of channels.
+	const size_t M_;	//!< Impulse response length.
+	const size_t N_;	//!< DFT Transform length (dft::fast_length(L_ + M_)).
+	const size_t K_;	//!< Number of non-redundant DFT bins of real sequence (N_ / 2 + 1).
+	const size_t Kp_;	//!< K_ with SIMD padding included.
+	value_type* rbuf_;		//!< Real-valued buffer (of length C_ * (N_ + M_)), first C_ * N_ samples serve as
+							//!< input buffers for DFT and output buffers for IDFT of consecutive channels,
+							//!< last C_ * M_ samples store overlapping fragments of previous frames.
+	complex_type* cbuf_; 	//!< Complex-valued buffer (of length C_ * Kp_), holds transforms of consecutive channels.
+	spectrum_type spec_;	//!< Double-buffered transform of impulse response.
+	complex_type* h_;		//!< Impulse response transform vector in use (scaled by 1/N_).
+	transform_type dft_;	//!< Batched DFT functor.
+	inverse_transform_type idft_; //!< Batched IDFT functor.
+	inverse_transform_type prev_idft_; //!< Single-sequence IDFT functor used for crossfading, planned for staging buffer 0.
+	inverse_transform_type next_idft_; //!< Single-sequence IDFT functor used for crossfading, planned for staging buffer 1.
+
+public:
+	//! @brief Access/modify impulse response transform \f$H(z)\f$, scaled by the IDFT normalization factor 1/transform_size().
+	//! @note This is rebound to the other buffer when impulse response passed to stage_impulse_response() is activated.
+	ioport_rw<const_complex_iterator, complex_iterator> H;
+};
+
+template<class Real, template<class, class> class DFT> inline
+multichannel_overlap_add<Real, DFT>::~multichannel_overlap_add()
+{
+	calloc_.deallocate(cbuf_, C_ * Kp_);
+	ralloc_.deallocate(rbuf_, C_ * (N_ + M_));
+}
+
+template<class Real, template<class, class> class DFT>
+template<class Sample> inline
+multichannel_overlap_add<Real, DFT>::multichannel_overlap_add(size_t frame_length, size_t channel_count, const Sample* ir, size_t ir_length, bool preserve_ir_length)
+ :	L_(frame_length)
+ ,	C_(channel_count)
+ ,	M_(preserve_ir_length ? ir_length : overlap_add<Real, DFT>::nonzero_length(ir, ir + ir_length))
+ ,	N_(dft::fast_length(L_ + M_))
+ ,	K_(N_ / 2 + 1)
+ ,	Kp_(dsp::simd::aligned_count<complex_type>(K_))
+ ,	rbuf_(ralloc_.allocate(C_ * (N_ + M_)))
+ ,	cbuf_(calloc_.allocate(C_ * Kp_))
+ ,	spec_(N_, M_, 2)
+ ,	h_(spec_.bank(0))
+ ,	dft_(N_, C_, rbuf_, 1, N_, cbuf_, 1, Kp_, dft::sign::forward)
+ ,	idft_(N_, C_, cbuf_, 1, Kp_, rbuf_, 1, N_, dft::sign::backward)
+ ,	prev_idft_(N_, spec_.scratch(), spec_.staging_buffer(0), dft::sign::backward)
+ ,	next_idft_(N_, spec_.scratch(), spec_.staging_buffer(1), dft::sign::backward)
+ ,	H(h_, K_)
+{
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+	BOOST_CONCEPT_ASSERT((boost::Convertible<Sample, Real>));
+#endif
+	std::fill_n(rbuf_, C_ * (N_ + M_), value_type());	// zero the frames and the overlapping regions
+	std::fill_n(cbuf_, C_ * Kp_, complex_type());		// padding isn't touched by DFT but it's multiplied too
+	spec_.assign(ir, M_);
+}
+
+template<class Real, template<class, class> class DFT> inline
+void multichannel_overlap_add<Real, DFT>::activate_staged(unsigned state)
+{
+	complex_type* const h = spec_.bank(~state & spectrum_type::bank_mask);
+	if (state & spectrum_type::crossfade)
+	{
+		// Batched IDFT can't be used, as both outputs of each channel are needed at once. They are obtained
+		// in the staging buffers, each one with single-sequence transform planned for that buffer.
+		complex_type* const c = spec_.scratch();
+		value_type* const prev = spec_.staging_buffer(0);
+		value_type* const next = spec_.staging_buffer(1);
+		for (size_t ch = 0; ch < C_; ++ch)
+		{
+			complex_type* const x = cbuf_ + ch * Kp_;
+			dsp::simd::mul(c, x, h_, Kp_);
+			prev_idft_(c, prev);
+			dsp::simd::mul(c, x, h, Kp_);
+			next_idft_(c, next);
+			detail::crossfade(next, prev, L_);
+			std::copy(next, next + N_, rbuf_ + ch * N_);
+		}
+	}
+	else
+	{
+		for (size_t ch = 0; ch < C_; ++ch)
+			dsp::simd::mul(cbuf_ + ch * Kp_, cbuf_ + ch * Kp_, h, Kp_);
+		idft_(cbuf_, rbuf_);
+	}
+	h_ = spec_.commit(state);
+	H = ioport_rw<const_complex_iterator, complex_iterator>(h_, K_);
+}
+
+template<class Real, template<class, class> class DFT> inline
+void multichannel_overlap_add<Real, DFT>::operator ()()
+{
+	for (size_t c = 0; c < C_; ++c)						// zero-pad the input frames up to N
+		std::fill_n(rbuf_ + c * N_ + L_, N_ - L_, value_type());
+	dft_(rbuf_, cbuf_);									// obtain DFTs of all the frames at once
+	const unsigned state = spec_.poll();
+	if (state & spectrum_type::pending)					// switch to the staged transform, if there's any
+		activate_staged(state);
+	else
+	{
+		for (size_t c = 0; c < C_; ++c)					// multiply each one by the shared, normalized H
+			dsp::simd::mul(cbuf_ + c * Kp_, cbuf_ + c * Kp_, h_, Kp_);
+		idft_(cbuf_, rbuf_);							// perform IDFTs of all the frames at once
+	}
+
+	// Overlap the tails the same way overlap_add::operator()() does, channel by channel.
+	const size_t n = std::min(L_, M_);
+	const size_t m = (M_ > L_ ? M_ - L_ : 0);
+	for (size_t c = 0; c < C_; ++c)
+	{
+		value_type* const r = rbuf_ + c * N_;
+		value_type* const t = rbuf_ + C_ * N_ + c * M_;
+		for (size_t i = 0; i < n; ++i)
+			r[i] += t[i];
+		for (size_t i = 0; i < m; ++i)
+			t[i] = r[L_ + i] + t[L_ + i];
+		std::copy(r + L_ + m, r + L_ + M_, t + m);
+	}
 }
 
 }
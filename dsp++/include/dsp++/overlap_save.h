@@ -12,6 +12,9 @@
 #include <dsp++/pow2.h>
 #include <dsp++/algorithm.h>
 #include <dsp++/noncopyable.h>
+#include <dsp++/ioport.h>
+#include <dsp++/simd.h>
+#include <dsp++/vectmath.h>
 
 #include <algorithm>
 #include <functional>
@@ -38,7 +41,8 @@ public:
 	typedef DFT<value_type, complex_type> transform_type;
 	typedef DFT<complex_type, value_type> inverse_transform_type;
 	typedef typename transform_type::input_allocator real_allocator;
-	typedef typename transform_type::output_allocator complex_allocator;
+	//! @brief Spectra are kept in SIMD-aligned and padded vectors, so that they may be multiplied with dsp::simd::mul().
+	typedef dsp::simd::allocator<complex_type> complex_allocator;
 	typedef value_type* iterator;
 	typedef const value_type* const_iterator;
 	typedef complex_type* complex_iterator;
@@ -176,32 +180,34 @@ private:
 	complex_allocator calloc_;
 	const size_t L_; 	//!< Frame length.
 	const size_t M_;	//!< Impulse response length.
-	const size_t N_;	//!< DFT Transform length (nextpow2(2 * max(L_, M_))).
+	const size_t N_;	//!< DFT Transform length (dft::fast_length(2 * max(L_, M_))).
+	const size_t K_;	//!< Number of non-redundant DFT bins of real sequence (N_ / 2 + 1).
+	const size_t Kp_;	//!< K_ with SIMD padding included.
 	value_type* rbuf_;		//!< Real-valued buffer (of length 2N_ - L_, first N_ samples serve as input buffer
 							//!< for DFT and output buffer for IDFT, last (N_ - L_) samples are used for storing overlapping
 							//!< fragment of previous frame (old x values)
-	complex_type* cbuf_; 	//!< Complex-valued buffer (of length 2 * N_), first N_ samples serve as
-							//!< output buffer for DFT and input buffer for IDFT, last N_ samples
+	complex_type* cbuf_; 	//!< Complex-valued buffer (of length 2 * Kp_), first Kp_ samples serve as
+							//!< output buffer for DFT and input buffer for IDFT, last Kp_ samples
 							//!< are used for storing pre-computed transform of impulse response.
 	transform_type dft_;	//!< DFT functor
 	inverse_transform_type idft_; //!< IDFT functor
 
 	value_type* const x_;
 	value_type* const z_;
-	complex_type* const h_;	//!< Impulse response transform vector.
+	complex_type* const h_;	//!< Impulse response transform vector (scaled by 1/N_).
 
 public:
 	ioport_rw<const_iterator, iterator> x;
 	ioport_ro<const_iterator> y;
-	//! @brief Access/modify impulse response transform \f$H(z)\f$.
+	//! @brief Access/modify impulse response transform \f$H(z)\f$, scaled by the IDFT normalization factor 1/transform_size().
 	ioport_rw<const_complex_iterator, complex_iterator> H;
 };
 
 template<class Real, template<class, class> class DFT> inline
 overlap_save<Real, DFT>::~overlap_save()
 {
-	calloc_.deallocate(cbuf_, 2 * N_);
-	ralloc_.deallocate(rbuf_, N_ + M_);
+	calloc_.deallocate(cbuf_, 2 * Kp_);
+	ralloc_.deallocate(rbuf_, 2 * N_ - L_);
 }
 
 template<class Real, template<class, class> class DFT> inline
@@ -211,7 +217,11 @@ void overlap_save<Real, DFT>::prepare_ir_dft(bool zero_tail)
 		std::fill_n(rbuf_ + M_, N_ - M_, value_type()); 	 // pad impulse response with
 															// 0's up to length N
 	dft_();										// calculate the DFT of impulse response
-	std::copy(cbuf_, cbuf_ + N_, h_);			// copy calculated transform to the destination
+	const value_type scale = value_type(1) / static_cast<value_type>(N_);
+	for (size_t k = 0; k < K_; ++k)				// copy calculated transform to the destination, folding
+		h_[k] = cbuf_[k] * scale;				// IDFT normalization into it
+	std::fill(cbuf_ + K_, cbuf_ + Kp_, complex_type());	// padding isn't touched by DFT but it's multiplied too
+	std::fill(h_ + K_, h_ + Kp_, complex_type());
 }
 
 template<class Real, template<class, class> class DFT>
@@ -219,17 +229,19 @@ template<class Iterator> inline
 overlap_save<Real, DFT>::overlap_save(size_t frame_length, Iterator ir_begin, Iterator ir_end, bool preserve_ir_length)
  :	L_(frame_length)
  , 	M_(preserve_ir_length ? std::distance(ir_begin, ir_end) : nonzero_length(ir_begin, ir_end))	// find real length of the impulse response
- ,	N_(nextpow2(2 * std::max(L_, M_)))				// calculate transform size
+ ,	N_(dft::fast_length(2 * std::max(L_, M_)))				// calculate transform size
+ ,	K_(N_ / 2 + 1)							// only half of the spectrum of real sequence is needed
+ ,	Kp_(dsp::simd::aligned_count<complex_type>(K_))
  , 	rbuf_(ralloc_.allocate(2 * N_ - L_))	// don't even bother with calling construct() on these, they are just numbers
- , 	cbuf_(calloc_.allocate(2 * N_))
+ , 	cbuf_(calloc_.allocate(2 * Kp_))
  ,	dft_(N_, rbuf_, cbuf_)
  , 	idft_(N_, cbuf_, rbuf_)
  ,	x_(rbuf_ + N_ - L_)
  ,	z_(x_ + L_)
- ,	h_(cbuf_ + N_)
+ ,	h_(cbuf_ + Kp_)
  ,	x(x_, z_)
  ,	y(x_, z_)
- ,	H(h_, N_)
+ ,	H(h_, K_)
 {
 #if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
 	BOOST_CONCEPT_ASSERT((boost::BidirectionalIterator<Iterator>));
@@ -244,17 +256,19 @@ template<class Sample> inline
 overlap_save<Real, DFT>::overlap_save(size_t frame_length, const Sample* ir, size_t ir_length, bool preserve_ir_length)
  :	L_(frame_length)
  ,	M_(preserve_ir_length ? ir_length : nonzero_length(ir, ir + ir_length))
- ,	N_(nextpow2(2 * std::max(L_, M_)))				// calculate transform size
+ ,	N_(dft::fast_length(2 * std::max(L_, M_)))				// calculate transform size
+ ,	K_(N_ / 2 + 1)							// only half of the spectrum of real sequence is needed
+ ,	Kp_(dsp::simd::aligned_count<complex_type>(K_))
  , 	rbuf_(ralloc_.allocate(2 * N_ - L_))	// don't even bother with calling construct() on these, they are just numbers
- , 	cbuf_(calloc_.allocate(2 * N_))
+ , 	cbuf_(calloc_.allocate(2 * Kp_))
  ,	dft_(N_, rbuf_, cbuf_)
  , 	idft_(N_, cbuf_, rbuf_)
  ,	x_(rbuf_ + N_ - L_)
  ,	z_(x_ + L_)
- ,	h_(cbuf_ + N_)
+ ,	h_(cbuf_ + Kp_)
  ,	x(x_, z_)
  ,	y(x_, z_)
- ,	H(h_, N_)
+ ,	H(h_, K_)
 {
 #if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
 	BOOST_CONCEPT_ASSERT((boost::Convertible<Sample, Real>));
@@ -270,10 +284,8 @@ void overlap_save<Real, DFT>::operator ()()
 	std::copy_n(z_, N_ - L_, rbuf_);				// fill DFT input vector with N - L samples from previous frames
 	std::copy_n(rbuf_ + L_, N_ - L_, z_);		// save last N - L samples (including input frame) to "save" buffer 
 	dft_(rbuf_, cbuf_);									// obtain DFT of the joint previous and current frame
-	std::transform(cbuf_, h_, h_, cbuf_, std::multiplies<complex_type>()); // multiply the transforms
+	dsp::simd::mul(cbuf_, cbuf_, h_, Kp_);				// multiply the transforms, H is already normalized by 1/N
 	idft_(cbuf_, rbuf_);								// perform IDFT
-	std::transform(rbuf_, rbuf_ + N_, rbuf_, std::bind2nd(std::divides<value_type>(), static_cast<value_type>(N_)));
-														// normalize the IDFT by a factor of 1/N
 	// output values are now in x_
 }
 
@@ -0,0 +1,426 @@
+/*!
+ * @file dsp++/partitioned_convolution.h
+ * @brief Definition of partitioned_convolution and nonuniform_partitioned_convolution class templates.
+ */
+#ifndef DSP_PARTITIONED_CONVOLUTION_H_INCLUDED
+#define DSP_PARTITIONED_CONVOLUTION_H_INCLUDED
+#pragma once
+
+#include <dsp++/config.h>
+#include <dsp++/fft.h>
+#include <dsp++/pow2.h>
+#include <dsp++/noncopyable.h>
+#include <dsp++/ioport.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+#include <boost/concept/requires.hpp>
+#include <boost/concept_check.hpp>
+#endif // !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+
+namespace dsp {
+
+/*!
+ * @brief Implementation of uniformly-partitioned Overlap-Save convolution (FIR filtering via frequency-domain
+ * multiplication) with a frequency-domain delay line.
+ * The impulse response is split into P partitions of frame_length() samples, each transformed with the same
+ * transform_size() (dft::fast_length(2 * frame_length())) DFT. For each input frame only a single forward and
+ * a single inverse DFT of that size is performed and the partitions are applied by multiplying their transforms
+ * with the transforms of P most recent input frames, so the cost per frame grows linearly with the impulse
+ * response length instead of requiring a transform longer than the whole impulse response as overlap_add does.
+ * The latency is a single frame, the same as for overlap_add with the same frame length.
+ * @tparam Real real-number type representing input & output signal samples.
+ * @tparam DFT type of DFT algorithm implementation used for frequency-domain filtering.
+ * @see http://en.wikipedia.org/wiki/Overlap%E2%80%93save_method
+ */
+template<class Real, template<class, class> class DFT = dsp::dft::fft>
+class partitioned_convolution: private noncopyable
+{
+public:
+	typedef Real value_type;
+	typedef std::complex<value_type> complex_type;
+	typedef DFT<value_type, complex_type> transform_type;
+	typedef DFT<complex_type, value_type> inverse_transform_type;
+	typedef typename transform_type::input_allocator real_allocator;
+	typedef typename transform_type::output_allocator complex_allocator;
+	typedef value_type* iterator;
+	typedef const value_type* const_iterator;
+	typedef complex_type* complex_iterator;
+	typedef const complex_type* const_complex_iterator;
+
+	/*!
+	 * @brief Construct uniformly-partitioned convolution functor with the specified operation frame length
+	 * and filter impulse response.
+	 * @param frame_length number of samples in a single operation frame (also the length of each partition).
+	 * @param ir_begin start iterator of impulse response sequence.
+	 * @param ir_end end iterator of impulse response sequence.
+	 * @tparam Iterator type of the iterator used for passing the impulse response sequence
+	 * (which must conform to forward iterator concept).
+	 */
+	template<class Iterator>
+	partitioned_convolution(size_t frame_length, Iterator ir_begin, Iterator ir_end);
+	/*!
+	 * @brief Construct uniformly-partitioned convolution functor with the specified operation frame length
+	 * and filter impulse response.
+	 * @param frame_length number of samples in a single operation frame (also the length of each partition).
+	 * @param ir start of impulse response vector.
+	 * @param ir_length length of impulse response vector.
+	 * @tparam Sample type convertible to value_type, which represents impulse response vector elements.
+	 */
+	template<class Sample>
+	partitioned_convolution(size_t frame_length, const Sample* ir, size_t ir_length);
+
+	//! @brief Free up allocated memory.
+	~partitioned_convolution();
+
+	//! @return length of input/output frame
+	size_t frame_length() const {return L_;}
+	//! @return length of the impulse response of implemented FIR filter.
+	size_t impulse_response_length() const {return M_;}
+	//! @return transform size (N_)
+	size_t transform_size() const {return N_;}
+	//! @return number of impulse response partitions (P_)
+	size_t partition_count() const {return P_;}
+
+	/*!
+	 * @brief Perform filtration of the current input frame, represented as samples in the range [x.begin(), x.end()),
+	 * and store the result in the same sequence.
+	 */
+	void operator()();
+
+	/*!
+	 * @brief Replace filter's impulse response with a new one (of the same or shorter length).
+	 * Contrary to overlap_add, the current frame and the filter state are preserved.
+	 * @param begin start of new impulse response samples sequence.
+	 * @param end end of new impulse response samples sequence.
+	 * @tparam Iterator type of the iterator used for passing the impulse response sequence
+	 * (which must conform to input iterator concept).
+	 */
+	template<class Iterator>
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+	BOOST_CONCEPT_REQUIRES(((boost::InputIterator<Iterator>)),(void))
+#else
+	void
+#endif
+	set_impulse_response(Iterator begin, Iterator end)
+	{
+		value_type* const h = rbuf_ + N_;
+		for (size_t p = 0; p < P_; ++p) {
+			size_t n = 0;
+			for (; n < L_ && begin != end; ++n, ++begin)
+				h[n] = static_cast<value_type>(*begin);
+			prepare_partition_dft(p, n);
+		}
+	}
+
+	/*!
+	 * @brief Replace filter's impulse response with a new one (of the same or shorter length).
+	 * Contrary to overlap_add, the current frame and the filter state are preserved.
+	 * @param ir start of impulse response vector.
+	 * @param ir_length length of impulse response vector.
+	 * @tparam Sample type convertible to value_type, which represents impulse response vector elements.
+	 */
+	template<class Sample>
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+	BOOST_CONCEPT_REQUIRES(((boost::Convertible<Sample, Real>)),(void))
+#else
+	void
+#endif
+	set_impulse_response(const Sample* ir, size_t ir_length)
+	{
+		set_impulse_response(ir, ir + std::min(M_, ir_length));
+	}
+
+private:
+	/*!
+	 * @brief Calculate the transform of partition p from n samples stored in rbuf_ + N_, with the IDFT
+	 * normalization factor 1/N folded in, so that it doesn't need to be applied to each output frame.
+	 */
+	void prepare_partition_dft(size_t p, size_t n);
+
+	real_allocator ralloc_;
+	complex_allocator calloc_;
+	const size_t L_; 	//!< Frame (and partition) length.
+	const size_t M_;	//!< Impulse response length.
+	const size_t N_;	//!< DFT Transform length (dft::fast_length(2 * L_)).
+	const size_t K_;	//!< Number of non-redundant DFT bins of real sequence (N_ / 2 + 1).
+	const size_t P_;	//!< Number of impulse response partitions (ceil(M_ / L_)).
+	value_type* rbuf_;		//!< Real-valued buffer (of length 2 * N_), first N_ samples are the sliding window of
+							//!< input samples (with the current frame at the end), the other N_ are the output of IDFT.
+	complex_type* cbuf_; 	//!< Complex-valued buffer (of length (2 * P_ + 1) * K_), holding P_ transforms of
+							//!< impulse response partitions, followed by frequency-domain delay line of P_ transforms
+							//!< of past input windows and accumulator of their products.
+	complex_type* const h_;		//!< Impulse response partitions transforms (P_ * K_).
+	complex_type* const fdl_;	//!< Frequency-domain delay line (P_ * K_).
+	complex_type* const acc_;	//!< Accumulator of the products (K_).
+	size_t pos_;				//!< Index of the most recent input transform in fdl_.
+	transform_type dft_;	//!< DFT functor
+	inverse_transform_type idft_; //!< IDFT functor
+	value_type* const x_;
+
+public:
+	ioport_rw<const_iterator, iterator> x;
+	ioport_ro<const_iterator> y;
+
+	//! @brief Access/modify impulse response partitions transforms \f$H_p(z)\f$ (P_ consecutive vectors of K_ bins, scaled by 1/N_).
+	ioport_rw<const_complex_iterator, complex_iterator> H;
+};
+
+template<class Real, template<class, class> class DFT> inline
+partitioned_convolution<Real, DFT>::~partitioned_convolution()
+{
+	calloc_.deallocate(cbuf_, (2 * P_ + 1) * K_);
+	ralloc_.deallocate(rbuf_, 2 * N_);
+}
+
+template<class Real, template<class, class> class DFT> inline
+void partitioned_convolution<Real, DFT>::prepare_partition_dft(size_t p, size_t n)
+{
+	value_type* const h = rbuf_ + N_;
+	complex_type* const H = h_ + p * K_;
+	std::fill_n(h + n, N_ - n, value_type());
+	dft_(h, H);
+	const value_type scale = value_type(1) / static_cast<value_type>(N_);
+	for (size_t k = 0; k < K_; ++k)
+		H[k] *= scale;
+}
+
+template<class Real, template<class, class> class DFT>
+template<class Iterator> inline
+partitioned_convolution<Real, DFT>::partitioned_convolution(size_t frame_length, Iterator ir_begin, Iterator ir_end)
+ :	L_(frame_length)
+ ,	M_(std::distance(ir_begin, ir_end))
+ ,	N_(dft::fast_length(2 * L_))
+ ,	K_(N_ / 2 + 1)
+ ,	P_(std::max<size_t>(1, (M_ + L_ - 1) / L_))
+ , 	rbuf_(ralloc_.allocate(2 * N_))
+ , 	cbuf_(calloc_.allocate((2 * P_ + 1) * K_))
+ ,	h_(cbuf_)
+ ,	fdl_(h_ + P_ * K_)
+ ,	acc_(fdl_ + P_ * K_)
+ ,	pos_(0)
+ ,	dft_(N_, rbuf_, cbuf_)
+ , 	idft_(N_, cbuf_, rbuf_)
+ ,	x_(rbuf_ + N_ - L_)
+ ,	x(x_, L_)
+ ,	y(x_, L_)
+ ,	H(h_, P_ * K_)
+{
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+	BOOST_CONCEPT_ASSERT((boost::ForwardIterator<Iterator>));
+#endif
+	std::fill_n(rbuf_, N_, value_type());
+	std::fill_n(fdl_, P_ * K_, complex_type());
+	set_impulse_response(ir_begin, ir_end);
+}
+
+template<class Real, template<class, class> class DFT>
+template<class Sample> inline
+partitioned_convolution<Real, DFT>::partitioned_convolution(size_t frame_length, const Sample* ir, size_t ir_length)
+ :	L_(frame_length)
+ ,	M_(ir_length)
+ ,	N_(dft::fast_length(2 * L_))
+ ,	K_(N_ / 2 + 1)
+ ,	P_(std::max<size_t>(1, (M_ + L_ - 1) / L_))
+ , 	rbuf_(ralloc_.allocate(2 * N_))
+ , 	cbuf_(calloc_.allocate((2 * P_ + 1) * K_))
+ ,	h_(cbuf_)
+ ,	fdl_(h_ + P_ * K_)
+ ,	acc_(fdl_ + P_ * K_)
+ ,	pos_(0)
+ ,	dft_(N_, rbuf_, cbuf_)
+ , 	idft_(N_, cbuf_, rbuf_)
+ ,	x_(rbuf_ + N_ - L_)
+ ,	x(x_, L_)
+ ,	y(x_, L_)
+ ,	H(h_, P_ * K_)
+{
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+	BOOST_CONCEPT_ASSERT((boost::Convertible<Sample, Real>));
+#endif
+	std::fill_n(rbuf_, N_, value_type());
+	std::fill_n(fdl_, P_ * K_, complex_type());
+	set_impulse_response(ir, ir + M_);
+}
+
+template<class Real, template<class, class> class DFT> inline
+void partitioned_convolution<Real, DFT>::operator ()()
+{
+	dft_(rbuf_, fdl_ + pos_ * K_);						// transform the window ending with the current frame
+	std::fill_n(acc_, K_, complex_type());
+	// H_p is applied to the transform of the window which is p frames old, that is fdl_[pos_ - p] (mod P_)
+	const complex_type* h = h_;
+	for (size_t p = 0; p < P_; ++p, h += K_) {
+		const complex_type* X = fdl_ + ((pos_ + P_ - p) % P_) * K_;
+		for (size_t k = 0; k < K_; ++k)
+			acc_[k] += X[k] * h[k];
+	}
+	idft_(acc_, rbuf_ + N_);							// perform IDFT, 1/N is already applied to H
+	std::copy(rbuf_ + L_, rbuf_ + N_, rbuf_);			// slide the window to make room for the next frame
+	std::copy(rbuf_ + 2 * N_ - L_, rbuf_ + 2 * N_, x_);	// last L samples of circular convolution are the output
+	pos_ = (pos_ + 1) % P_;
+}
+
+/*!
+ * @brief Implementation of non-uniformly partitioned convolution, combining low latency of short partitions at
+ * the head of the impulse response with efficiency of long partitions at its tail.
+ * The impulse response is split into segments, each realized by partitioned_convolution with partitions 4 times
+ * longer than the previous segment (up to max_partition_length), starting with frame_length() partitions. Each
+ * segment contains 4 partitions, except for the last one, which covers the rest of the impulse response. Segment
+ * with partitions of length B processes the input every B / frame_length() frames, and the results are summed in
+ * a delay line so that the output is the same as of partitioned_convolution of the whole impulse response (latency
+ * is a single frame), at the fraction of its cost for long impulse responses.
+ *
+ * The work isn't spread evenly across frames: a segment with partitions of length B does all of its work (a
+ * forward and an inverse DFT of length dft::fast_length(2 * B) and one complex multiply-add of about B + 1 bins
+ * per partition of the segment) in the single frame which completes its partition, i.e. once every
+ * B / frame_length() frames.
+ * The worst-case cost of a single call is therefore the sum of these costs over all the segments, reached every
+ * partition_length(segment_count() - 1) / frame_length() frames, when all the partitions complete at once. That
+ * call is dominated by the longest segment, whose work grows with max_partition_length, so a caller with a hard
+ * per-frame deadline should budget for it (or lower max_partition_length), not for the average cost per frame.
+ * @tparam Real real-number type representing input & output signal samples.
+ * @tparam DFT type of DFT algorithm implementation used for frequency-domain filtering.
+ */
+template<class Real, template<class, class> class DFT = dsp::dft::fft>
+class nonuniform_partitioned_convolution: private noncopyable
+{
+public:
+	typedef Real value_type;
+	typedef partitioned_convolution<Real, DFT> segment_type;
+	typedef std::allocator<value_type> allocator_type;
+	typedef value_type* iterator;
+	typedef const value_type* const_iterator;
+
+	/*!
+	 * @brief Construct non-uniformly partitioned convolution functor with the specified operation frame length
+	 * and filter impulse response.
+	 * @param frame_length number of samples in a single operation frame (also the length of the shortest partitions).
+	 * @param ir start of impulse response vector.
+	 * @param ir_length length of impulse response vector.
+	 * @param max_partition_length maximum length of partition, rounded down to frame_length() times power of 4;
+	 * 0 selects 64 * frame_length().
+	 * @tparam Sample type convertible to value_type, which represents impulse response vector elements.
+	 */
+	template<class Sample>
+	nonuniform_partitioned_convolution(size_t frame_length, const Sample* ir, size_t ir_length, size_t max_partition_length = 0);
+
+	//! @brief Free up allocated memory.
+	~nonuniform_partitioned_convolution();
+
+	//! @return length of input/output frame
+	size_t frame_length() const {return L_;}
+	//! @return length of the impulse response of implemented FIR filter.
+	size_t impulse_response_length() const {return M_;}
+	//! @return number of segments with partitions of the same length.
+	size_t segment_count() const {return segments_.size();}
+	//! @return length of partitions in segment i.
+	size_t partition_length(size_t i) const {return segments_[i].length;}
+
+	/*!
+	 * @brief Perform filtration of the current input frame, represented as samples in the range [x.begin(), x.end()),
+	 * and store the result in the same sequence.
+	 */
+	void operator()();
+
+private:
+	struct segment
+	{
+		boost::shared_ptr<segment_type> conv;
+		size_t length;	//!< Partition length.
+		size_t offset;	//!< Position of the segment output relative to the current frame in the delay line.
+	};
+
+	allocator_type alloc_;
+	const size_t L_; 	//!< Frame length.
+	const size_t M_;	//!< Impulse response length.
+	const size_t D_;	//!< Length of the output delay line (nextpow2(M_ + L_)).
+	value_type* buf_;	//!< Current frame (L_) followed by output delay line (D_).
+	value_type* const x_;
+	value_type* const d_;
+	size_t pos_;		//!< Position of the current frame in the delay line.
+	size_t frame_;		//!< Number of processed frames.
+	std::vector<segment> segments_;
+
+public:
+	ioport_rw<const_iterator, iterator> x;
+	ioport_ro<const_iterator> y;
+};
+
+template<class Real, template<class, class> class DFT> inline
+nonuniform_partitioned_convolution<Real, DFT>::~nonuniform_partitioned_convolution()
+{
+	alloc_.deallocate(buf_, L_ + D_);
+}
+
+template<class Real, template<class, class> class DFT>
+template<class Sample> inline
+nonuniform_partitioned_convolution<Real, DFT>::nonuniform_partitioned_convolution(size_t frame_length, const Sample* ir, size_t ir_length, size_t max_partition_length)
+ :	L_(frame_length)
+ ,	M_(ir_length)
+ ,	D_(nextpow2(M_ + L_))
+ ,	buf_(alloc_.allocate(L_ + D_))
+ ,	x_(buf_)
+ ,	d_(buf_ + L_)
+ ,	pos_(0)
+ ,	frame_(0)
+ ,	x(x_, L_)
+ ,	y(x_, L_)
+{
+#if !DSP_BOOST_CONCEPT_CHECKS_DISABLED
+	BOOST_CONCEPT_ASSERT((boost::Convertible<Sample, Real>));
+#endif
+	if (0 == max_partition_length)
+		max_partition_length = 64 * L_;
+	size_t start = 0, B = L_;
+	do {
+		// segment with partitions of length B delivers its output B samples after the first input sample of the
+		// partition, so it may only cover the impulse response from B - L_ onwards; 4 partitions of each length
+		// before moving to the next one satisfy that for all the segments
+		size_t len = M_ - start;
+		const bool last = (len <= 4 * B || 4 * B > max_partition_length);
+		if (!last)
+			len = 4 * B;
+		segment s;
+		s.conv.reset(new segment_type(B, ir + start, len));
+		s.length = B;
+		s.offset = start + L_ - B;
+		segments_.push_back(s);
+		start += len;
+		B *= 4;
+	} while (start < M_);
+	std::fill_n(buf_, L_ + D_, value_type());
+}
+
+template<class Real, template<class, class> class DFT> inline
+void nonuniform_partitioned_convolution<Real, DFT>::operator ()()
+{
+	const size_t mask = D_ - 1;
+	for (typename std::vector<segment>::iterator s = segments_.begin(); s != segments_.end(); ++s) {
+		// gather frames until the partition is complete
+		const size_t n = s->length / L_, phase = frame_ % n;
+		std::copy(x_, x_ + L_, s->conv->x.begin() + phase * L_);
+		if (n - 1 != phase)
+			continue;
+
+		(*s->conv)();
+		const value_type* y = s->conv->y.begin();
+		for (size_t i = 0, j = pos_ + s->offset; i < s->length; ++i, ++j)
+			d_[j & mask] += y[i];
+	}
+	for (size_t i = 0, j = pos_; i < L_; ++i, ++j) {
+		x_[i] = d_[j & mask];
+		d_[j & mask] = value_type();
+	}
+	pos_ = (pos_ + L_) & mask;
+	++frame_;
+}
+
+}
+
+#endif /* DSP_PARTITIONED_CONVOLUTION_H_INCLUDED */
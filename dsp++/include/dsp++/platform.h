@@ -31,6 +31,9 @@
 # define DSP_ARCH_X86_64
 # define DSP_ARCH_FAMILY_X86
 # define DSP_ENDIAN_LITTLE
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DSP_ARCH_ARM64
+#define DSP_ARCH_FAMILY_ARM
 #elif defined(__arm__) || defined(_M_ARM)
 #define DSP_ARCH_ARM
 #define DSP_ARCH_FAMILY_ARM
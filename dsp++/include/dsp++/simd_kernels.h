@@ -0,0 +1,84 @@
+/*!
+ * @file dsp++/simd_kernels.h
+ * @brief Registry of SIMD kernels backing dsp::simd vector math and filtering functions and dsp::dft::fft stages.
+ */
+#ifndef DSP_SIMD_KERNELS_H_INCLUDED
+#define DSP_SIMD_KERNELS_H_INCLUDED
+#pragma once
+
+#include <dsp++/config.h>
+#include <dsp++/export.h>
+
+#include <complex>			// for std::complex
+#include <cstddef>			// for size_t
+
+namespace dsp { namespace simd {
+
+/*!
+ * @brief Table of pointers to the implementations of dsp::simd vector math and filtering functions, and of
+ * the butterfly stages of dsp::dft::fft. The table used by these functions is resolved once, when the library is loaded, according to
+ * {@link features()} (or DSP_SIMD_FEATURES if it is overridden at compile time), so that the calls
+ * don't need to test feature flags anymore.
+ */
+struct kernel_table
+{
+	unsigned feat_flags;	//!< Combination of {@link feat} flags this table was resolved for.
+
+	void (*mul)(float* res, const float* a, const float* b, size_t len);
+	void (*mul_scalar)(float* res, const float* a, float s, size_t len);
+	void (*mul_complex)(std::complex<float>* res, const std::complex<float>* a, const std::complex<float>* b, size_t len);
+	void (*div)(float* res, const float* a, const float* b, size_t len);
+	void (*div_scalar)(float* res, const float* a, float s, size_t len);
+	void (*add)(float* res, const float* a, const float* b, size_t len);
+	void (*add_scalar)(float* res, const float* a, float s, size_t len);
+	void (*sub)(float* res, const float* a, const float* b, size_t len);
+	void (*sub_scalar)(float* res, const float* a, float s, size_t len);
+	float (*dot)(const float* a, const float* b, size_t len);
+	std::complex<float> (*dot_complex)(const std::complex<float>* a, const std::complex<float>* b, size_t len);
+	void (*sqrt)(float* res, const float* a, size_t len);
+	void (*recip)(float* res, const float* a, size_t len);
+	void (*rsqrt)(float* res, const float* a, size_t len);
+	void (*log2)(float* res, const float* a, size_t len);
+	void (*exp2)(float* res, const float* a, size_t len);
+	float (*filter_sample_df2)(float* w, const float* b, size_t M, const float* a, size_t N);
+	float (*filter_sample_tdf2)(float x, float* s, const float* b, size_t M, const float* a, size_t N);
+	float (*filter_sample_sos_df2)(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step);
+	void (*filter_block_fir)(float* y, const float* x, size_t L, const float* b, size_t M);
+	void (*filter_block_biquad)(float* x, size_t L, float* s, const float* m);
+	void (*filter_sos_lanes)(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s);
+	//! Radix-2 (radix-4) decimation-in-time stage of dsp::dft::fft, combining count pairs (quads) of m-point DFTs
+	//! stored contiguously in x, using twiddle factors w of the stage. Vectorized kernels fall back to narrower ones
+	//! (or the generic one) if m isn't a multiple of the number of butterflies they process at a time.
+	void (*fft_radix2)(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+	void (*fft_radix4)(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+	void (*fft_radix2d)(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+	void (*fft_radix4d)(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+};
+
+/*!
+ * @brief Build a table with the best kernels available for given combination of {@link feat} flags.
+ * @param feat_flags instruction sets the kernels may use, pass 0 to get the generic (non-SIMD) implementations.
+ * @note The flags are not validated against {@link features()}, calling kernels which use instruction set
+ * unsupported by the processor results in undefined behavior.
+ */
+DSPXX_API kernel_table resolve_kernels(unsigned feat_flags);
+
+//! @brief Kernel table currently used by dsp::simd functions.
+DSPXX_API const kernel_table& kernels();
+
+/*!
+ * @brief Replace the kernel table used by dsp::simd functions, e.g. to force specific instruction set in benchmarks:
+ * @code
+ * dsp::simd::set_kernels(dsp::simd::resolve_kernels(dsp::simd::feat::x86_sse));
+ * @endcode
+ * @note Switching the table is not synchronized with dsp::simd calls made concurrently by other threads,
+ * so it should be done before the processing starts.
+ */
+DSPXX_API void set_kernels(const kernel_table& table);
+
+//! @brief Restore the kernel table resolved at load time (for DSP_SIMD_FEATURES).
+DSPXX_API void reset_kernels();
+
+} }
+
+#endif /* DSP_SIMD_KERNELS_H_INCLUDED */
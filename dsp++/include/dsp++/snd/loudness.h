@@ -76,32 +76,25 @@ public:
 	//! @param[in] L block length.
 	//! @param[in] sr sampling rate.
 	explicit block_k_weighting(size_t L, double sr)
-	 :	flt1_(L, 3, 3)
-	 ,	flt2_(L, 3, 3)
+	 :	flt_(L, 2)
 	{
 		double num[2][dsp::sos_length];
 		double den[2][dsp::sos_length];
 		k_weighting_sos_design(sr, num, den);
-		flt1_.set(num[0], 3, den[0], 3);
-		flt2_.set(num[1], 3, den[1], 3);
+		flt_.set(&num[0][0], &den[0][0]);
 	}
 
 	//! @brief Perform K-weighting filtering
-	void operator()() {
-		flt1_();
-		std::copy(flt1_.begin(), flt1_.end(), flt2_.begin());
-		flt2_();
-	}
+	void operator()() {flt_();}
 
-	Sample* input_begin() {return flt1_.begin();}
-	Sample* input_end() {return flt1_.end();}
+	Sample* input_begin() {return flt_.x.begin();}
+	Sample* input_end() {return flt_.x.end();}
 
-	const Sample* output_begin() const {return flt2_.begin();}
-	const Sample* output_end() const {return flt2_.end();}
+	const Sample* output_begin() const {return flt_.y.begin();}
+	const Sample* output_end() const {return flt_.y.end();}
 
 private:
-	dsp::block_filter<Sample> flt1_;
-	dsp::block_filter<Sample> flt2_;
+	dsp::block_filter_sos<Sample> flt_;
 };
 
 /*!
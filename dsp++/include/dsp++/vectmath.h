@@ -2,13 +2,17 @@
  * @file dsp++/vectmath.h
  * @brief Basic vector mathematical operations, with some optimizations if possible.
  */
+#ifndef DSP_VECTMATH_H_INCLUDED
+#define DSP_VECTMATH_H_INCLUDED
+#pragma once
 
 #include <dsp++/config.h>
 #include <dsp++/export.h>
 
 #include <complex>			// for std::complex
 #include <cstddef>			// for size_t
-#include <cmath>			// for std::sqrt()
+#include <cmath>			// for std::sqrt(), std::log(), std::pow()
+#include <limits>			// for std::numeric_limits
 
 namespace dsp { 
 
@@ -71,6 +75,27 @@ namespace dsp {
 
 		DSPXX_API void rsqrt(float* res, const float* a, size_t len);
 
+		/*!
+		 * @brief Base-2 logarithm of vector elements.
+		 * @param [out] res output vector (SIMD-aligned and padded) (len).
+		 * @param [in] a input vector of positive values (SIMD-aligned and padded) (len).
+		 * @param [in] len length of vectors.
+		 * @note SIMD kernels use polynomial approximation accurate to 1 ulp for normalized arguments;
+		 * non-positive and denormal arguments are clamped to the smallest normalized float (by all kernels,
+		 * the generic one included).
+		 */
+		DSPXX_API void log2(float* res, const float* a, size_t len);
+
+		/*!
+		 * @brief Base-2 exponential (@f$2^a@f$) of vector elements.
+		 * @param [out] res output vector (SIMD-aligned and padded) (len).
+		 * @param [in] a input vector (SIMD-aligned and padded) (len).
+		 * @param [in] len length of vectors.
+		 * @note SIMD kernels use polynomial approximation accurate to 1 ulp; the arguments are clamped
+		 * to [-126, 127] so that the result is always a normalized float.
+		 */
+		DSPXX_API void exp2(float* res, const float* a, size_t len);
+
 		// TODO implement other interesting SIMD-accelerated vector ops
 	}
 
@@ -196,4 +221,47 @@ namespace dsp {
 			*res = 1 / sqrt(*a);
 	}
 
-} 
+	/*!@brief Naïve implementation of base-2 logarithm of vector elements.
+	 * @param[out] res vector result (len).
+	 * @param[in] a vector operand (len).
+	 * @param len length of operands.
+	 * @note Like the SIMD kernels, non-positive, denormal and NaN arguments are clamped to the smallest normalized
+	 * value of T, so the result is finite and doesn't depend on the kernel selected.
+	 */
+	template<class T>
+	inline void log2(T* res, const T* a, size_t len)
+	{
+		using std::log;
+		const T log2e = T(1.44269504088896340736);
+		const T min_norm = std::numeric_limits<T>::min();
+		for (size_t i = 0; i < len; ++i, ++res, ++a)
+			*res = log(*a > min_norm ? *a : min_norm) * log2e;
+	}
+
+	/*!@brief Naïve implementation of base-2 exponential of vector elements (@f$2^x@f$).
+	 * @param[out] res vector result (len).
+	 * @param[in] a vector operand (len).
+	 * @param len length of operands.
+	 */
+	template<class T>
+	inline void exp2(T* res, const T* a, size_t len)
+	{
+		using std::pow;
+		for (size_t i = 0; i < len; ++i, ++res, ++a)
+			*res = pow(T(2), *a);
+	}
+
+	namespace simd {
+
+		/*!
+		 * @brief Piecewise multiplication of vectors of types for which there's no SIMD implementation, so that
+		 * templates may use dsp::simd::mul() regardless of the sample type.
+		 */
+		template<class T>
+		inline void mul(T* res, const T* a, const T* b, size_t len) {dsp::mul(res, a, b, len);}
+
+	}
+
+}
+
+#endif /* DSP_VECTMATH_H_INCLUDED */
@@ -112,9 +112,10 @@ public:
 private:
 	size_t M_; 			//!< length of input sequence x, must be > 0
 	size_t L_;			//!< length of input sequence y (if 0 this is autocorrelation).
-	size_t N_;			//!< transform length (nextpow2(max(M_, L_) * 2 - 1));
+	size_t N_;			//!< transform length (dft::fast_length(max(M_, L_) * 2 - 1));
+	size_t K_;			//!< number of non-redundant transform bins (N_ / 2 + 1 for real Sample type, N_ for complex one)
 	sample_buffer_t x_;	//!< input/output buffer (2 * N_ if crosscorrelation, N_ + M - 1 if autocorrelation)
-	complex_buffer_t X_;	//!< intermediate DFT buffer (2 * N_ if crosscorrelation, N_ if autocorrelation)
+	complex_buffer_t X_;	//!< intermediate DFT buffer (2 * K_ if crosscorrelation, K_ if autocorrelation)
 	dft_t dft_;
 	idft_t idft_;
 
@@ -151,17 +152,17 @@ private:
 			}
 
 			std::fill_n(yy + L_, N_ - L_, zero);
-			dft_(yy, X_.get() + N_);
+			dft_(yy, X_.get() + K_);
 			complex_t* X = X_.get();
-			complex_t* Y = X + N_;
-			for (size_t i = 0; i < N_; ++i, ++X, ++Y) 
+			complex_t* Y = X + K_;
+			for (size_t i = 0; i < K_; ++i, ++X, ++Y) 
 				*X *= std::conj(*Y);
 		}
 		else
 		{
 			// this is autocorrelation case, DFT of single vector is enough
 			complex_t* X = X_.get();
-			for (size_t i = 0; i < N_; ++i, ++X) 
+			for (size_t i = 0; i < K_; ++i, ++X) 
 				*X = pow(abs(*X), 2);
 		}
 
@@ -238,9 +239,10 @@ template<class Sample, template <class, class> class DFT> inline
 xcorr<Sample, DFT>::xcorr(size_t M, size_t L)
  :	M_(verify_input_length(M))
  ,	L_(L)
- ,	N_(dsp::nextpow2(std::max(M_, L_) * 2 - 1))
+ ,	N_(dsp::dft::fast_length(std::max(M_, L_) * 2 - 1))
+ ,	K_(dsp::is_complex<Sample>::value ? N_ : N_ / 2 + 1)
  ,	x_(L_ == 0 ? N_ + M_ - 1 : 2 * N_)
- ,	X_(L_ == 0 ? N_ : 2 * N_)
+ ,	X_(L_ == 0 ? K_ : 2 * K_)
  ,	dft_(N_, x_.get(), X_.get(), dsp::dft::sign::forward)
  ,	idft_(N_, X_.get(), x_.get(), dsp::dft::sign::backward)
 {
@@ -251,8 +253,9 @@ xcorr<Sample, DFT>::xcorr(size_t M, size_t L, const dft_t& dft, const idft_t& id
  :	M_(verify_input_length(M))
  ,	L_(L)
  ,	N_(verify_transform_length(dft.size(), idft.size()))
+ ,	K_(dsp::is_complex<Sample>::value ? N_ : N_ / 2 + 1)
  ,	x_(L_ == 0 ? N_ + M_ - 1 : 2 * N_)
- ,	X_(L_ == 0 ? N_ : 2 * N_)
+ ,	X_(L_ == 0 ? K_ : 2 * K_)
  ,	dft_(dft)
  ,	idft_(idft)
 {
@@ -1,4 +1,5 @@
 #include <dsp++/platform.h>
+#include <dsp++/config.h>
 
 #ifdef DSP_ARCH_FAMILY_ARM
 
@@ -13,17 +14,37 @@
 #ifdef __GNUC__
 #endif // __GNUC__
 
+#if defined(__linux__) && !defined(DSP_ARCH_ARM64) && (!defined(__ANDROID__) || (__ANDROID_API__ >= 18))
+# include <sys/auxv.h>	// for getauxval()
+# define DSP_ARM_HAVE_GETAUXVAL
+# ifndef HWCAP_NEON
+#  define HWCAP_NEON (1 << 12)
+# endif
+#endif
+
 #ifdef _MSC_VER
 #endif// _MSC_VER
 
 DSPXX_API unsigned dsp::simd::features() {
 	unsigned res = 0;
+#if defined(DSP_ARCH_ARM64)
+	res |= dsp::simd::feat::arm_neon;	// Advanced SIMD is mandatory in ARMv8-A
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	res |= dsp::simd::feat::arm_neon;	// we're built for NEON-enabled target anyway
+#elif defined(DSP_ARM_HAVE_GETAUXVAL)
+	if (getauxval(AT_HWCAP) & HWCAP_NEON)
+		res |= dsp::simd::feat::arm_neon;
+#endif
+#if DSP_SIMD_NEON_DISABLED
+	res &= ~dsp::simd::feat::arm_neon;
+#endif
 	return res;
 }
 
 DSPXX_API size_t dsp::simd::alignment() {
-	// XXX 8 byte alignment is used by ARM-EABI
-	return 8; 
+	// XXX 8 byte alignment is used by ARM-EABI, NEON quadword loads prefer 16
+	static const size_t align = (dsp::simd::features() & dsp::simd::feat::arm_neon) ? 16 : 8;
+	return align;
 }
 
 DSPXX_API unsigned dsp::simd::architecture() {
@@ -34,7 +55,7 @@ DSPXX_API unsigned dsp::simd::architecture() {
 #ifdef DSP_ARCH_ARM
 	//arch |= dsp::simd::arch::thumb;
 #endif
-#ifdef DSP_ARCH_ARM
+#ifdef DSP_ARCH_ARM64
 	arch |= dsp::simd::arch::arm64;
 #endif 
 	return arch;
@@ -0,0 +1,554 @@
+#include <dsp++/platform.h>
+#include <dsp++/config.h>
+
+#if defined(DSP_ARCH_FAMILY_ARM) && !DSP_SIMD_NEON_DISABLED
+
+#include <algorithm>
+#include "neon.h"
+
+#include <arm_neon.h>
+
+namespace {
+
+// acc + a * b, fused if the target has VFPv4/ARMv8 FMA
+inline float32x4_t neon_madd(float32x4_t acc, float32x4_t a, float32x4_t b)
+{
+#if defined(__ARM_FEATURE_FMA)
+	return vfmaq_f32(acc, a, b);
+#else
+	return vmlaq_f32(acc, a, b);
+#endif
+}
+
+// acc - a * b
+inline float32x4_t neon_msub(float32x4_t acc, float32x4_t a, float32x4_t b)
+{
+#if defined(__ARM_FEATURE_FMA)
+	return vfmsq_f32(acc, a, b);
+#else
+	return vmlsq_f32(acc, a, b);
+#endif
+}
+
+inline float neon_hsum(float32x4_t x)
+{
+#ifdef DSP_ARCH_ARM64
+	return vaddvq_f32(x);
+#else
+	float32x2_t s = vadd_f32(vget_low_f32(x), vget_high_f32(x));
+	return vget_lane_f32(vpadd_f32(s, s), 0);
+#endif
+}
+
+// 1/x: estimate refined with Newton-Raphson steps (each roughly doubles the number of correct bits).
+template<int Steps>
+inline float32x4_t neon_recip_nr(float32x4_t x)
+{
+	float32x4_t r = vrecpeq_f32(x);
+	for (int i = 0; i < Steps; ++i)
+		r = vmulq_f32(vrecpsq_f32(x, r), r);
+	return r;
+}
+
+template<int Steps>
+inline float32x4_t neon_rsqrt_nr(float32x4_t x)
+{
+	float32x4_t r = vrsqrteq_f32(x);
+	for (int i = 0; i < Steps; ++i)
+		r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+	return r;
+}
+
+struct neon_mul {
+	float32x4_t operator()(float32x4_t a, float32x4_t b) const {return vmulq_f32(a, b);}
+};
+
+struct neon_add {
+	float32x4_t operator()(float32x4_t a, float32x4_t b) const {return vaddq_f32(a, b);}
+};
+
+struct neon_sub {
+	float32x4_t operator()(float32x4_t a, float32x4_t b) const {return vsubq_f32(a, b);}
+};
+
+struct neon_div {
+	float32x4_t operator()(float32x4_t a, float32x4_t b) const {
+#ifdef DSP_ARCH_ARM64
+		return vdivq_f32(a, b);
+#else
+		return vmulq_f32(a, neon_recip_nr<2>(b));
+#endif
+	}
+};
+
+struct neon_sqrt {
+	float32x4_t operator()(float32x4_t a) const {
+#ifdef DSP_ARCH_ARM64
+		return vsqrtq_f32(a);
+#else
+		// sqrt(x) = x * rsqrt(x), with rsqrt(0) = inf yielding NaN, hence the fixup
+		const float32x4_t zero = vdupq_n_f32(0.f);
+		return vbslq_f32(vceqq_f32(a, zero), zero, vmulq_f32(a, neon_rsqrt_nr<2>(a)));
+#endif
+	}
+};
+
+// Precision of rcp/rsqrt matches the one of SSE rcp_ps/rsqrt_ps (which is ~12 bits).
+struct neon_rcp {
+	float32x4_t operator()(float32x4_t a) const {return neon_recip_nr<1>(a);}
+};
+
+struct neon_rsqrt {
+	float32x4_t operator()(float32x4_t a) const {return neon_rsqrt_nr<1>(a);}
+};
+
+// Tail elements are processed in a temporary vector filled with ones, so that partial vectors
+// won't raise spurious division by zero.
+inline float32x4_t neon_load_tail(const float* a, size_t n)
+{
+	float tmp[4] = {1.f, 1.f, 1.f, 1.f};
+	std::copy(a, a + n, tmp);
+	return vld1q_f32(tmp);
+}
+
+inline void neon_store_tail(float* res, float32x4_t x, size_t n)
+{
+	float tmp[4];
+	vst1q_f32(tmp, x);
+	std::copy(tmp, tmp + n, res);
+}
+
+// binary float op(vector, vector) = vector
+template<class Op>
+inline void neon_fvvv(float* res, const float* a, const float* b, size_t len, Op op)
+{
+	size_t n = len / 16;
+	for (size_t i = 0; i < n; ++i, a += 16, b += 16, res += 16) {
+		const float32x4_t x0 = vld1q_f32(a);
+		const float32x4_t x1 = vld1q_f32(a + 4);
+		const float32x4_t x2 = vld1q_f32(a + 8);
+		const float32x4_t x3 = vld1q_f32(a + 12);
+		vst1q_f32(res, op(x0, vld1q_f32(b)));
+		vst1q_f32(res + 4, op(x1, vld1q_f32(b + 4)));
+		vst1q_f32(res + 8, op(x2, vld1q_f32(b + 8)));
+		vst1q_f32(res + 12, op(x3, vld1q_f32(b + 12)));
+	}
+	n = (len % 16) / 4;
+	for (size_t i = 0; i < n; ++i, a += 4, b += 4, res += 4)
+		vst1q_f32(res, op(vld1q_f32(a), vld1q_f32(b)));
+	if (0 != (n = len % 4))
+		neon_store_tail(res, op(neon_load_tail(a, n), neon_load_tail(b, n)), n);
+}
+
+// binary float op(vector, scalar) = vector
+template<class Op>
+inline void neon_fvsv(float* res, const float* a, float s, size_t len, Op op)
+{
+	const float32x4_t s0 = vdupq_n_f32(s);
+	size_t n = len / 16;
+	for (size_t i = 0; i < n; ++i, a += 16, res += 16) {
+		const float32x4_t x0 = vld1q_f32(a);
+		const float32x4_t x1 = vld1q_f32(a + 4);
+		const float32x4_t x2 = vld1q_f32(a + 8);
+		const float32x4_t x3 = vld1q_f32(a + 12);
+		vst1q_f32(res, op(x0, s0));
+		vst1q_f32(res + 4, op(x1, s0));
+		vst1q_f32(res + 8, op(x2, s0));
+		vst1q_f32(res + 12, op(x3, s0));
+	}
+	n = (len % 16) / 4;
+	for (size_t i = 0; i < n; ++i, a += 4, res += 4)
+		vst1q_f32(res, op(vld1q_f32(a), s0));
+	if (0 != (n = len % 4))
+		neon_store_tail(res, op(neon_load_tail(a, n), s0), n);
+}
+
+// unary float op(vector) = vector
+template<class Op>
+inline void neon_fvv(float* res, const float* a, size_t len, Op op)
+{
+	size_t n = len / 4;
+	for (size_t i = 0; i < n; ++i, a += 4, res += 4)
+		vst1q_f32(res, op(vld1q_f32(a)));
+	if (0 != (n = len % 4))
+		neon_store_tail(res, op(neon_load_tail(a, n)), n);
+}
+
+}
+
+//! @brief Piecewise vector multiplication using NEON instructions
+void dsp::simd::detail::arm_neon_mulf(float* res, const float* a, const float* b, size_t len)
+{neon_fvvv(res, a, b, len, neon_mul());}
+
+//! @brief Vector-scalar multiplication using NEON instructions
+void dsp::simd::detail::arm_neon_mulf(float* res, const float* a, float s, size_t len)
+{neon_fvsv(res, a, s, len, neon_mul());}
+
+//! @brief Piecewise vector division (a/b) using NEON instructions
+void dsp::simd::detail::arm_neon_divf(float* res, const float* a, const float* b, size_t len)
+{neon_fvvv(res, a, b, len, neon_div());}
+
+//! @brief Vector-scalar division using NEON instructions
+void dsp::simd::detail::arm_neon_divf(float* res, const float* a, float s, size_t len)
+{neon_fvsv(res, a, s, len, neon_div());}
+
+//! @brief Piecewise vector addition using NEON instructions
+void dsp::simd::detail::arm_neon_addf(float* res, const float* a, const float* b, size_t len)
+{neon_fvvv(res, a, b, len, neon_add());}
+
+void dsp::simd::detail::arm_neon_addf(float* res, const float* a, float s, size_t len)
+{neon_fvsv(res, a, s, len, neon_add());}
+
+//! @brief Piecewise vector subtraction using NEON instructions
+void dsp::simd::detail::arm_neon_subf(float* res, const float* a, const float* b, size_t len)
+{neon_fvvv(res, a, b, len, neon_sub());}
+
+void dsp::simd::detail::arm_neon_subf(float* res, const float* a, float s, size_t len)
+{neon_fvsv(res, a, s, len, neon_sub());}
+
+void dsp::simd::detail::arm_neon_sqrtf(float* res, const float* a, size_t len)
+{neon_fvv(res, a, len, neon_sqrt());}
+
+void dsp::simd::detail::arm_neon_rcpf(float* res, const float* a, size_t len)
+{neon_fvv(res, a, len, neon_rcp());}
+
+void dsp::simd::detail::arm_neon_rsqrtf(float* res, const float* a, size_t len)
+{neon_fvv(res, a, len, neon_rsqrt());}
+
+//! @brief Dot product using NEON instruction set.
+float dsp::simd::detail::arm_neon_dotf(const float* a, const float* b, size_t len)
+{
+	// 4 independent accumulators hide the latency of multiply-accumulate
+	float32x4_t s0 = vdupq_n_f32(0.f), s1 = s0, s2 = s0, s3 = s0;
+	size_t n = len / 16;
+	for (size_t i = 0; i < n; ++i, a += 16, b += 16) {
+		s0 = neon_madd(s0, vld1q_f32(a), vld1q_f32(b));
+		s1 = neon_madd(s1, vld1q_f32(a + 4), vld1q_f32(b + 4));
+		s2 = neon_madd(s2, vld1q_f32(a + 8), vld1q_f32(b + 8));
+		s3 = neon_madd(s3, vld1q_f32(a + 12), vld1q_f32(b + 12));
+	}
+	n = (len % 16) / 4;
+	for (size_t i = 0; i < n; ++i, a += 4, b += 4)
+		s0 = neon_madd(s0, vld1q_f32(a), vld1q_f32(b));
+	s0 = vaddq_f32(vaddq_f32(s0, s1), vaddq_f32(s2, s3));
+	float res = neon_hsum(s0);
+	n = len % 4;
+	for (size_t i = 0; i < n; ++i, ++a, ++b)
+		res += *a * *b;
+	return res;
+}
+
+//! @brief Piecewise complex vector multiplication using NEON instructions
+void dsp::simd::detail::arm_neon_mulcf(std::complex<float>* res_c, const std::complex<float>* a_c, const std::complex<float>* b_c, size_t len)
+{
+	float* res = reinterpret_cast<float*>(res_c);
+	const float* a = reinterpret_cast<const float*>(a_c);
+	const float* b = reinterpret_cast<const float*>(b_c);
+	// vld2q de-interleaves 4 complex numbers into separate re/im vectors
+	size_t n = len / 4;
+	for (size_t i = 0; i < n; ++i, a += 8, b += 8, res += 8) {
+		const float32x4x2_t x = vld2q_f32(a);
+		const float32x4x2_t y = vld2q_f32(b);
+		float32x4x2_t r;
+		r.val[0] = vmlsq_f32(vmulq_f32(x.val[0], y.val[0]), x.val[1], y.val[1]);
+		r.val[1] = vmlaq_f32(vmulq_f32(x.val[0], y.val[1]), x.val[1], y.val[0]);
+		vst2q_f32(res, r);
+	}
+	res_c = reinterpret_cast<std::complex<float>*>(res);
+	a_c = reinterpret_cast<const std::complex<float>*>(a);
+	b_c = reinterpret_cast<const std::complex<float>*>(b);
+	n = len % 4;
+	for (size_t i = 0; i < n; ++i, ++res_c, ++a_c, ++b_c)
+		*res_c = *a_c * *b_c;
+}
+
+//! @brief Dot product of complex vectors using NEON instructions
+std::complex<float> dsp::simd::detail::arm_neon_dotcf(const std::complex<float>* a_c, const std::complex<float>* b_c, size_t len)
+{
+	const float* a = reinterpret_cast<const float*>(a_c);
+	const float* b = reinterpret_cast<const float*>(b_c);
+	float32x4_t re = vdupq_n_f32(0.f), im = re;
+	size_t n = len / 4;
+	for (size_t i = 0; i < n; ++i, a += 8, b += 8) {
+		const float32x4x2_t x = vld2q_f32(a);
+		const float32x4x2_t y = vld2q_f32(b);
+		re = vmlsq_f32(vmlaq_f32(re, x.val[0], y.val[0]), x.val[1], y.val[1]);
+		im = vmlaq_f32(vmlaq_f32(im, x.val[0], y.val[1]), x.val[1], y.val[0]);
+	}
+	std::complex<float> res(neon_hsum(re), neon_hsum(im));
+	a_c = reinterpret_cast<const std::complex<float>*>(a);
+	b_c = reinterpret_cast<const std::complex<float>*>(b);
+	n = len % 4;
+	for (size_t i = 0; i < n; ++i, ++a_c, ++b_c)
+		res += *a_c * *b_c;
+	return res;
+}
+
+float dsp::simd::detail::arm_neon_filter_df2(float* w, const float* b, const size_t M, const float* a, const size_t N)
+{
+	float ardot = 0.f, madot = 0.f, *ws = w, b0 = *b;
+	float32x4_t ar0 = vdupq_n_f32(0.f), ar1 = ar0, ma0 = ar0, ma1 = ar0;
+	size_t L = std::min(N, M);
+	size_t n = L / 8;
+	// Simultaneous calculation of both AR- and MA- component dot products, first in 8-, then 4-element chunks
+	for (size_t i = 0; i < n; ++i, a += 8, w += 8, b += 8) {
+		const float32x4_t x0 = vld1q_f32(w);
+		const float32x4_t x1 = vld1q_f32(w + 4);
+		ar0 = neon_madd(ar0, vld1q_f32(a), x0);
+		ma0 = neon_madd(ma0, vld1q_f32(b), x0);
+		ar1 = neon_madd(ar1, vld1q_f32(a + 4), x1);
+		ma1 = neon_madd(ma1, vld1q_f32(b + 4), x1);
+	}
+	if (0 != (L % 8) / 4) {
+		const float32x4_t x0 = vld1q_f32(w);
+		ar0 = neon_madd(ar0, vld1q_f32(a), x0);
+		ma0 = neon_madd(ma0, vld1q_f32(b), x0);
+		a += 4; w += 4; b += 4;
+	}
+	n = L % 4;
+	for (size_t i = 0; i < n; ++i, ++a, ++w, ++b) {
+		ardot += *a * *w;
+		madot += *b * *w;
+	}
+	// Calculate only the remaining AR- or MA- component product
+	L = std::max(N, M) - L;
+	const float* c = (N > M ? a : b);
+	float32x4_t& s0 = (N > M ? ar0 : ma0);
+	float32x4_t& s1 = (N > M ? ar1 : ma1);
+	float& dot = (N > M ? ardot : madot);
+	n = L / 8;
+	for (size_t i = 0; i < n; ++i, c += 8, w += 8) {
+		s0 = neon_madd(s0, vld1q_f32(c), vld1q_f32(w));
+		s1 = neon_madd(s1, vld1q_f32(c + 4), vld1q_f32(w + 4));
+	}
+	if (0 != (L % 8) / 4) {
+		s0 = neon_madd(s0, vld1q_f32(c), vld1q_f32(w));
+		c += 4; w += 4;
+	}
+	n = L % 4;
+	for (size_t i = 0; i < n; ++i, ++c, ++w)
+		dot += *c * *w;
+
+	ardot += neon_hsum(vaddq_f32(ar0, ar1));
+	madot += neon_hsum(vaddq_f32(ma0, ma1));
+	// MA product was calculated with uncorrected w[0], see x86_sse_filter_df2() for the explanation.
+	madot -= ardot * b0;
+	*ws -= ardot;
+	return madot;
+}
+
+float dsp::simd::detail::arm_neon_filter_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N)
+{
+	const float y = b[0] * x + s[0];
+	const float32x4_t xx = vdupq_n_f32(x), yy = vdupq_n_f32(y);
+	const size_t L = std::min(M, N);
+	size_t i = 1;
+	// s[i - 1] = s[i] + b[i] * x - a[i] * y, see x86_sse_filter_tdf2()
+	for (; i + 4 <= L; i += 4)
+		vst1q_f32(s + i - 1, neon_msub(neon_madd(vld1q_f32(s + i), vld1q_f32(b + i), xx), vld1q_f32(a + i), yy));
+	for (; i < L; ++i)
+		s[i - 1] = s[i] + b[i] * x - a[i] * y;
+	for (; i + 4 <= M; i += 4)
+		vst1q_f32(s + i - 1, neon_madd(vld1q_f32(s + i), vld1q_f32(b + i), xx));
+	for (; i < M; ++i)
+		s[i - 1] = s[i] + b[i] * x;
+	for (; i + 4 <= N; i += 4)
+		vst1q_f32(s + i - 1, neon_msub(vld1q_f32(s + i), vld1q_f32(a + i), yy));
+	for (; i < N; ++i)
+		s[i - 1] = s[i] - a[i] * y;
+	return y;
+}
+
+float dsp::simd::detail::arm_neon_filter_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step)
+{
+	// step is at least 4 and a[0] is 0 (see sos_filter_base), so the whole section fits in a single vector
+	for (size_t i = 0; i < N; ++i, w += step, b += step, a += step, ++scale_only) {
+		if (*scale_only)
+			x *= *b;
+		else {
+			float32x4_t wx = vsetq_lane_f32(x, vld1q_f32(w), 0);		// put result of previous section in wx[0]
+			x -= neon_hsum(vmulq_f32(vld1q_f32(a), wx));				// x = wx[0] - dot(a, w)
+			wx = vsetq_lane_f32(x, wx, 0);
+			vst1q_f32(w, wx);											// update the delay line for next sample
+			x = neon_hsum(vmulq_f32(vld1q_f32(b), wx));				// x = dot(b, w)
+		}
+	}
+	return x;
+}
+
+void dsp::simd::detail::arm_neon_filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M)
+{
+	// consecutive output samples are accumulated in separate lanes, see x86_sse_filter_block_fir()
+	size_t n = L / 16;
+	for (size_t i = 0; i < n; ++i, x += 16, y += 16) {
+		float32x4_t y0 = vdupq_n_f32(0.f), y1 = y0, y2 = y0, y3 = y0;
+		for (size_t j = 0; j < M; ++j) {
+			const float* w = x - j;
+			const float32x4_t c = vdupq_n_f32(b[j]);
+			y0 = neon_madd(y0, c, vld1q_f32(w));
+			y1 = neon_madd(y1, c, vld1q_f32(w + 4));
+			y2 = neon_madd(y2, c, vld1q_f32(w + 8));
+			y3 = neon_madd(y3, c, vld1q_f32(w + 12));
+		}
+		vst1q_f32(y, y0);
+		vst1q_f32(y + 4, y1);
+		vst1q_f32(y + 8, y2);
+		vst1q_f32(y + 12, y3);
+	}
+	n = (L % 16) / 4;
+	for (size_t i = 0; i < n; ++i, x += 4, y += 4) {
+		float32x4_t y0 = vdupq_n_f32(0.f);
+		for (size_t j = 0; j < M; ++j)
+			y0 = neon_madd(y0, vdupq_n_f32(b[j]), vld1q_f32(x - j));
+		vst1q_f32(y, y0);
+	}
+	n = L % 4;
+	for (size_t i = 0; i < n; ++i, ++x, ++y) {
+		float r = 0.f;
+		for (size_t j = 0; j < M; ++j)
+			r += b[j] * *(x - j);
+		*y = r;
+	}
+}
+
+void dsp::simd::detail::arm_neon_filter_block_biquad(float* x, size_t L, float* s, const float* m)
+{
+	// outputs (y) and the next state (z) as linear combinations of inputs and the state, see x86_sse_filter_block_biquad()
+	float32x4_t c[12];
+	for (int k = 0; k < 12; ++k)
+		c[k] = vld1q_f32(m + 4 * k);
+	float32x4_t s1 = vdupq_n_f32(s[0]), s2 = vdupq_n_f32(s[1]);
+	size_t n = L / 4;
+	for (size_t i = 0; i < n; ++i, x += 4) {
+		float32x4_t x0 = vdupq_n_f32(x[0]);
+		float32x4_t y = vmulq_f32(c[0], x0);
+		float32x4_t z = vmulq_f32(c[1], x0);
+		x0 = vdupq_n_f32(x[1]);
+		y = neon_madd(y, c[2], x0);
+		z = neon_madd(z, c[3], x0);
+		x0 = vdupq_n_f32(x[2]);
+		y = neon_madd(y, c[4], x0);
+		z = neon_madd(z, c[5], x0);
+		x0 = vdupq_n_f32(x[3]);
+		y = neon_madd(y, c[6], x0);
+		z = neon_madd(z, c[7], x0);
+		y = neon_madd(neon_madd(y, c[8], s1), c[10], s2);
+		z = neon_madd(neon_madd(z, c[9], s1), c[11], s2);
+		vst1q_f32(x, y);
+		const float32x2_t zl = vget_low_f32(z);
+		s1 = vdupq_lane_f32(zl, 0);
+		s2 = vdupq_lane_f32(zl, 1);
+	}
+	s[0] = vgetq_lane_f32(s1, 0);
+	s[1] = vgetq_lane_f32(s2, 0);
+	// trailing samples in Transposed Direct-Form II, m[48 ... 53] = {b0, b1, b2, 1, a1, a2}
+	n = L % 4;
+	for (size_t i = 0; i < n; ++i, ++x) {
+		const float y = m[48] * *x + s[0];
+		s[0] = m[49] * *x - m[52] * y + s[1];
+		s[1] = m[50] * *x - m[53] * y;
+		*x = y;
+	}
+}
+
+void dsp::simd::detail::arm_neon_filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s)
+{
+	// 4 channels at a time, see x86_sse_filter_sos_lanes()
+	for (size_t j = 0; j < N; ++j, c += 8, s += 2 * C) {
+		const float32x4_t b0 = vdupq_n_f32(c[0]), b1 = vdupq_n_f32(c[1]), b2 = vdupq_n_f32(c[2]);
+		const float32x4_t a1 = vdupq_n_f32(c[3]), a2 = vdupq_n_f32(c[4]);
+		for (size_t k = 0; k < C; k += 4) {
+			float32x4_t s1 = vld1q_f32(s + k), s2 = vld1q_f32(s + C + k);
+			float* p = x + k;
+			for (size_t n = 0; n < L; ++n, p += stride) {
+				const float32x4_t in = vld1q_f32(p);
+				const float32x4_t y = neon_madd(s1, b0, in);
+				s1 = neon_msub(neon_madd(s2, b1, in), a1, y);
+				s2 = neon_msub(vmulq_f32(b2, in), a2, y);
+				vst1q_f32(p, y);
+			}
+			vst1q_f32(s + k, s1);
+			vst1q_f32(s + C + k, s2);
+		}
+	}
+}
+
+namespace {
+
+// multiply 4 pairs of complex numbers de-interleaved by vld2q
+inline float32x4x2_t neon_mulc4(float32x4x2_t a, float32x4x2_t b)
+{
+	float32x4x2_t r;
+	r.val[0] = neon_msub(vmulq_f32(a.val[0], b.val[0]), a.val[1], b.val[1]);
+	r.val[1] = neon_madd(vmulq_f32(a.val[0], b.val[1]), a.val[1], b.val[0]);
+	return r;
+}
+
+inline float32x4x2_t neon_addc4(float32x4x2_t a, float32x4x2_t b)
+{
+	float32x4x2_t r;
+	r.val[0] = vaddq_f32(a.val[0], b.val[0]);
+	r.val[1] = vaddq_f32(a.val[1], b.val[1]);
+	return r;
+}
+
+inline float32x4x2_t neon_subc4(float32x4x2_t a, float32x4x2_t b)
+{
+	float32x4x2_t r;
+	r.val[0] = vsubq_f32(a.val[0], b.val[0]);
+	r.val[1] = vsubq_f32(a.val[1], b.val[1]);
+	return r;
+}
+
+// multiply 4 complex numbers by -i
+inline float32x4x2_t neon_mul_minus_i4(float32x4x2_t a)
+{
+	float32x4x2_t r;
+	r.val[0] = a.val[1];
+	r.val[1] = vnegq_f32(a.val[0]);
+	return r;
+}
+
+}
+
+//! @brief Radix-2 decimation-in-time FFT stage using NEON instructions, 4 butterflies at a time.
+void dsp::simd::detail::arm_neon_fft_radix2f(std::complex<float>* x_c, size_t m, size_t count, const std::complex<float>* w_c)
+{
+	float* x = reinterpret_cast<float*>(x_c);
+	const float* w = reinterpret_cast<const float*>(w_c);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 2 * m2) {
+		for (size_t j = 0; j < m2; j += 8) {
+			const float32x4x2_t a0 = vld2q_f32(x + j);
+			const float32x4x2_t a1 = neon_mulc4(vld2q_f32(x + m2 + j), vld2q_f32(w + j));
+			vst2q_f32(x + j, neon_addc4(a0, a1));
+			vst2q_f32(x + m2 + j, neon_subc4(a0, a1));
+		}
+	}
+}
+
+//! @brief Radix-4 decimation-in-time FFT stage using NEON instructions, 4 butterflies at a time.
+void dsp::simd::detail::arm_neon_fft_radix4f(std::complex<float>* x_c, size_t m, size_t count, const std::complex<float>* w_c)
+{
+	float* x = reinterpret_cast<float*>(x_c);
+	const float* w = reinterpret_cast<const float*>(w_c);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 4 * m2) {
+		for (size_t j = 0; j < m2; j += 8) {
+			const float32x4x2_t a0 = vld2q_f32(x + j);
+			const float32x4x2_t a1 = neon_mulc4(vld2q_f32(x + 2 * m2 + j), vld2q_f32(w + j));
+			const float32x4x2_t a2 = neon_mulc4(vld2q_f32(x + m2 + j), vld2q_f32(w + m2 + j));
+			const float32x4x2_t a3 = neon_mulc4(vld2q_f32(x + 3 * m2 + j), vld2q_f32(w + 2 * m2 + j));
+			const float32x4x2_t t0 = neon_addc4(a0, a2);
+			const float32x4x2_t t1 = neon_subc4(a0, a2);
+			const float32x4x2_t t2 = neon_addc4(a1, a3);
+			const float32x4x2_t t3 = neon_mul_minus_i4(neon_subc4(a1, a3));
+			vst2q_f32(x + j, neon_addc4(t0, t2));
+			vst2q_f32(x + m2 + j, neon_addc4(t1, t3));
+			vst2q_f32(x + 2 * m2 + j, neon_subc4(t0, t2));
+			vst2q_f32(x + 3 * m2 + j, neon_subc4(t1, t3));
+		}
+	}
+}
+
+#endif // defined(DSP_ARCH_FAMILY_ARM) && !DSP_SIMD_NEON_DISABLED
@@ -0,0 +1,68 @@
+#ifndef DSP_INTERNAL_ARM_NEON_H_INCLUDED
+#define DSP_INTERNAL_ARM_NEON_H_INCLUDED
+#pragma once
+
+#include <complex>
+#include <cstddef>
+
+namespace dsp { namespace simd { namespace detail {
+
+// NOTE: contrary to their x86_sse_xxx() counterparts, NEON kernels use unaligned loads and process
+// the trailing (len % 4) elements too, as ARM-EABI only guarantees 8-byte alignment and padding.
+
+void arm_neon_mulf(float* res, const float* a, const float* b, size_t len);
+void arm_neon_mulf(float* res, const float* a, float s, size_t len);
+void arm_neon_mulcf(std::complex<float>* res, const std::complex<float>* a, const std::complex<float>* b, size_t len);
+
+void arm_neon_divf(float* res, const float* a, const float* b, size_t len);
+void arm_neon_divf(float* res, const float* a, float s, size_t len);
+
+void arm_neon_addf(float* res, const float* a, const float* b, size_t len);
+void arm_neon_addf(float* res, const float* a, float s, size_t len);
+
+void arm_neon_subf(float* res, const float* a, const float* b, size_t len);
+void arm_neon_subf(float* res, const float* a, float s, size_t len);
+
+float arm_neon_dotf(const float* a, const float* b, size_t len);
+std::complex<float> arm_neon_dotcf(const std::complex<float>* a, const std::complex<float>* b, size_t len);
+
+void arm_neon_sqrtf(float* res, const float* a, size_t len);
+void arm_neon_rcpf(float* res, const float* a, size_t len);
+void arm_neon_rsqrtf(float* res, const float* a, size_t len);
+
+/*!
+ * @brief Implementation of Direct-Form II FIR/IIR filter using NEON instruction set.
+ * @param w Delay line buffer of length max(M, N).
+ * @param b FIR filter coefficients vector (M).
+ * @param M Length of b vector.
+ * @param a IIR filter coefficients vector, a[0] must be set to 0 for efficiency reasons (N).
+ * @param N Length of a vector.
+ * @return filtered sample.
+ * @see x86_sse_filter_df2()
+ */
+float arm_neon_filter_df2(float* w, const float* b, const size_t M, const float* a, const size_t N);
+
+//! @brief Implementation of Transposed Direct-Form II FIR/IIR filter using NEON instruction set, see x86_sse_filter_tdf2().
+float arm_neon_filter_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N);
+
+float arm_neon_filter_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step);
+
+//! @brief Implementation of block FIR filter using NEON instruction set, see x86_sse_filter_block_fir().
+void arm_neon_filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M);
+
+//! @brief Implementation of single second-order section block filter using NEON instruction set, see x86_sse_filter_block_biquad().
+void arm_neon_filter_block_biquad(float* x, size_t L, float* s, const float* m);
+
+//! @brief Implementation of multichannel cascade of second-order sections using NEON instruction set, see x86_sse_filter_sos_lanes().
+void arm_neon_filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s);
+
+/*!
+ * @brief Radix-2 (radix-4) decimation-in-time FFT stage using NEON instruction set, see x86_sse_fft_radix2f()
+ * (x86_sse_fft_radix4f()) for the description of parameters; m must be a multiple of 4.
+ */
+void arm_neon_fft_radix2f(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+void arm_neon_fft_radix4f(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+
+} } }
+
+#endif /* DSP_INTERNAL_ARM_NEON_H_INCLUDED */
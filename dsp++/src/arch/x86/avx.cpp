@@ -0,0 +1,168 @@
+#include <dsp++/platform.h>
+#include <dsp++/config.h>
+
+#if defined(DSP_ARCH_FAMILY_X86) && !DSP_SIMD_AVX_DISABLED
+
+#include <algorithm>
+#include <dsp++/simd.h>
+#include "avx.h"
+#include "avx_utils.h"
+
+#include <immintrin.h>
+
+//! @brief Piecewise vector multiplication using AVX instructions
+AVX_FVVV(dsp::simd::detail::x86_avx_mulf, mul_ps)
+
+//! @brief Vector-scalar multiplication using AVX instructions
+AVX_FVSV(dsp::simd::detail::x86_avx_mulf, mul_ps)
+
+//! @brief Piecewise vector addition using AVX instructions
+AVX_FVVV(dsp::simd::detail::x86_avx_addf, add_ps)
+
+AVX_FVSV(dsp::simd::detail::x86_avx_addf, add_ps)
+
+//! @brief Piecewise vector subtraction using AVX instructions
+AVX_FVVV(dsp::simd::detail::x86_avx_subf, sub_ps)
+
+AVX_FVSV(dsp::simd::detail::x86_avx_subf, sub_ps)
+
+//! @brief Piecewise vector division (a/b) using AVX instructions
+AVX_FVVV(dsp::simd::detail::x86_avx_divf, div_ps)
+
+//! @brief Vector-scalar division using AVX instructions
+AVX_FVSV(dsp::simd::detail::x86_avx_divf, div_ps)
+
+AVX_FVV(dsp::simd::detail::x86_avx_sqrtf, sqrt_ps)
+
+AVX_FVV(dsp::simd::detail::x86_avx_rcpf, rcp_ps)
+
+AVX_FVV(dsp::simd::detail::x86_avx_rsqrtf, rsqrt_ps)
+
+//! @brief Dot product using AVX instruction set.
+AVX_SUM_FVVS(dsp::simd::detail::x86_avx_dotf, AVX_MADD, AVX_MADD4)
+
+AVX_FILTER_DF2(dsp::simd::detail::x86_avx_filter_df2, AVX_MADD, AVX_MADD4)
+
+AVX_FILTER_TDF2(dsp::simd::detail::x86_avx_filter_tdf2, AVX_MADD, AVX_NMADD)
+
+AVX_FILTER_SOS_DF2(dsp::simd::detail::x86_avx_filter_sos_df2, AVX_NMADD_SS)
+
+AVX_FILTER_BLOCK_FIR(dsp::simd::detail::x86_avx_filter_block_fir, AVX_MADD, AVX_MADD4)
+
+AVX_FILTER_BLOCK_BIQUAD(dsp::simd::detail::x86_avx_filter_block_biquad, AVX_MADD4)
+
+AVX_FILTER_SOS_LANES(dsp::simd::detail::x86_avx_filter_sos_lanes, AVX_MADD, AVX_NMADD, AVX_MADD4, AVX_NMADD4)
+
+// multiply 4 pairs of interleaved complex numbers
+static inline __m256 avx_mulc4(__m256 a, __m256 b)
+{
+	const __m256 br = _mm256_moveldup_ps(b);
+	const __m256 bi = _mm256_movehdup_ps(b);
+	const __m256 as = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+	return _mm256_addsub_ps(_mm256_mul_ps(a, br), _mm256_mul_ps(as, bi));
+}
+
+// multiply 4 complex numbers by -i
+static inline __m256 avx_mul_minus_i4(__m256 a, __m256 sign_odd)
+{
+	return _mm256_xor_ps(_mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)), sign_odd);
+}
+
+// multiply 2 pairs of interleaved complex numbers
+static inline __m256d avx_mulc2d(__m256d a, __m256d b)
+{
+	const __m256d br = _mm256_movedup_pd(b);
+	const __m256d bi = _mm256_permute_pd(b, 0xf);
+	const __m256d as = _mm256_permute_pd(a, 0x5);
+	return _mm256_addsub_pd(_mm256_mul_pd(a, br), _mm256_mul_pd(as, bi));
+}
+
+// multiply 2 complex numbers by -i
+static inline __m256d avx_mul_minus_i2d(__m256d a, __m256d sign_odd)
+{
+	return _mm256_xor_pd(_mm256_permute_pd(a, 0x5), sign_odd);
+}
+
+//! @brief Radix-2 decimation-in-time FFT stage using AVX instructions, 4 butterflies at a time.
+void dsp::simd::detail::x86_avx_fft_radix2f(std::complex<float>* x_c, size_t m, size_t count, const std::complex<float>* w_c)
+{
+	float* x = reinterpret_cast<float*>(x_c);
+	const float* w = reinterpret_cast<const float*>(w_c);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 2 * m2) {
+		for (size_t j = 0; j < m2; j += 8) {
+			const __m256 a0 = _mm256_loadu_ps(x + j);
+			const __m256 a1 = avx_mulc4(_mm256_loadu_ps(x + m2 + j), _mm256_loadu_ps(w + j));
+			_mm256_storeu_ps(x + j, _mm256_add_ps(a0, a1));
+			_mm256_storeu_ps(x + m2 + j, _mm256_sub_ps(a0, a1));
+		}
+	}
+}
+
+//! @brief Radix-4 decimation-in-time FFT stage using AVX instructions, 4 butterflies at a time.
+void dsp::simd::detail::x86_avx_fft_radix4f(std::complex<float>* x_c, size_t m, size_t count, const std::complex<float>* w_c)
+{
+	float* x = reinterpret_cast<float*>(x_c);
+	const float* w = reinterpret_cast<const float*>(w_c);
+	const __m256 sign_odd = _mm256_setr_ps(0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 4 * m2) {
+		for (size_t j = 0; j < m2; j += 8) {
+			const __m256 a0 = _mm256_loadu_ps(x + j);
+			const __m256 a1 = avx_mulc4(_mm256_loadu_ps(x + 2 * m2 + j), _mm256_loadu_ps(w + j));
+			const __m256 a2 = avx_mulc4(_mm256_loadu_ps(x + m2 + j), _mm256_loadu_ps(w + m2 + j));
+			const __m256 a3 = avx_mulc4(_mm256_loadu_ps(x + 3 * m2 + j), _mm256_loadu_ps(w + 2 * m2 + j));
+			const __m256 t0 = _mm256_add_ps(a0, a2);
+			const __m256 t1 = _mm256_sub_ps(a0, a2);
+			const __m256 t2 = _mm256_add_ps(a1, a3);
+			const __m256 t3 = avx_mul_minus_i4(_mm256_sub_ps(a1, a3), sign_odd);
+			_mm256_storeu_ps(x + j, _mm256_add_ps(t0, t2));
+			_mm256_storeu_ps(x + m2 + j, _mm256_add_ps(t1, t3));
+			_mm256_storeu_ps(x + 2 * m2 + j, _mm256_sub_ps(t0, t2));
+			_mm256_storeu_ps(x + 3 * m2 + j, _mm256_sub_ps(t1, t3));
+		}
+	}
+}
+
+//! @brief Radix-2 decimation-in-time FFT stage using AVX instructions, 2 butterflies at a time.
+void dsp::simd::detail::x86_avx_fft_radix2d(std::complex<double>* x_c, size_t m, size_t count, const std::complex<double>* w_c)
+{
+	double* x = reinterpret_cast<double*>(x_c);
+	const double* w = reinterpret_cast<const double*>(w_c);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 2 * m2) {
+		for (size_t j = 0; j < m2; j += 4) {
+			const __m256d a0 = _mm256_loadu_pd(x + j);
+			const __m256d a1 = avx_mulc2d(_mm256_loadu_pd(x + m2 + j), _mm256_loadu_pd(w + j));
+			_mm256_storeu_pd(x + j, _mm256_add_pd(a0, a1));
+			_mm256_storeu_pd(x + m2 + j, _mm256_sub_pd(a0, a1));
+		}
+	}
+}
+
+//! @brief Radix-4 decimation-in-time FFT stage using AVX instructions, 2 butterflies at a time.
+void dsp::simd::detail::x86_avx_fft_radix4d(std::complex<double>* x_c, size_t m, size_t count, const std::complex<double>* w_c)
+{
+	double* x = reinterpret_cast<double*>(x_c);
+	const double* w = reinterpret_cast<const double*>(w_c);
+	const __m256d sign_odd = _mm256_setr_pd(0., -0., 0., -0.);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 4 * m2) {
+		for (size_t j = 0; j < m2; j += 4) {
+			const __m256d a0 = _mm256_loadu_pd(x + j);
+			const __m256d a1 = avx_mulc2d(_mm256_loadu_pd(x + 2 * m2 + j), _mm256_loadu_pd(w + j));
+			const __m256d a2 = avx_mulc2d(_mm256_loadu_pd(x + m2 + j), _mm256_loadu_pd(w + m2 + j));
+			const __m256d a3 = avx_mulc2d(_mm256_loadu_pd(x + 3 * m2 + j), _mm256_loadu_pd(w + 2 * m2 + j));
+			const __m256d t0 = _mm256_add_pd(a0, a2);
+			const __m256d t1 = _mm256_sub_pd(a0, a2);
+			const __m256d t2 = _mm256_add_pd(a1, a3);
+			const __m256d t3 = avx_mul_minus_i2d(_mm256_sub_pd(a1, a3), sign_odd);
+			_mm256_storeu_pd(x + j, _mm256_add_pd(t0, t2));
+			_mm256_storeu_pd(x + m2 + j, _mm256_add_pd(t1, t3));
+			_mm256_storeu_pd(x + 2 * m2 + j, _mm256_sub_pd(t0, t2));
+			_mm256_storeu_pd(x + 3 * m2 + j, _mm256_sub_pd(t1, t3));
+		}
+	}
+}
+
+#endif // DSP_ARCH_FAMILY_X86 && !DSP_SIMD_AVX_DISABLED
@@ -0,0 +1,77 @@
+#ifndef DSP_INTERNAL_X86_AVX_H_INCLUDED
+#define DSP_INTERNAL_X86_AVX_H_INCLUDED
+#pragma once
+
+#include <dsp++/config.h>
+#include <dsp++/simd.h>
+#include <complex>
+#include <cstddef>
+
+#if !DSP_SIMD_AVX_DISABLED
+
+namespace dsp { namespace simd { namespace detail {
+
+//! @brief Feature flags required by x86_fma_* functions.
+const int x86_fma_mask = dsp::simd::feat::x86_avx | dsp::simd::feat::x86_fma3;
+
+void x86_avx_mulf(float* res, const float* x, const float* b, size_t N);
+void x86_avx_mulf(float* res, const float* a, float s, size_t len);
+
+void x86_avx_divf(float* res, const float* x, const float* b, size_t N);
+void x86_avx_divf(float* res, const float* x, float s, size_t N);
+
+void x86_avx_addf(float* res, const float* x, const float* b, size_t N);
+void x86_avx_addf(float* res, const float* x, float s, size_t N);
+
+void x86_avx_subf(float* res, const float* x, const float* b, size_t N);
+void x86_avx_subf(float* res, const float* x, float s, size_t N);
+
+void x86_avx_sqrtf(float* res, const float* a, size_t len);
+void x86_avx_rcpf(float* res, const float* a, size_t len);
+void x86_avx_rsqrtf(float* res, const float* a, size_t len);
+
+float x86_avx_dotf(const float* x, const float* b, size_t N);
+float x86_fma_dotf(const float* x, const float* b, size_t N);
+
+/*!
+ * @brief Implementation of Direct-Form II FIR/IIR filter using AVX (FMA) instruction set.
+ * Same contract as x86_sse_filter_df2(), except that none of the vectors needs to be aligned;
+ * M and N must be multiples of 4.
+ */
+float x86_avx_filter_df2(float* w, const float* b, const size_t M, const float* a, const size_t N);
+float x86_fma_filter_df2(float* w, const float* b, const size_t M, const float* a, const size_t N);
+
+//! @brief Implementation of Transposed Direct-Form II FIR/IIR filter using AVX (FMA) instruction set, same contract as x86_sse_filter_tdf2().
+float x86_avx_filter_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N);
+float x86_fma_filter_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N);
+
+//! @brief Implementation of cascaded Direct-Form II SOS filter using AVX (FMA) instruction set, same contract as x86_sse_filter_sos_df2().
+float x86_avx_filter_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step);
+float x86_fma_filter_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step);
+
+//! @brief Implementation of block FIR filter using AVX (FMA) instruction set, same contract as x86_sse_filter_block_fir().
+void x86_avx_filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M);
+void x86_fma_filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M);
+
+//! @brief Implementation of single second-order section block filter using AVX (FMA) instruction set, same contract as x86_sse_filter_block_biquad().
+void x86_avx_filter_block_biquad(float* x, size_t L, float* s, const float* m);
+void x86_fma_filter_block_biquad(float* x, size_t L, float* s, const float* m);
+
+//! @brief Implementation of multichannel cascade of second-order sections using AVX (FMA) instruction set with 8 channels in vector lanes, same contract as x86_sse_filter_sos_lanes().
+void x86_avx_filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s);
+void x86_fma_filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s);
+
+/*!
+ * @brief Radix-2 (radix-4) FFT stage using AVX instruction set, same contract as x86_sse_fft_radix2f() (x86_sse_fft_radix4f()),
+ * except that m must be a multiple of 4 for float versions and even for double ones.
+ */
+void x86_avx_fft_radix2f(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+void x86_avx_fft_radix4f(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+void x86_avx_fft_radix2d(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+void x86_avx_fft_radix4d(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+
+} } }
+
+#endif // !DSP_SIMD_AVX_DISABLED
+
+#endif /* DSP_INTERNAL_X86_AVX_H_INCLUDED */
@@ -0,0 +1,364 @@
+/*!
+ * @file avx_utils.h
+ * @brief AVX support header
+ * @note The kernel bodies are macros, not inline functions, since they are instantiated in translation units
+ * compiled with different instruction set flags (AVX and AVX+FMA) and inline functions of the same name
+ * could be merged by the linker into the variant using instructions unavailable at runtime.
+ */
+
+#ifndef DSP_AVX_UTILS_H_INCLUDED
+#define DSP_AVX_UTILS_H_INCLUDED
+#pragma once
+
+#include "sse_utils.h"
+
+// multiply-accumulate acc + a * b, 8- and 4-element variants
+#define AVX_MADD(acc, a, b) _mm256_add_ps(acc, _mm256_mul_ps(a, b))
+#define AVX_MADD4(acc, a, b) _mm_add_ps(acc, _mm_mul_ps(a, b))
+#define FMA_MADD(acc, a, b) _mm256_fmadd_ps(a, b, acc)
+#define FMA_MADD4(acc, a, b) _mm_fmadd_ps(a, b, acc)
+// acc - a * b, 8- and 4-element variants
+#define AVX_NMADD(acc, a, b) _mm256_sub_ps(acc, _mm256_mul_ps(a, b))
+#define AVX_NMADD4(acc, a, b) _mm_sub_ps(acc, _mm_mul_ps(a, b))
+#define FMA_NMADD(acc, a, b) _mm256_fnmadd_ps(a, b, acc)
+#define FMA_NMADD4(acc, a, b) _mm_fnmadd_ps(a, b, acc)
+// c - a * b on the lowest element
+#define AVX_NMADD_SS(c, a, b) _mm_sub_ss(c, _mm_mul_ss(a, b))
+#define FMA_NMADD_SS(c, a, b) _mm_fnmadd_ss(a, b, c)
+
+// binary float op(vector,vector) = vector
+#define AVX_FVVV(name, op) \
+void name(float* res, const float* x, const float* b, size_t N) {	 		\
+	__m256 x0, x1, x2, x3;													\
+	size_t n = N / LONG_UNROLL;												\
+	for (size_t i = 0; i < n; ++i, b += LONG_UNROLL, x += LONG_UNROLL, res += LONG_UNROLL) {	\
+		x0 = _mm256_loadu_ps(x);											\
+		x1 = _mm256_loadu_ps(x + 8);										\
+		x2 = _mm256_loadu_ps(x + 16);										\
+		x3 = _mm256_loadu_ps(x + 24);										\
+		x0 = _mm256_ ## op(x0, _mm256_loadu_ps(b));							\
+		x1 = _mm256_ ## op(x1, _mm256_loadu_ps(b + 8));						\
+		x2 = _mm256_ ## op(x2, _mm256_loadu_ps(b + 16));					\
+		x3 = _mm256_ ## op(x3, _mm256_loadu_ps(b + 24));					\
+		_mm256_storeu_ps(res, x0);											\
+		_mm256_storeu_ps(res + 8, x1);										\
+		_mm256_storeu_ps(res + 16, x2);										\
+		_mm256_storeu_ps(res + 24, x3);										\
+	}																		\
+	n = (N % LONG_UNROLL) / 8;												\
+	for (size_t i = 0; i < n; ++i, b += 8, x += 8, res += 8)				\
+		_mm256_storeu_ps(res, _mm256_ ## op(_mm256_loadu_ps(x), _mm256_loadu_ps(b)));	\
+	if (0 != (N % 8) / 4)													\
+		_mm_storeu_ps(res, _mm_ ## op(_mm_loadu_ps(x), _mm_loadu_ps(b)));	\
+}
+
+// binary float op(vector,scalar) = vector
+#define AVX_FVSV(name, op) \
+void name(float* res, const float* x, float s, size_t N) {					\
+	__m256 x0, x1, x2, x3;													\
+	const __m256 s0 = _mm256_set1_ps(s);									\
+	size_t n = N / LONG_UNROLL;												\
+	for (size_t i = 0; i < n; ++i, x += LONG_UNROLL, res += LONG_UNROLL) {	\
+		x0 = _mm256_loadu_ps(x);											\
+		x1 = _mm256_loadu_ps(x + 8);										\
+		x2 = _mm256_loadu_ps(x + 16);										\
+		x3 = _mm256_loadu_ps(x + 24);										\
+		x0 = _mm256_ ## op(x0, s0);											\
+		x1 = _mm256_ ## op(x1, s0);											\
+		x2 = _mm256_ ## op(x2, s0);											\
+		x3 = _mm256_ ## op(x3, s0);											\
+		_mm256_storeu_ps(res, x0);											\
+		_mm256_storeu_ps(res + 8, x1);										\
+		_mm256_storeu_ps(res + 16, x2);										\
+		_mm256_storeu_ps(res + 24, x3);										\
+	}																		\
+	n = (N % LONG_UNROLL) / 8;												\
+	for (size_t i = 0; i < n; ++i, x += 8, res += 8)						\
+		_mm256_storeu_ps(res, _mm256_ ## op(_mm256_loadu_ps(x), s0));		\
+	if (0 != (N % 8) / 4)													\
+		_mm_storeu_ps(res, _mm_ ## op(_mm_loadu_ps(x), _mm256_castps256_ps128(s0)));	\
+}
+
+// unary float op(vector) = vector
+#define AVX_FVV(name, op)	\
+void name(float* res, const float* x, size_t N) {							\
+	__m256 x0, x1, x2, x3;													\
+	size_t n = N / LONG_UNROLL;												\
+	for (size_t i = 0; i < n; ++i, x += LONG_UNROLL, res += LONG_UNROLL) {	\
+		x0 = _mm256_ ## op(_mm256_loadu_ps(x));								\
+		x1 = _mm256_ ## op(_mm256_loadu_ps(x + 8));							\
+		x2 = _mm256_ ## op(_mm256_loadu_ps(x + 16));						\
+		x3 = _mm256_ ## op(_mm256_loadu_ps(x + 24));						\
+		_mm256_storeu_ps(res, x0);											\
+		_mm256_storeu_ps(res + 8, x1);										\
+		_mm256_storeu_ps(res + 16, x2);										\
+		_mm256_storeu_ps(res + 24, x3);										\
+	}																		\
+	n = (N % LONG_UNROLL) / 8;												\
+	for (size_t i = 0; i < n; ++i, x += 8, res += 8)						\
+		_mm256_storeu_ps(res, _mm256_ ## op(_mm256_loadu_ps(x)));			\
+	if (0 != (N % 8) / 4)													\
+		_mm_storeu_ps(res, _mm_ ## op(_mm_loadu_ps(x)));					\
+}
+
+// dot product sum(x * b) = scalar, with 4 independent accumulators to hide the latency of madd
+#define AVX_SUM_FVVS(name, madd, madd4) \
+float name(const float* x, const float* b, size_t N) {	 					\
+	__m256 s0, s1, s2, s3;													\
+	__m128 r, slack;														\
+	s0 = s1 = s2 = s3 = _mm256_setzero_ps();								\
+	size_t n = N / LONG_UNROLL;												\
+	for (size_t i = 0; i < n; ++i, b += LONG_UNROLL, x += LONG_UNROLL) {	\
+		s0 = madd(s0, _mm256_loadu_ps(x), _mm256_loadu_ps(b));				\
+		s1 = madd(s1, _mm256_loadu_ps(x + 8), _mm256_loadu_ps(b + 8));		\
+		s2 = madd(s2, _mm256_loadu_ps(x + 16), _mm256_loadu_ps(b + 16));	\
+		s3 = madd(s3, _mm256_loadu_ps(x + 24), _mm256_loadu_ps(b + 24));	\
+	}																		\
+	s0 = _mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3));		\
+	n = (N % LONG_UNROLL) / 8;												\
+	for (size_t i = 0; i < n; ++i, b += 8, x += 8)							\
+		s0 = madd(s0, _mm256_loadu_ps(x), _mm256_loadu_ps(b));				\
+	r = _mm_add_ps(_mm256_castps256_ps128(s0), _mm256_extractf128_ps(s0, 1));	\
+	if (0 != (N % 8) / 4)													\
+		r = madd4(r, _mm_loadu_ps(x), _mm_loadu_ps(b));						\
+	SSE_HSUM(r, r, slack);													\
+	return _mm_cvtss_f32(r);												\
+}
+
+// single step of Direct-Form II filter, see x86_sse_filter_df2() for the description of the algorithm;
+// both AR- and MA- dot products are accumulated in 2 registers each and reduced only once at the end
+#define AVX_FILTER_DF2(name, madd, madd4) \
+float name(float* w, const float* b, const size_t M, const float* a, const size_t N) {	\
+	float* const ws = w;													\
+	const float b0 = *b;													\
+	__m256 ar0, ar1, ma0, ma1, x0, x1;										\
+	__m128 ar, ma, slack;													\
+	ar0 = ar1 = ma0 = ma1 = _mm256_setzero_ps();							\
+	ar = ma = _mm_setzero_ps();												\
+	size_t L = std::min(N, M);												\
+	size_t n = L / 16;														\
+	for (size_t i = 0; i < n; ++i, a += 16, w += 16, b += 16) {				\
+		x0 = _mm256_loadu_ps(w);											\
+		x1 = _mm256_loadu_ps(w + 8);										\
+		ar0 = madd(ar0, _mm256_loadu_ps(a), x0);							\
+		ma0 = madd(ma0, _mm256_loadu_ps(b), x0);							\
+		ar1 = madd(ar1, _mm256_loadu_ps(a + 8), x1);						\
+		ma1 = madd(ma1, _mm256_loadu_ps(b + 8), x1);						\
+	}																		\
+	if (0 != (L % 16) / 8) {												\
+		x0 = _mm256_loadu_ps(w);											\
+		ar0 = madd(ar0, _mm256_loadu_ps(a), x0);							\
+		ma0 = madd(ma0, _mm256_loadu_ps(b), x0);							\
+		a += 8; w += 8; b += 8;												\
+	}																		\
+	if (0 != (L % 8) / 4) {													\
+		const __m128 x = _mm_loadu_ps(w);									\
+		ar = madd4(ar, _mm_loadu_ps(a), x);									\
+		ma = madd4(ma, _mm_loadu_ps(b), x);									\
+		a += 4; w += 4; b += 4;												\
+	}																		\
+	L = std::max(N, M) - L;													\
+	n = L / 8;																\
+	if (N > M) {															\
+		/* Calculate only the remaining AR-component product */			\
+		for (size_t i = 0; i < n; ++i, a += 8, w += 8)						\
+			ar0 = madd(ar0, _mm256_loadu_ps(a), _mm256_loadu_ps(w));		\
+		if (0 != (L % 8) / 4)												\
+			ar = madd4(ar, _mm_loadu_ps(a), _mm_loadu_ps(w));				\
+	}																		\
+	else {																	\
+		/* Calculate only the remaining MA-component product */			\
+		for (size_t i = 0; i < n; ++i, b += 8, w += 8)						\
+			ma0 = madd(ma0, _mm256_loadu_ps(b), _mm256_loadu_ps(w));		\
+		if (0 != (L % 8) / 4)												\
+			ma = madd4(ma, _mm_loadu_ps(b), _mm_loadu_ps(w));				\
+	}																		\
+	ar0 = _mm256_add_ps(ar0, ar1);											\
+	ma0 = _mm256_add_ps(ma0, ma1);											\
+	ar = _mm_add_ps(ar, _mm_add_ps(_mm256_castps256_ps128(ar0), _mm256_extractf128_ps(ar0, 1)));	\
+	ma = _mm_add_ps(ma, _mm_add_ps(_mm256_castps256_ps128(ma0), _mm256_extractf128_ps(ma0, 1)));	\
+	SSE_HSUM(ar, ar, slack);												\
+	SSE_HSUM(ma, ma, slack);												\
+	const float ardot = _mm_cvtss_f32(ar);									\
+	/* w[0] was multiplied by b[0] before being updated with AR product, correct MA product now */	\
+	*ws -= ardot;															\
+	return _mm_cvtss_f32(ma) - ardot * b0;									\
+}
+
+// single step of cascaded Direct-Form II second-order sections, see x86_sse_filter_sos_df2();
+// AR- and MA- dot products of each section are computed simultaneously and reduced together with hadd,
+// MA product is then corrected for the updated w[0] (nmadd(c, a, b) = c - a * b)
+#define AVX_FILTER_SOS_DF2(name, nmadd) \
+float name(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step) {	\
+	__m128 xx, wx, ax, bx;													\
+	xx = _mm_set_ss(x);	/* xx[0] holds the result between the sections */	\
+	for (size_t i = 0; i < N; ++i, w += step, b += step, a += step, ++scale_only) {	\
+		if (*scale_only) {													\
+			xx = _mm_mul_ss(xx, _mm_load_ss(b));							\
+			continue;														\
+		}																	\
+		wx = _mm_move_ss(_mm_load_ps(w), xx);	/* wx[0] = input of this section */	\
+		ax = _mm_mul_ps(_mm_load_ps(a), wx);								\
+		bx = _mm_mul_ps(_mm_load_ps(b), wx);								\
+		ax = _mm_hadd_ps(ax, bx);											\
+		ax = _mm_hadd_ps(ax, ax);	/* ax = {dot(a, w), dot(b, w), ...} */	\
+		_mm_store_ss(w, _mm_sub_ss(wx, ax));	/* w[0] -= dot(a, w) */		\
+		bx = _mm_shuffle_ps(ax, ax, _MM_SHUFFLE(1, 1, 1, 1));				\
+		xx = nmadd(bx, ax, _mm_load_ss(b));	/* dot(b, w) - dot(a, w) * b[0] */	\
+	}																		\
+	return _mm_cvtss_f32(xx);												\
+}
+
+// block FIR filter, see x86_sse_filter_block_fir(); 32 (8, 4) consecutive output samples are accumulated
+// in separate lanes, each coefficient is broadcast and multiplied by the input window shifted by its index
+#define AVX_FILTER_BLOCK_FIR(name, madd, madd4) \
+void name(float* y, const float* x, size_t L, const float* b, size_t M) {		\
+	__m256 c, y0, y1, y2, y3;												\
+	size_t n = L / 32;														\
+	for (size_t i = 0; i < n; ++i, x += 32, y += 32) {						\
+		y0 = y1 = y2 = y3 = _mm256_setzero_ps();							\
+		for (size_t j = 0; j < M; ++j) {									\
+			const float* w = x - j;											\
+			c = _mm256_broadcast_ss(b + j);									\
+			y0 = madd(y0, c, _mm256_loadu_ps(w));							\
+			y1 = madd(y1, c, _mm256_loadu_ps(w + 8));						\
+			y2 = madd(y2, c, _mm256_loadu_ps(w + 16));						\
+			y3 = madd(y3, c, _mm256_loadu_ps(w + 24));						\
+		}																	\
+		_mm256_storeu_ps(y, y0);											\
+		_mm256_storeu_ps(y + 8, y1);										\
+		_mm256_storeu_ps(y + 16, y2);										\
+		_mm256_storeu_ps(y + 24, y3);										\
+	}																		\
+	n = (L % 32) / 8;														\
+	for (size_t i = 0; i < n; ++i, x += 8, y += 8) {						\
+		y0 = _mm256_setzero_ps();											\
+		for (size_t j = 0; j < M; ++j)										\
+			y0 = madd(y0, _mm256_broadcast_ss(b + j), _mm256_loadu_ps(x - j));	\
+		_mm256_storeu_ps(y, y0);											\
+	}																		\
+	if (0 != (L % 8) / 4) {													\
+		__m128 r = _mm_setzero_ps();										\
+		for (size_t j = 0; j < M; ++j)										\
+			r = madd4(r, _mm_broadcast_ss(b + j), _mm_loadu_ps(x - j));		\
+		_mm_storeu_ps(y, r);												\
+		x += 4; y += 4;														\
+	}																		\
+	n = L % 4;																\
+	for (size_t i = 0; i < n; ++i, ++x, ++y) {								\
+		float r = 0.f;														\
+		for (size_t j = 0; j < M; ++j)										\
+			r += b[j] * *(x - j);											\
+		*y = r;																\
+	}																		\
+}
+
+// single second-order section block filter, see x86_sse_filter_block_biquad(); outputs and the next state
+// are kept in separate 4-element vectors, so that only 2 (fused) multiply-adds depend on the previous state
+#define AVX_FILTER_BLOCK_BIQUAD(name, madd4) \
+void name(float* x, size_t L, float* s, const float* m) {					\
+	const __m128 m0 = _mm_load_ps(m),		m1 = _mm_load_ps(m + 4);			\
+	const __m128 m2 = _mm_load_ps(m + 8),	m3 = _mm_load_ps(m + 12);			\
+	const __m128 m4 = _mm_load_ps(m + 16),	m5 = _mm_load_ps(m + 20);			\
+	const __m128 m6 = _mm_load_ps(m + 24),	m7 = _mm_load_ps(m + 28);			\
+	const __m128 m8 = _mm_load_ps(m + 32),	m9 = _mm_load_ps(m + 36);			\
+	const __m128 m10 = _mm_load_ps(m + 40),	m11 = _mm_load_ps(m + 44);			\
+	__m128 s1 = _mm_broadcast_ss(s), s2 = _mm_broadcast_ss(s + 1), x0, y, z;	\
+	size_t n = L / 4;														\
+	for (size_t i = 0; i < n; ++i, x += 4) {								\
+		x0 = _mm_broadcast_ss(x);											\
+		y = _mm_mul_ps(m0, x0);												\
+		z = _mm_mul_ps(m1, x0);												\
+		x0 = _mm_broadcast_ss(x + 1);										\
+		y = madd4(y, m2, x0);												\
+		z = madd4(z, m3, x0);												\
+		x0 = _mm_broadcast_ss(x + 2);										\
+		y = madd4(y, m4, x0);												\
+		z = madd4(z, m5, x0);												\
+		x0 = _mm_broadcast_ss(x + 3);										\
+		y = madd4(y, m6, x0);												\
+		z = madd4(z, m7, x0);												\
+		y = madd4(madd4(y, m8, s1), m10, s2);								\
+		z = madd4(madd4(z, m9, s1), m11, s2);								\
+		_mm_storeu_ps(x, y);												\
+		s1 = _mm_permute_ps(z, _MM_SHUFFLE(0, 0, 0, 0));					\
+		s2 = _mm_permute_ps(z, _MM_SHUFFLE(1, 1, 1, 1));					\
+	}																		\
+	_mm_store_ss(s, s1);													\
+	_mm_store_ss(s + 1, s2);												\
+	/* trailing samples in Transposed Direct-Form II, m[48 ... 53] = {b0, b1, b2, 1, a1, a2} */	\
+	n = L % 4;																\
+	for (size_t i = 0; i < n; ++i, ++x) {									\
+		const float y = m[48] * *x + s[0];									\
+		s[0] = m[49] * *x - m[52] * y + s[1];								\
+		s[1] = m[50] * *x - m[53] * y;										\
+		*x = y;																\
+	}																		\
+}
+
+// Transposed Direct-Form II filter, see x86_sse_filter_tdf2(); state updated 8 elements at a time
+#define AVX_FILTER_TDF2(name, madd, nmadd) \
+float name(float x, float* s, const float* b, const size_t M, const float* a, const size_t N) {	\
+	const float y = b[0] * x + s[0];										\
+	const __m256 xx = _mm256_set1_ps(x), yy = _mm256_set1_ps(y);			\
+	const size_t L = std::min(M, N);										\
+	size_t i = 1;															\
+	for (; i + 8 <= L; i += 8) {											\
+		const __m256 r = madd(_mm256_loadu_ps(s + i), _mm256_loadu_ps(b + i), xx);	\
+		_mm256_storeu_ps(s + i - 1, nmadd(r, _mm256_loadu_ps(a + i), yy));	\
+	}																		\
+	for (; i < L; ++i)														\
+		s[i - 1] = s[i] + b[i] * x - a[i] * y;								\
+	for (; i + 8 <= M; i += 8)												\
+		_mm256_storeu_ps(s + i - 1, madd(_mm256_loadu_ps(s + i), _mm256_loadu_ps(b + i), xx));	\
+	for (; i < M; ++i)														\
+		s[i - 1] = s[i] + b[i] * x;											\
+	for (; i + 8 <= N; i += 8)												\
+		_mm256_storeu_ps(s + i - 1, nmadd(_mm256_loadu_ps(s + i), _mm256_loadu_ps(a + i), yy));	\
+	for (; i < N; ++i)														\
+		s[i - 1] = s[i] - a[i] * y;											\
+	return y;																\
+}
+
+// multichannel cascade of second-order sections, see x86_sse_filter_sos_lanes(); 8 channels at a time,
+// remaining 4 (C is a multiple of 4) with 4-element vectors
+#define AVX_FILTER_SOS_LANES(name, madd, nmadd, madd4, nmadd4) \
+void name(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s) {	\
+	for (size_t j = 0; j < N; ++j, c += 8, s += 2 * C) {					\
+		const __m256 b0 = _mm256_broadcast_ss(c), b1 = _mm256_broadcast_ss(c + 1);	\
+		const __m256 b2 = _mm256_broadcast_ss(c + 2);						\
+		const __m256 a1 = _mm256_broadcast_ss(c + 3), a2 = _mm256_broadcast_ss(c + 4);	\
+		size_t k = 0;														\
+		for (; k + 8 <= C; k += 8) {										\
+			__m256 s1 = _mm256_loadu_ps(s + k), s2 = _mm256_loadu_ps(s + C + k), in, y;	\
+			float* p = x + k;												\
+			for (size_t n = 0; n < L; ++n, p += stride) {					\
+				in = _mm256_loadu_ps(p);									\
+				y = madd(s1, b0, in);										\
+				s1 = nmadd(madd(s2, b1, in), a1, y);						\
+				s2 = nmadd(_mm256_mul_ps(b2, in), a2, y);					\
+				_mm256_storeu_ps(p, y);										\
+			}																\
+			_mm256_storeu_ps(s + k, s1);									\
+			_mm256_storeu_ps(s + C + k, s2);								\
+		}																	\
+		if (k != C) {														\
+			const __m128 b04 = _mm256_castps256_ps128(b0), b14 = _mm256_castps256_ps128(b1);	\
+			const __m128 b24 = _mm256_castps256_ps128(b2);					\
+			const __m128 a14 = _mm256_castps256_ps128(a1), a24 = _mm256_castps256_ps128(a2);	\
+			__m128 s1 = _mm_loadu_ps(s + k), s2 = _mm_loadu_ps(s + C + k), in, y;	\
+			float* p = x + k;												\
+			for (size_t n = 0; n < L; ++n, p += stride) {					\
+				in = _mm_loadu_ps(p);										\
+				y = madd4(s1, b04, in);										\
+				s1 = nmadd4(madd4(s2, b14, in), a14, y);					\
+				s2 = nmadd4(_mm_mul_ps(b24, in), a24, y);					\
+				_mm_storeu_ps(p, y);										\
+			}																\
+			_mm_storeu_ps(s + k, s1);										\
+			_mm_storeu_ps(s + C + k, s2);									\
+		}																	\
+	}																		\
+}
+
+#endif /* DSP_AVX_UTILS_H_INCLUDED */
@@ -12,7 +12,17 @@
 #endif // _MSC_VER
 
 #ifdef __GNUC__
-# if (defined(__pic__) || defined(__APPLE__))
+# if (defined(__pic__) || defined(__APPLE__)) && defined(DSP_ARCH_X86_64)
+// preserve the whole rbx register, saving just ebx would clobber its upper half
+static __inline void __cpuid(int cpu_info[4], int info_type) {
+  asm volatile (
+    "mov %%rbx, %%rdi                          \n"
+    "cpuid                                     \n"
+    "xchg %%rdi, %%rbx                         \n"
+    : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]), "=d"(cpu_info[3])
+    : "a"(info_type));
+}
+# elif (defined(__pic__) || defined(__APPLE__))
 static __inline void __cpuid(int cpu_info[4], int info_type) {
   asm volatile (
     "mov %%ebx, %%edi                          \n"
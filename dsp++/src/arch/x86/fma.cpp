@@ -0,0 +1,28 @@
+#include <dsp++/platform.h>
+#include <dsp++/config.h>
+
+#if defined(DSP_ARCH_FAMILY_X86) && !DSP_SIMD_AVX_DISABLED
+
+#include <algorithm>
+#include <dsp++/simd.h>
+#include "avx.h"
+#include "avx_utils.h"
+
+#include <immintrin.h>
+
+//! @brief Dot product using AVX and FMA3 instruction sets.
+AVX_SUM_FVVS(dsp::simd::detail::x86_fma_dotf, FMA_MADD, FMA_MADD4)
+
+AVX_FILTER_DF2(dsp::simd::detail::x86_fma_filter_df2, FMA_MADD, FMA_MADD4)
+
+AVX_FILTER_TDF2(dsp::simd::detail::x86_fma_filter_tdf2, FMA_MADD, FMA_NMADD)
+
+AVX_FILTER_SOS_DF2(dsp::simd::detail::x86_fma_filter_sos_df2, FMA_NMADD_SS)
+
+AVX_FILTER_BLOCK_FIR(dsp::simd::detail::x86_fma_filter_block_fir, FMA_MADD, FMA_MADD4)
+
+AVX_FILTER_BLOCK_BIQUAD(dsp::simd::detail::x86_fma_filter_block_biquad, FMA_MADD4)
+
+AVX_FILTER_SOS_LANES(dsp::simd::detail::x86_fma_filter_sos_lanes, FMA_MADD, FMA_NMADD, FMA_MADD4, FMA_NMADD4)
+
+#endif // DSP_ARCH_FAMILY_X86 && !DSP_SIMD_AVX_DISABLED
@@ -109,7 +109,7 @@ SSE_FVV(dsp::simd::detail::x86_sse_sqrtf, sqrt_ps)
 
 SSE_FVV(dsp::simd::detail::x86_sse_rcpf, rcp_ps)
 
-SSE_FVV(dsp::simd::detail::x86_sse_rsqrtf, rcp_ps)
+SSE_FVV(dsp::simd::detail::x86_sse_rsqrtf, rsqrt_ps)
 
 //! @brief Piecewise complex vector multiplication using SSE instructions
 void dsp::simd::detail::x86_sse_mulcf(std::complex<float>* res_c, const std::complex<float>* a_c, const std::complex<float>* b_c, size_t len)
@@ -130,6 +130,7 @@ void dsp::simd::detail::x86_sse_mulcf(std::complex<float>* res_c, const std::com
 		x2 = _mm_shuffle_ps(x2, x1, 0xA0);
 		x1 = _mm_shuffle_ps(x1, x1, 0xF5);
 		x3 = _mm_shuffle_ps(x3, x0, 0xB1);
+		x0 = _mm_mul_ps(x0, x2);
 		x3 = _mm_mul_ps(x3, x1);
 		x3 = _mm_mul_ps(x3, x4);
 		x0 = _mm_add_ps(x0, x3);
@@ -275,6 +276,134 @@ float dsp::simd::detail::x86_sse_filter_sos_df2(float x, size_t N, const bool* s
 	return _mm_cvtss_f32(xx);
 }
 
+void dsp::simd::detail::x86_sse_filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M)
+{
+	// Each coefficient is broadcast and multiplied by the input window shifted by its index, so that
+	// consecutive output samples are accumulated in separate lanes and no horizontal sum is needed.
+	__m128 c, y0, y1, y2, y3;
+	size_t n = L / 16;
+	for (size_t i = 0; i < n; ++i, x += 16, y += 16) {
+		y0 = y1 = y2 = y3 = _mm_setzero_ps();
+		for (size_t j = 0; j < M; ++j) {
+			const float* w = x - j;
+			c = _mm_load1_ps(b + j);
+			y0 = _mm_add_ps(y0, _mm_mul_ps(c, _mm_loadu_ps(w)));
+			y1 = _mm_add_ps(y1, _mm_mul_ps(c, _mm_loadu_ps(w + 4)));
+			y2 = _mm_add_ps(y2, _mm_mul_ps(c, _mm_loadu_ps(w + 8)));
+			y3 = _mm_add_ps(y3, _mm_mul_ps(c, _mm_loadu_ps(w + 12)));
+		}
+		_mm_storeu_ps(y, y0);
+		_mm_storeu_ps(y + 4, y1);
+		_mm_storeu_ps(y + 8, y2);
+		_mm_storeu_ps(y + 12, y3);
+	}
+	n = (L % 16) / 4;
+	for (size_t i = 0; i < n; ++i, x += 4, y += 4) {
+		y0 = _mm_setzero_ps();
+		for (size_t j = 0; j < M; ++j)
+			y0 = _mm_add_ps(y0, _mm_mul_ps(_mm_load1_ps(b + j), _mm_loadu_ps(x - j)));
+		_mm_storeu_ps(y, y0);
+	}
+	n = L % 4;
+	for (size_t i = 0; i < n; ++i, ++x, ++y) {
+		float r = 0.f;
+		for (size_t j = 0; j < M; ++j)
+			r += b[j] * *(x - j);
+		*y = r;
+	}
+}
+
+void dsp::simd::detail::x86_sse_filter_block_biquad(float* x, size_t L, float* s, const float* m)
+{
+	// 4 output samples (lo) and the state after them (hi) are linear combinations of 4 input samples and
+	// the state before them, only the state part depends on the previous iteration.
+	const __m128 m0 = _mm_load_ps(m),		m1 = _mm_load_ps(m + 4);
+	const __m128 m2 = _mm_load_ps(m + 8),	m3 = _mm_load_ps(m + 12);
+	const __m128 m4 = _mm_load_ps(m + 16),	m5 = _mm_load_ps(m + 20);
+	const __m128 m6 = _mm_load_ps(m + 24),	m7 = _mm_load_ps(m + 28);
+	const __m128 m8 = _mm_load_ps(m + 32),	m9 = _mm_load_ps(m + 36);
+	const __m128 m10 = _mm_load_ps(m + 40),	m11 = _mm_load_ps(m + 44);
+	__m128 s1 = _mm_load1_ps(s), s2 = _mm_load1_ps(s + 1), x0, y, z;
+	size_t n = L / 4;
+	for (size_t i = 0; i < n; ++i, x += 4) {
+		x0 = _mm_load1_ps(x);
+		y = _mm_mul_ps(m0, x0);
+		z = _mm_mul_ps(m1, x0);
+		x0 = _mm_load1_ps(x + 1);
+		y = _mm_add_ps(y, _mm_mul_ps(m2, x0));
+		z = _mm_add_ps(z, _mm_mul_ps(m3, x0));
+		x0 = _mm_load1_ps(x + 2);
+		y = _mm_add_ps(y, _mm_mul_ps(m4, x0));
+		z = _mm_add_ps(z, _mm_mul_ps(m5, x0));
+		x0 = _mm_load1_ps(x + 3);
+		y = _mm_add_ps(y, _mm_mul_ps(m6, x0));
+		z = _mm_add_ps(z, _mm_mul_ps(m7, x0));
+		y = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(m8, s1), _mm_mul_ps(m10, s2)));
+		z = _mm_add_ps(z, _mm_add_ps(_mm_mul_ps(m9, s1), _mm_mul_ps(m11, s2)));
+		_mm_storeu_ps(x, y);
+		s1 = _mm_shuffle_ps(z, z, _MM_SHUFFLE(0, 0, 0, 0));
+		s2 = _mm_shuffle_ps(z, z, _MM_SHUFFLE(1, 1, 1, 1));
+	}
+	_mm_store_ss(s, s1);
+	_mm_store_ss(s + 1, s2);
+	// trailing samples in Transposed Direct-Form II, m[48 ... 53] = {b0, b1, b2, 1, a1, a2}
+	n = L % 4;
+	for (size_t i = 0; i < n; ++i, ++x) {
+		const float y = m[48] * *x + s[0];
+		s[0] = m[49] * *x - m[52] * y + s[1];
+		s[1] = m[50] * *x - m[53] * y;
+		*x = y;
+	}
+}
+
+float dsp::simd::detail::x86_sse_filter_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N)
+{
+	const float y = b[0] * x + s[0];
+	const __m128 xx = _mm_set1_ps(x), yy = _mm_set1_ps(y);
+	const size_t L = std::min(M, N);
+	size_t i = 1;
+	// s[i - 1] = s[i] + b[i] * x - a[i] * y; each chunk reads the state before it is overwritten by the next one
+	for (; i + 4 <= L; i += 4) {
+		__m128 r = _mm_add_ps(_mm_loadu_ps(s + i), _mm_mul_ps(_mm_loadu_ps(b + i), xx));
+		r = _mm_sub_ps(r, _mm_mul_ps(_mm_loadu_ps(a + i), yy));
+		_mm_storeu_ps(s + i - 1, r);
+	}
+	for (; i < L; ++i)
+		s[i - 1] = s[i] + b[i] * x - a[i] * y;
+	for (; i + 4 <= M; i += 4)
+		_mm_storeu_ps(s + i - 1, _mm_add_ps(_mm_loadu_ps(s + i), _mm_mul_ps(_mm_loadu_ps(b + i), xx)));
+	for (; i < M; ++i)
+		s[i - 1] = s[i] + b[i] * x;
+	for (; i + 4 <= N; i += 4)
+		_mm_storeu_ps(s + i - 1, _mm_sub_ps(_mm_loadu_ps(s + i), _mm_mul_ps(_mm_loadu_ps(a + i), yy)));
+	for (; i < N; ++i)
+		s[i - 1] = s[i] - a[i] * y;
+	return y;
+}
+
+void dsp::simd::detail::x86_sse_filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s)
+{
+	// Each section is applied to all the frames before moving to the next one, so that its coefficients
+	// and state stay in registers; coefficients of consecutive sections are sos_lanes_length (8) apart.
+	for (size_t j = 0; j < N; ++j, c += 8, s += 2 * C) {
+		const __m128 b0 = _mm_load1_ps(c), b1 = _mm_load1_ps(c + 1), b2 = _mm_load1_ps(c + 2);
+		const __m128 a1 = _mm_load1_ps(c + 3), a2 = _mm_load1_ps(c + 4);
+		for (size_t k = 0; k < C; k += 4) {
+			__m128 s1 = _mm_loadu_ps(s + k), s2 = _mm_loadu_ps(s + C + k), in, y;
+			float* p = x + k;
+			for (size_t n = 0; n < L; ++n, p += stride) {
+				in = _mm_loadu_ps(p);
+				y = _mm_add_ps(_mm_mul_ps(b0, in), s1);
+				s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, in), _mm_mul_ps(a1, y)), s2);
+				s2 = _mm_sub_ps(_mm_mul_ps(b2, in), _mm_mul_ps(a2, y));
+				_mm_storeu_ps(p, y);
+			}
+			_mm_storeu_ps(s + k, s1);
+			_mm_storeu_ps(s + C + k, s2);
+		}
+	}
+}
+
 float dsp::simd::detail::x86_sse_accf(const float* x, size_t N)
 {
 	__m128 x0, x1, x2, x3, x4, x5, x6, r;
@@ -306,4 +435,62 @@ float dsp::simd::detail::x86_sse_accf(const float* x, size_t N)
 	return _mm_cvtss_f32(r);
 }
 
+// multiply 2 pairs of complex numbers (re, im, re, im)
+static inline __m128 sse_mulc2(__m128 a, __m128 b, __m128 sign_even)
+{
+	const __m128 br = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0));
+	const __m128 bi = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 1, 1));
+	const __m128 as = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+	return _mm_add_ps(_mm_mul_ps(a, br), _mm_xor_ps(_mm_mul_ps(as, bi), sign_even));
+}
+
+// multiply 2 complex numbers by -i
+static inline __m128 sse_mul_minus_i2(__m128 a, __m128 sign_odd)
+{
+	return _mm_xor_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), sign_odd);
+}
+
+//! @brief Radix-2 decimation-in-time FFT stage using SSE instructions, 2 butterflies at a time.
+void dsp::simd::detail::x86_sse_fft_radix2f(std::complex<float>* x_c, size_t m, size_t count, const std::complex<float>* w_c)
+{
+	float* x = reinterpret_cast<float*>(x_c);
+	const float* w = reinterpret_cast<const float*>(w_c);
+	const __m128 sign_even = _mm_setr_ps(-0.f, 0.f, -0.f, 0.f);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 2 * m2) {
+		for (size_t j = 0; j < m2; j += 4) {
+			const __m128 a0 = _mm_loadu_ps(x + j);
+			const __m128 a1 = sse_mulc2(_mm_loadu_ps(x + m2 + j), _mm_loadu_ps(w + j), sign_even);
+			_mm_storeu_ps(x + j, _mm_add_ps(a0, a1));
+			_mm_storeu_ps(x + m2 + j, _mm_sub_ps(a0, a1));
+		}
+	}
+}
+
+//! @brief Radix-4 decimation-in-time FFT stage using SSE instructions, 2 butterflies at a time.
+void dsp::simd::detail::x86_sse_fft_radix4f(std::complex<float>* x_c, size_t m, size_t count, const std::complex<float>* w_c)
+{
+	float* x = reinterpret_cast<float*>(x_c);
+	const float* w = reinterpret_cast<const float*>(w_c);
+	const __m128 sign_even = _mm_setr_ps(-0.f, 0.f, -0.f, 0.f);
+	const __m128 sign_odd = _mm_setr_ps(0.f, -0.f, 0.f, -0.f);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 4 * m2) {
+		for (size_t j = 0; j < m2; j += 4) {
+			const __m128 a0 = _mm_loadu_ps(x + j);
+			const __m128 a1 = sse_mulc2(_mm_loadu_ps(x + 2 * m2 + j), _mm_loadu_ps(w + j), sign_even);
+			const __m128 a2 = sse_mulc2(_mm_loadu_ps(x + m2 + j), _mm_loadu_ps(w + m2 + j), sign_even);
+			const __m128 a3 = sse_mulc2(_mm_loadu_ps(x + 3 * m2 + j), _mm_loadu_ps(w + 2 * m2 + j), sign_even);
+			const __m128 t0 = _mm_add_ps(a0, a2);
+			const __m128 t1 = _mm_sub_ps(a0, a2);
+			const __m128 t2 = _mm_add_ps(a1, a3);
+			const __m128 t3 = sse_mul_minus_i2(_mm_sub_ps(a1, a3), sign_odd);
+			_mm_storeu_ps(x + j, _mm_add_ps(t0, t2));
+			_mm_storeu_ps(x + m2 + j, _mm_add_ps(t1, t3));
+			_mm_storeu_ps(x + 2 * m2 + j, _mm_sub_ps(t0, t2));
+			_mm_storeu_ps(x + 3 * m2 + j, _mm_sub_ps(t1, t3));
+		}
+	}
+}
+
 #endif // DSP_ARCH_FAMILY_X86
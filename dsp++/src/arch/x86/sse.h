@@ -38,6 +38,10 @@ void x86_sse_rcpf(float* res, const float* a, size_t len);
 
 void x86_sse_rsqrtf(float* res, const float* a, size_t len);
 
+void x86_sse2_log2f(float* res, const float* a, size_t len);
+
+void x86_sse2_exp2f(float* res, const float* a, size_t len);
+
 std::complex<float> x86_sse_dotcf(const std::complex<float>* a, const std::complex<float>* b, size_t len);
 
 /*!
@@ -54,6 +58,61 @@ std::complex<float> x86_sse_dotcf(const std::complex<float>* a, const std::compl
 float x86_sse_filter_df2(float* w, const float* b, const size_t M, const float* a, const size_t N);
 float x86_sse41_filter_df2(float* w, const float* b, const size_t M, const float* a, const size_t N);
 
+/*!
+ * @brief Implementation of Transposed Direct-Form II FIR/IIR filter using SSE instruction set, updating 4 state elements at once.
+ * @param x Input sample.
+ * @param s Filter state of length max(M, N), needs not to be aligned.
+ * @param b FIR filter coefficients vector (M), needs not to be aligned.
+ * @param M Length of b vector.
+ * @param a IIR filter coefficients vector (N), needs not to be aligned, a[0] is ignored.
+ * @param N Length of a vector.
+ * @return filtered sample.
+ * @see dsp::simd::filter_sample_tdf2()
+ */
+float x86_sse_filter_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N);
+
+/*!
+ * @brief Implementation of block FIR filter using SSE instruction set, computing 16 (4) consecutive output samples at once.
+ * @param y Output vector (L), needs not to be aligned.
+ * @param x Input vector (L) preceded by M - 1 past input samples, needs not to be aligned.
+ * @param L Number of samples to filter.
+ * @param b FIR filter coefficients vector (M), needs not to be aligned.
+ * @param M Number of FIR filter coefficients.
+ * @see dsp::simd::filter_block_fir()
+ */
+void x86_sse_filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M);
+
+/*!
+ * @brief Implementation of single second-order section block filter using SSE instruction set.
+ * @param x Block of samples filtered in place (L), needs not to be aligned.
+ * @param L Number of samples in the block.
+ * @param s Transposed Direct-Form II section state (2).
+ * @param m State-space coefficients prepared with dsp::simd::biquad_block_coeffs(), must be aligned.
+ * @see dsp::simd::filter_block_biquad()
+ */
+void x86_sse_filter_block_biquad(float* x, size_t L, float* s, const float* m);
+
+/*!
+ * @brief Implementation of multichannel cascade of second-order sections using SSE instruction set, with 4 channels in vector lanes.
+ * @see dsp::simd::filter_sos_lanes() for the description of parameters.
+ */
+void x86_sse_filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s);
+
+/*!
+ * @brief Single decimation-in-time radix-2 (radix-4) FFT stage, combining count pairs (quads) of m-point
+ * DFTs stored contiguously in x into 2m-point (4m-point) DFTs.
+ * @param x transformed data, needs not to be aligned (we use unaligned reads here).
+ * @param m length of sub-transforms combined by this stage, must be even for float versions.
+ * @param count number of butterfly blocks in the stage.
+ * @note The m-point DFTs combined by radix-4 stage are expected in bit-reversed order, that is DFTs of
+ * subsequences with residues 0, 2, 1, 3 (mod 4).
+ * @param w twiddle factors of this stage: w^(j), w^(2j), w^(3j) for j = 0..m-1, each of them contiguous (m elements).
+ */
+void x86_sse_fft_radix2f(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+void x86_sse_fft_radix4f(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+void x86_sse3_fft_radix2d(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+void x86_sse3_fft_radix4d(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+
 } } }
 
 #endif /* DSP_INTERNAL_X86_SSE_H_INCLUDED */
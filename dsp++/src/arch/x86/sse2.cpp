@@ -0,0 +1,89 @@
+#include <dsp++/platform.h>
+
+#ifdef DSP_ARCH_FAMILY_X86
+
+#include <dsp++/simd.h>
+#include "sse.h"
+
+#include <emmintrin.h>
+
+// Polynomial approximations of logf() and exp2f() after Cephes Math Library by Stephen L. Moshier, evaluated
+// on 4 elements at once. Both are accurate to 1 ulp over the range of normalized floats.
+
+static inline __m128 sse2_log2(__m128 x)
+{
+	const __m128 min_norm = _mm_castsi128_ps(_mm_set1_epi32(0x00800000));
+	const __m128i mant_mask = _mm_set1_epi32(0x007fffff);
+	const __m128i half_exp = _mm_set1_epi32(0x3f000000);
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 sqrthf = _mm_set1_ps(0.707106781186547524f);
+
+	// split x into exponent e and mantissa m in [0.5, 1), non-positive and denormal values are clamped
+	x = _mm_max_ps(x, min_norm);
+	__m128i xi = _mm_castps_si128(x);
+	__m128 e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(xi, 23), _mm_set1_epi32(126)));
+	__m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(xi, mant_mask), half_exp));
+
+	// move m to [sqrt(0.5), sqrt(2)) so that the polynomial is evaluated around log(1) = 0
+	__m128 lt = _mm_cmplt_ps(m, sqrthf);
+	e = _mm_sub_ps(e, _mm_and_ps(one, lt));
+	m = _mm_sub_ps(_mm_add_ps(m, _mm_and_ps(m, lt)), one);
+
+	__m128 z = _mm_mul_ps(m, m);
+	__m128 y = _mm_set1_ps(7.0376836292e-2f);
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.1514610310e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.1676998740e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.2420140846e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(1.4249322787e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-1.6668057665e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(2.0000714765e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(-2.4999993993e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, m), _mm_set1_ps(3.3333331174e-1f));
+	y = _mm_mul_ps(_mm_mul_ps(y, m), z);
+	y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+
+	// log(1 + m) = m + y, convert to base 2 and add the exponent (exactly representable)
+	y = _mm_mul_ps(_mm_add_ps(m, y), _mm_set1_ps(1.44269504088896341f));
+	return _mm_add_ps(y, e);
+}
+
+static inline __m128 sse2_exp2(__m128 x)
+{
+	// saturate the result at the range of normalized floats
+	x = _mm_min_ps(x, _mm_set1_ps(127.f));
+	x = _mm_max_ps(x, _mm_set1_ps(-126.f));
+
+	// split x into integer n and fraction f in [-0.5, 0.5] (cvtps2dq rounds to nearest)
+	__m128i n = _mm_cvtps_epi32(x);
+	__m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(n));
+
+	__m128 y = _mm_set1_ps(1.535336188319500e-4f);
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(1.339887440266574e-3f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(9.618437357674640e-3f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(5.550332471162809e-2f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(2.402264791363012e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(6.931472028550421e-1f));
+	y = _mm_add_ps(_mm_mul_ps(y, f), _mm_set1_ps(1.f));
+
+	// scale by 2^n built directly in the exponent field
+	__m128 p = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+	return _mm_mul_ps(y, p);
+}
+
+// NOTE: unlike SSE_FVV() kernels these process the trailing (len % 4) elements too, within the padding.
+
+//! @brief Base-2 logarithm of vector elements using polynomial approximation and SSE2 instructions.
+void dsp::simd::detail::x86_sse2_log2f(float* res, const float* a, size_t len)
+{
+	for (size_t i = 0; i < len; i += 4)
+		_mm_store_ps(res + i, sse2_log2(_mm_load_ps(a + i)));
+}
+
+//! @brief Base-2 exponential of vector elements using polynomial approximation and SSE2 instructions.
+void dsp::simd::detail::x86_sse2_exp2f(float* res, const float* a, size_t len)
+{
+	for (size_t i = 0; i < len; i += 4)
+		_mm_store_ps(res + i, sse2_exp2(_mm_load_ps(a + i)));
+}
+
+#endif // DSP_ARCH_FAMILY_X86
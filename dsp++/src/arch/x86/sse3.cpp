@@ -11,4 +11,60 @@
 //! @brief Dot product using SSE3 instruction set.
 SSE3_SUM_FVVS(dsp::simd::detail::x86_sse3_dotf, mul_ps)
 
+// multiply complex numbers (re, im)
+static inline __m128d sse3_mulc(__m128d a, __m128d b)
+{
+	const __m128d br = _mm_movedup_pd(b);
+	const __m128d bi = _mm_unpackhi_pd(b, b);
+	const __m128d as = _mm_shuffle_pd(a, a, 1);
+	return _mm_addsub_pd(_mm_mul_pd(a, br), _mm_mul_pd(as, bi));
+}
+
+// multiply complex number by -i
+static inline __m128d sse3_mul_minus_i(__m128d a, __m128d sign_odd)
+{
+	return _mm_xor_pd(_mm_shuffle_pd(a, a, 1), sign_odd);
+}
+
+//! @brief Radix-2 decimation-in-time FFT stage using SSE3 instructions.
+void dsp::simd::detail::x86_sse3_fft_radix2d(std::complex<double>* x_c, size_t m, size_t count, const std::complex<double>* w_c)
+{
+	double* x = reinterpret_cast<double*>(x_c);
+	const double* w = reinterpret_cast<const double*>(w_c);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 2 * m2) {
+		for (size_t j = 0; j < m2; j += 2) {
+			const __m128d a0 = _mm_loadu_pd(x + j);
+			const __m128d a1 = sse3_mulc(_mm_loadu_pd(x + m2 + j), _mm_loadu_pd(w + j));
+			_mm_storeu_pd(x + j, _mm_add_pd(a0, a1));
+			_mm_storeu_pd(x + m2 + j, _mm_sub_pd(a0, a1));
+		}
+	}
+}
+
+//! @brief Radix-4 decimation-in-time FFT stage using SSE3 instructions.
+void dsp::simd::detail::x86_sse3_fft_radix4d(std::complex<double>* x_c, size_t m, size_t count, const std::complex<double>* w_c)
+{
+	double* x = reinterpret_cast<double*>(x_c);
+	const double* w = reinterpret_cast<const double*>(w_c);
+	const __m128d sign_odd = _mm_setr_pd(0., -0.);
+	const size_t m2 = 2 * m;
+	for (size_t b = 0; b < count; ++b, x += 4 * m2) {
+		for (size_t j = 0; j < m2; j += 2) {
+			const __m128d a0 = _mm_loadu_pd(x + j);
+			const __m128d a1 = sse3_mulc(_mm_loadu_pd(x + 2 * m2 + j), _mm_loadu_pd(w + j));
+			const __m128d a2 = sse3_mulc(_mm_loadu_pd(x + m2 + j), _mm_loadu_pd(w + m2 + j));
+			const __m128d a3 = sse3_mulc(_mm_loadu_pd(x + 3 * m2 + j), _mm_loadu_pd(w + 2 * m2 + j));
+			const __m128d t0 = _mm_add_pd(a0, a2);
+			const __m128d t1 = _mm_sub_pd(a0, a2);
+			const __m128d t2 = _mm_add_pd(a1, a3);
+			const __m128d t3 = sse3_mul_minus_i(_mm_sub_pd(a1, a3), sign_odd);
+			_mm_storeu_pd(x + j, _mm_add_pd(t0, t2));
+			_mm_storeu_pd(x + m2 + j, _mm_add_pd(t1, t3));
+			_mm_storeu_pd(x + 2 * m2 + j, _mm_sub_pd(t0, t2));
+			_mm_storeu_pd(x + 3 * m2 + j, _mm_sub_pd(t1, t3));
+		}
+	}
+}
+
 #endif // DSP_ARCH_FAMILY_X86
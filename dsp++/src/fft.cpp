@@ -18,109 +18,54 @@
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
 #include <dsp++/pow2.h>
 #include <dsp++/const.h>
+#include <dsp++/simd.h>
+#include <dsp++/simd_kernels.h>
 
-namespace {
-
-	////// template class sin_cos_series
-// common series to compile-time calculation
-// of sine and cosine functions
-template<unsigned M, unsigned N, unsigned B, unsigned A>
-struct sin_cos_series
-{
-	static double value()
-	{
-		return 1 - (A * DSP_M_PI / B) * (A * DSP_M_PI / B) / M / (M + 1) * sin_cos_series<M + 2, N, B, A>::value();
-	}
-};
+#include "simd.h"
 
-template<unsigned N, unsigned B, unsigned A>
-struct sin_cos_series<N, N, B, A>
-{
-	static double value()
-	{
-		return 1.;
-	}
-};
+#ifdef DSP_ARCH_FAMILY_X86
+#include "arch/x86/sse.h"
+#include "arch/x86/avx.h"
+#endif // DSP_ARCH_FAMILY_X86
 
-////// template class sin
-// compile-time calculation of sin(A*M_PI/B) function
-template<unsigned B, unsigned A, typename T = double>
-struct sin;
-
-template<unsigned B, unsigned A>
-struct sin<B, A, float>
-{
-	static float value()
-	{
-		return static_cast<float>((A * DSP_M_PI / B) * sin_cos_series < 2, 24, B, A > ::value());
-	}
-};
-template<unsigned B, unsigned A>
-struct sin<B, A, double>
-{
-	static double value()
-	{
-		return (A * DSP_M_PI / B) * sin_cos_series < 2, 34, B, A > ::value();
-	}
-};
+#ifdef DSP_ARCH_FAMILY_ARM
+#include "arch/arm/neon.h"
+#endif // DSP_ARCH_FAMILY_ARM
 
-////// template class cos
-// compile-time calculation of cos(A*M_PI/B) function
-template<unsigned B, unsigned A, typename T = double>
-struct cos;
-
-template<unsigned B, unsigned A>
-struct cos<B, A, float>
-{
-	static float value()
-	{
-		return sin_cos_series < 1, 23, B, A > ::value();
-	}
-};
-template<unsigned B, unsigned A>
-struct cos<B, A, double>
-{
-	static double value()
-	{
-		return sin_cos_series < 1, 33, B, A > ::value();
-	}
-};
+namespace {
 
 ////// template class danielson_lanczos
 // Danielson-Lanczos section of the FFT
+// tw holds twiddle factors of all the sections, these of N-point one: exp(-2*pi*i*k/N), k = 0..N/2-1
+// are stored at offset N/2-1 (see fft_impl::init()).
 template<unsigned N, typename T = double>
 class danielson_lanczos
 {
 	danielson_lanczos<N / 2, T> next_;
 public:
-	void apply(T* data) const
+	void apply(T* data, const std::complex<T>* tw) const
 	{
-		next_.apply(data);
-		next_.apply(data + N);
-
-		T wtemp, tempr, tempi, wr, wi, wpr, wpi;
-		//    Change dynamic calculation to the static one
-		//      wtemp = sin(M_PI/N);
-		wtemp = -sin < N, 1, T > ::value();
-		wpr = static_cast<T>(-2) * wtemp * wtemp;
-		//      wpi = -sin(2*M_PI/N);
-		wpi = -sin < N, 2, T > ::value();
-		wr = 1.0;
-		wi = 0.0;
+		next_.apply(data, tw);
+		next_.apply(data + N, tw);
+
+		const T* w = reinterpret_cast<const T*>(tw + (N / 2 - 1));
+		T tempr, tempi;
 		for (unsigned i = 0; i < N; i += 2)
 		{
+			const T wr = w[i], wi = w[i + 1];
 			tempr = data[i + N] * wr - data[i + N + 1] * wi;
 			tempi = data[i + N] * wi + data[i + N + 1] * wr;
 			data[i + N] = data[i] - tempr;
 			data[i + N + 1] = data[i + 1] - tempi;
 			data[i] += tempr;
 			data[i + 1] += tempi;
-
-			wtemp = wr;
-			wr += wr * wpr - wi * wpi;
-			wi += wi * wpr + wtemp * wpi;
 		}
 	}
 };
@@ -129,7 +74,7 @@ template<typename T>
 class danielson_lanczos<4, T>
 {
 public:
-	void apply(T* data) const
+	void apply(T* data, const std::complex<T>*) const
 	{
 		T tr = data[2];
 		T ti = data[3];
@@ -163,7 +108,7 @@ template<typename T>
 class danielson_lanczos<2, T>
 {
 public:
-	void apply(T* data) const
+	void apply(T* data, const std::complex<T>*) const
 	{
 		T tr = data[2];
 		T ti = data[3];
@@ -174,6 +119,125 @@ public:
 	}
 };
 
+// inverse transform is computed as a forward one with real and imaginary parts swapped
+template<typename T>
+void swap_real_imag(std::complex<T>* data, size_t n)
+{
+	std::complex<T>* end = data + n;
+	for (; data != end; ++data) {
+		T r = real(*data);
+		data->real(imag(*data));
+		data->imag(r);
+	}
+}
+
+// element copy policies of out-of-place permutations, the latter one is used by inverse transforms
+struct plain_copy {
+	template<typename T>
+	T operator()(const T& x) const {return x;}
+};
+
+struct swapped_copy {
+	template<typename T>
+	std::complex<T> operator()(const std::complex<T>& x) const {return std::complex<T>(imag(x), real(x));}
+};
+
+static size_t reverse_bits(size_t x, unsigned bits)
+{
+	size_t r = 0;
+	for (unsigned b = 0; b < bits; ++b, x >>= 1)
+		r = (r << 1) | (x & 1);
+	return r;
+}
+
+/*!
+ * @brief In-place bit-reversal permutation of 2^bits elements.
+ * Longer sequences are permuted in tiles: the index is split into (high, middle, low) parts of block_bits,
+ * (bits - 2 * block_bits) and block_bits bits and the elements which share the middle part are swapped with
+ * their counterparts together, so that all the memory touched by a tile (2^block_bits rows of 2^block_bits
+ * contiguous elements on each side) stays in L1 cache.
+ */
+template<typename T>
+void bit_reverse(T* data, unsigned bits)
+{
+	const unsigned block_bits = 4;
+	const size_t n = size_t(1) << bits, block = size_t(1) << block_bits;
+	if (bits < 2 * block_bits) {
+		for (size_t i = 0, j = 0; i < n; ++i) {
+			if (i < j)
+				std::swap(data[i], data[j]);
+			// increment j in reversed bit order
+			size_t bit = n >> 1;
+			for (; 0 != (j & bit); bit >>= 1)
+				j ^= bit;
+			j |= bit;
+		}
+		return;
+	}
+	const unsigned mid_bits = bits - 2 * block_bits, high_shift = bits - block_bits;
+	size_t rev[block];
+	for (size_t a = 0; a < block; ++a)
+		rev[a] = reverse_bits(a, block_bits);
+	for (size_t mid = 0; mid < (size_t(1) << mid_bits); ++mid) {
+		const size_t rmid = reverse_bits(mid, mid_bits);
+		if (rmid < mid)
+			continue;
+		for (size_t a = 0; a < block; ++a) {
+			T* src = data + ((a << high_shift) | (mid << block_bits));
+			T* dst = data + ((rmid << block_bits) | rev[a]);
+			for (size_t c = 0; c < block; ++c) {
+				// within the tile mapped onto itself swap each pair only once
+				if (mid != rmid || ((a << high_shift) | c) < ((rev[c] << high_shift) | rev[a]))
+					std::swap(src[c], dst[rev[c] << high_shift]);
+			}
+		}
+	}
+}
+
+// Sequences longer than that are copied and then bit-reversed in place by bit_reverse_copy(), which is faster
+// than scattered out-of-place writes once the data no longer fits in cache.
+const size_t bit_reverse_copy_max_bytes = 65536;
+
+/*!
+ * @brief Out-of-place bit-reversal permutation of 2^bits elements, out[reverse_bits(i)] = op(in[i]).
+ * This is the copying counterpart of bit_reverse(), using the same tiling for longer sequences: each tile
+ * reads 2^block_bits rows of contiguous input elements and writes 2^block_bits rows of output ones.
+ */
+template<typename T, class Op>
+void bit_reverse_copy(const T* in, T* out, unsigned bits, Op op)
+{
+	const unsigned block_bits = 4;
+	const size_t n = size_t(1) << bits, block = size_t(1) << block_bits;
+	if (n * sizeof(T) > bit_reverse_copy_max_bytes) {
+		std::transform(in, in + n, out, op);
+		bit_reverse(out, bits);
+		return;
+	}
+	if (bits < 2 * block_bits) {
+		for (size_t i = 0, j = 0; i < n; ++i) {
+			out[j] = op(in[i]);
+			size_t bit = n >> 1;
+			for (; 0 != (j & bit); bit >>= 1)
+				j ^= bit;
+			j |= bit;
+		}
+		return;
+	}
+	const unsigned mid_bits = bits - 2 * block_bits, high_shift = bits - block_bits;
+	size_t rev[block];
+	for (size_t a = 0; a < block; ++a)
+		rev[a] = reverse_bits(a, block_bits);
+	for (size_t mid = 0; mid < (size_t(1) << mid_bits); ++mid) {
+		const size_t rmid = reverse_bits(mid, mid_bits);
+		for (size_t a = 0; a < block; ++a) {
+			const T* src = in + ((a << high_shift) | (mid << block_bits));
+			T* dst = out + ((rmid << block_bits) | rev[a]);
+			for (size_t c = 0; c < block; ++c)
+				dst[rev[c] << high_shift] = op(src[c]);
+		}
+	}
+}
+
 // generic fast Fourier transform main class
 template<unsigned P, typename T = double>
 class fft_impl: public dsp::dft::detail::fft_impl<T>
@@ -183,45 +247,39 @@ class fft_impl: public dsp::dft::detail::fft_impl<T>
 		N = 1 << P
 	};
 	danielson_lanczos<N, T> recursion_;
-	void scramble(T* data) const
-	{
-		int i, m, j = 1;
-		for (i = 1; i < 2 * N; i += 2)
-		{
-			if (j > i)
-			{
-				std::swap(data[j - 1], data[i - 1]);
-				std::swap(data[j], data[i]);
-			}
-			m = N;
-			while (m >= 2 && j > m)
-			{
-				j -= m;
-				m >>= 1;
-			}
-			j += m;
-		}
-	}
+	mutable std::once_flag init_flag_;
+	mutable std::vector<std::complex<T>, dsp::simd::allocator<std::complex<T> > > twiddles_; //!< twiddle factors of all Danielson-Lanczos sections, built upon first use
 
-	void swap_real_imag(std::complex<T>* data) const
+	void init() const
 	{
-		std::complex<T>* end = data + N;
-		for (; data != end; ++data) {
-			T r = real(*data);
-			data->real(imag(*data));
-			data->imag(r);
-		}
+		twiddles_.resize(N - 1);
+		for (size_t n = 2; n <= N; n *= 2)
+			for (size_t k = 0; k < n / 2; ++k)
+				twiddles_[n / 2 - 1 + k] = std::polar(T(1), static_cast<T>(-2 * DSP_M_PI * k / n));
 	}
 
 public:
     void fft(std::complex<T>* in_out, dsp::dft::sign::spec sign) const
 	{
+		std::call_once(init_flag_, &fft_impl::init, this);
+		if (dsp::dft::sign::backward == sign)
+			swap_real_imag(in_out, N);
+		bit_reverse(in_out, P);
+		recursion_.apply(reinterpret_cast<T*>(in_out), twiddles_.data());
+		if (dsp::dft::sign::backward == sign)
+			swap_real_imag(in_out, N);
+	}
+
+	void fft(const std::complex<T>* in, std::complex<T>* out, dsp::dft::sign::spec sign) const
+	{
+		std::call_once(init_flag_, &fft_impl::init, this);
 		if (dsp::dft::sign::backward == sign)
-			swap_real_imag(in_out);
-		scramble(reinterpret_cast<T*>(in_out));
-		recursion_.apply(reinterpret_cast<T*>(in_out));
+			bit_reverse_copy(in, out, P, swapped_copy());
+		else
+			bit_reverse_copy(in, out, P, plain_copy());
+		recursion_.apply(reinterpret_cast<T*>(out), twiddles_.data());
 		if (dsp::dft::sign::backward == sign)
-			swap_real_imag(in_out);
+			swap_real_imag(out, N);
 	}
 
     fft_impl() {}
@@ -259,12 +317,10 @@ public:
 	FFT_IMPL_ARRAY(float);
 	FFT_IMPL_ARRAY(double);
 
+const size_t fft_size_max = 67108864;	// 2^26
+
 static size_t fft_impl_index(size_t size)
 {
-	if (!dsp::ispow2(size))
-		throw std::domain_error("dsp::dft::fft only allows transform size of integer powers of 2");
-	if (size < 2 || size > 67108864)
-		throw std::out_of_range("dsp::dft::fft transform size outside [2^1, 2^26]");
 	for (size_t u = 2, i = 0; ; ++i, u<<=1)
 		if (u == size)
 			return i;
@@ -272,12 +328,797 @@ static size_t fft_impl_index(size_t size)
 	return 0;
 }
 
+// multiply by -i
+template<typename T> inline
+std::complex<T> mul_minus_i(const std::complex<T>& x) {return std::complex<T>(imag(x), -real(x));}
+
+// complex multiplication without the C99 Annex G inf/nan recovery std::complex operator* is subject to
+template<typename T> inline
+std::complex<T> mul(const std::complex<T>& a, const std::complex<T>& b)
+{return std::complex<T>(real(a) * real(b) - imag(a) * imag(b), real(a) * imag(b) + imag(a) * real(b));}
+
+// Radix-2 decimation-in-time stage combining count pairs of m-point DFTs stored contiguously in x, w holds
+// the twiddle factors w^(j), j = 0..m-1.
+template<typename T>
+void butterfly_2(std::complex<T>* x, size_t m, size_t count, const std::complex<T>* w)
+{
+	const size_t length = 2 * m;
+	for (size_t j = 0; j < m; ++j, ++x) {
+		const std::complex<T> w1 = w[j];
+		std::complex<T>* y = x;
+		for (size_t b = 0; b < count; ++b, y += length) {
+			const std::complex<T> t = mul(y[m], w1);
+			y[m] = y[0] - t;
+			y[0] += t;
+		}
+	}
+}
+
+// Radix-4 stage, the m-point DFTs are expected in bit-reversed order (residues 0, 2, 1, 3 mod 4),
+// w holds w^(j), w^(2j), w^(3j) for j = 0..m-1, each of them contiguous.
+template<typename T>
+void butterfly_4(std::complex<T>* x, size_t m, size_t count, const std::complex<T>* w)
+{
+	const size_t length = 4 * m;
+	for (size_t j = 0; j < m; ++j, ++x) {
+		const std::complex<T> w1 = w[j];
+		const std::complex<T> w2 = w[m + j];
+		const std::complex<T> w3 = w[2 * m + j];
+		std::complex<T>* y = x;
+		for (size_t b = 0; b < count; ++b, y += length) {
+			const std::complex<T> a0 = y[0];
+			const std::complex<T> a1 = mul(y[2 * m], w1);
+			const std::complex<T> a2 = mul(y[m], w2);
+			const std::complex<T> a3 = mul(y[3 * m], w3);
+			const std::complex<T> t0 = a0 + a2, t1 = a0 - a2, t2 = a1 + a3, t3 = mul_minus_i(a1 - a3);
+			y[0] = t0 + t2;
+			y[m] = t1 + t3;
+			y[2 * m] = t0 - t2;
+			y[3 * m] = t1 - t3;
+		}
+	}
+}
+
+// Vectorized stages process 2 or 4 butterflies at a time, so Kernel is used only if m is a multiple of Width,
+// otherwise the stage is passed on to Fallback (narrower kernel or the generic one).
+template<typename T, void (*Kernel)(std::complex<T>*, size_t, size_t, const std::complex<T>*), size_t Width,
+	void (*Fallback)(std::complex<T>*, size_t, size_t, const std::complex<T>*)>
+void stage_of_width(std::complex<T>* x, size_t m, size_t count, const std::complex<T>* w)
+{
+	if (0 == m % Width)
+		Kernel(x, m, count, w);
+	else
+		Fallback(x, m, count, w);
+}
+
+// Radix-2/radix-4 stage kernels of the active dsp::simd::kernel_table for given precision.
+template<typename T> struct stage_kernels;
+
+template<> struct stage_kernels<float>
+{
+	typedef void (*stage_fn)(std::complex<float>*, size_t, size_t, const std::complex<float>*);
+	static stage_fn radix2() {return dsp::simd::kernels().fft_radix2;}
+	static stage_fn radix4() {return dsp::simd::kernels().fft_radix4;}
+};
+
+template<> struct stage_kernels<double>
+{
+	typedef void (*stage_fn)(std::complex<double>*, size_t, size_t, const std::complex<double>*);
+	static stage_fn radix2() {return dsp::simd::kernels().fft_radix2d;}
+	static stage_fn radix4() {return dsp::simd::kernels().fft_radix4d;}
+};
+
+// Test if vectorized butterflies are available, in which case power-of-2 transforms are done by mixed_radix_impl
+// (as a sequence of radix-4 stages) instead of the scalar Danielson-Lanczos recursion.
+template<typename T> bool simd_butterflies_available()
+{
+	typedef typename stage_kernels<T>::stage_fn stage_fn;
+	return stage_kernels<T>::radix4() != static_cast<stage_fn>(dsp::simd::detail::generic_fft_radix4);
+}
+
+// number of samples processed stage by stage by mixed_radix_impl::fft_many(), (up to 128kB of float samples)
+const size_t batch_group_size = 4096;
+
+// largest prime factor handled with the generic O(p^2) butterfly, bigger ones go through Bluestein's algorithm
+const size_t radix_generic_max = 61;
+
+// Split n into the radices used by mixed_radix_impl, 4's first, then 2, 3, 5, 7 and the remaining primes.
+// Returns the largest prime factor of n.
+static size_t factorize(size_t n, std::vector<size_t>& radices)
+{
+	radices.clear();
+	while (0 == n % 4) {radices.push_back(4); n /= 4;}
+	size_t p = 2, largest = 1;
+	while (n > 1) {
+		if (p * p > n)
+			p = n;
+		if (0 == n % p) {
+			radices.push_back(p);
+			largest = p;
+			n /= p;
+		}
+		else
+			p += (2 == p ? 1 : 2);
+	}
+	return std::max(largest, radices.empty() ? 1 : radices.front() / 2);
+}
+
+/*!
+ * @brief In-place, decimation-in-time mixed-radix FFT for transform lengths which are not powers of 2
+ * (and for powers of 2 if vectorized butterflies are available).
+ * The input sequence is digit-reversed first (following precomputed permutation cycles, so that no
+ * temporary storage is needed, or with bit_reverse() for powers of 2), then log_p(N) butterfly stages of
+ * radix 2, 3, 4, 5, 7 or generic
+ * odd prime radix (up to radix_generic_max) are applied. Radix-2 and radix-4 stages use SIMD
+ * instructions where possible.
+ */
+template<typename T>
+class mixed_radix_impl: public dsp::dft::detail::fft_impl<T>
+{
+	typedef std::complex<T> complex_type;
+	enum {generic_half_max = radix_generic_max / 2};
+
+	const size_t n_;
+	unsigned log2n_;						//!< log2(N) if N is a power of 2 (bit reversal is used instead of perm_), 0 otherwise
+	std::vector<size_t> radices_;			//!< radix of each stage, starting from the first one
+	std::vector<complex_type> twiddles_;	//!< exp(-2*pi*i*k/N), k = 0..N-1 (only if there are odd radix stages)
+	std::vector<complex_type, dsp::simd::allocator<complex_type> > stage_twiddles_;	//!< contiguous twiddle factors of radix-2 and radix-4 stages
+	std::vector<size_t> stage_offsets_;		//!< offset of each stage twiddle factors in stage_twiddles_
+	std::vector<size_t> perm_;				//!< digit-reversal permutation: element i is taken from perm_[i]
+	std::vector<size_t> cycles_;			//!< leaders of the permutation cycles (cycles of length 1 omitted)
+
+	void build_permutation(size_t dst, size_t src, size_t stride, size_t stage, size_t length)
+	{
+		if (0 == stage) {
+			perm_[dst] = src;
+			return;
+		}
+		const size_t p = radices_[stage - 1];
+		length /= p;
+		for (size_t r = 0; r < p; ++r) {
+			// radix-4 butterflies take their inputs in bit-reversed order, see butterfly_4()
+			const size_t q = (4 == p ? reverse_bits(r, 2) : r);
+			build_permutation(dst + r * length, src + q * stride, stride * p, stage - 1, length);
+		}
+	}
+
+	template<class Op>
+	void permute_copy(const complex_type* in, complex_type* out, Op op) const
+	{
+		if (0 != log2n_) {
+			bit_reverse_copy(in, out, log2n_, op);
+			return;
+		}
+		for (size_t i = 0; i < n_; ++i)
+			out[i] = op(in[perm_[i]]);
+	}
+
+	void permute(complex_type* data) const
+	{
+		for (std::vector<size_t>::const_iterator it = cycles_.begin(); it != cycles_.end(); ++it) {
+			const size_t leader = *it;
+			const complex_type tmp = data[leader];
+			size_t d = leader, s = perm_[leader];
+			for (; s != leader; d = s, s = perm_[s])
+				data[d] = data[s];
+			data[d] = tmp;
+		}
+	}
+
+	// Each butterfly routine processes all the count blocks of length p*m within a stage, so that the
+	// twiddle factors are loaded once for each j. Radix-2 and radix-4 ones take twiddle factors w^(r*j)
+	// from the contiguous stage table w (w + (r-1)*m). Radix-4 butterfly expects the DFTs of subsequences
+	// in bit-reversed order (0, 2, 1, 3), so that sequence of radix-4 stages is a sequence of radix-2 ones
+	// merged pairwise and power-of-2 transforms may use plain bit reversal.
+	// Odd radix butterfly exploiting the symmetry of the p-point DFT matrix:
+	// X[k] = u[k] - i*v[k], X[p-k] = u[k] + i*v[k], where u and v are sums over a[r] + a[p-r] and a[r] - a[p-r].
+	template<size_t P>
+	void butterfly_odd(complex_type* x, size_t m, size_t stride, size_t count, size_t p) const
+	{
+		if (0 != P)
+			p = P;
+		const size_t h = p / 2, length = p * m;
+		T c[generic_half_max * generic_half_max], s[generic_half_max * generic_half_max];
+		for (size_t k = 1; k <= h; ++k)
+			for (size_t r = 1; r <= h; ++r) {
+				// p-th roots of unity are taken from the N-point table
+				const complex_type& w = twiddles_[((r * k) % p) * (n_ / p)];
+				c[(k - 1) * h + r - 1] = real(w);
+				s[(k - 1) * h + r - 1] = -imag(w);
+			}
+		complex_type w[radix_generic_max], a[radix_generic_max], sum[generic_half_max], diff[generic_half_max];
+		for (size_t j = 0; j < m; ++j, ++x) {
+			for (size_t r = 1; r < p; ++r)
+				w[r] = twiddles_[r * j * stride];
+			complex_type* y = x;
+			for (size_t b = 0; b < count; ++b, y += length) {
+				a[0] = y[0];
+				for (size_t r = 1; r < p; ++r)
+					a[r] = mul(y[r * m], w[r]);
+				complex_type dc = a[0];
+				for (size_t r = 1; r <= h; ++r) {
+					sum[r - 1] = a[r] + a[p - r];
+					diff[r - 1] = a[r] - a[p - r];
+					dc += sum[r - 1];
+				}
+				y[0] = dc;
+				for (size_t k = 1; k <= h; ++k) {
+					const T* ck = c + (k - 1) * h;
+					const T* sk = s + (k - 1) * h;
+					complex_type u = a[0], v;
+					for (size_t r = 0; r < h; ++r) {
+						u += ck[r] * sum[r];
+						v += sk[r] * diff[r];
+					}
+					v = mul_minus_i(v);
+					y[k * m] = u + v;
+					y[(p - k) * m] = u - v;
+				}
+			}
+		}
+	}
+
+public:
+	explicit mixed_radix_impl(size_t n)
+	 :	n_(n)
+	 ,	log2n_(0)
+	{
+		factorize(n_, radices_);
+		size_t m = 1;
+		for (std::vector<size_t>::const_iterator it = radices_.begin(); it != radices_.end(); ++it) {
+			const size_t p = *it;
+			stage_offsets_.push_back(stage_twiddles_.size());
+			if (2 == p || 4 == p) {
+				for (size_t r = 1; r < p; ++r)
+					for (size_t j = 0; j < m; ++j)
+						stage_twiddles_.push_back(std::polar(T(1), static_cast<T>(-2 * DSP_M_PI * r * j / (p * m))));
+			}
+			else if (twiddles_.empty()) {
+				twiddles_.resize(n_);
+				for (size_t k = 0; k < n_; ++k)
+					twiddles_[k] = std::polar(T(1), static_cast<T>(-2 * DSP_M_PI * k / n_));
+			}
+			m *= p;
+		}
+		if (dsp::ispow2(n_)) {
+			while ((size_t(1) << log2n_) < n_)
+				++log2n_;
+			return;
+		}
+		perm_.resize(n_);
+		build_permutation(0, 0, 1, radices_.size(), n_);
+		std::vector<bool> visited(n_);
+		for (size_t i = 0; i < n_; ++i) {
+			if (visited[i] || perm_[i] == i)
+				continue;
+			cycles_.push_back(i);
+			for (size_t j = i; !visited[j]; j = perm_[j])
+				visited[j] = true;
+		}
+	}
+
+	// Apply single butterfly stage to count blocks of p*m elements.
+	void stage(complex_type* x, size_t s, size_t m, size_t count) const
+	{
+		const size_t p = radices_[s], stride = n_ / (p * m);
+		const complex_type* w = stage_twiddles_.data() + stage_offsets_[s];
+		switch (p) {
+		case 2: stage_kernels<T>::radix2()(x, m, count, w); break;
+		case 3: butterfly_odd<3>(x, m, stride, count, p); break;
+		case 4: stage_kernels<T>::radix4()(x, m, count, w); break;
+		case 5: butterfly_odd<5>(x, m, stride, count, p); break;
+		case 7: butterfly_odd<7>(x, m, stride, count, p); break;
+		default: butterfly_odd<0>(x, m, stride, count, p); break;
+		}
+	}
+
+	// Transform howmany sequences stage by stage, back-to-back sequences (dist == N) are handled
+	// by a single butterfly call per stage.
+	void transform(complex_type* in_out, size_t howmany, size_t dist, dsp::dft::sign::spec sign) const
+	{
+		for (size_t t = 0; t < howmany; ++t) {
+			complex_type* x = in_out + t * dist;
+			if (dsp::dft::sign::backward == sign)
+				swap_real_imag(x, n_);
+			if (0 != log2n_)
+				bit_reverse(x, log2n_);
+			else
+				permute(x);
+		}
+		stages(in_out, howmany, dist);
+		if (dsp::dft::sign::backward == sign)
+			for (size_t t = 0; t < howmany; ++t)
+				swap_real_imag(in_out + t * dist, n_);
+	}
+
+	// Apply all the butterfly stages to howmany sequences, which are already digit-reversed.
+	void stages(complex_type* in_out, size_t howmany, size_t dist) const
+	{
+		size_t m = 1;
+		for (size_t s = 0; s < radices_.size(); ++s) {
+			const size_t count = n_ / (radices_[s] * m);
+			if (n_ == dist)
+				stage(in_out, s, m, count * howmany);
+			else
+				for (size_t t = 0; t < howmany; ++t)
+					stage(in_out + t * dist, s, m, count);
+			m *= radices_[s];
+		}
+	}
+
+	void fft(complex_type* in_out, dsp::dft::sign::spec sign) const
+	{
+		transform(in_out, 1, n_, sign);
+	}
+
+	// Out-of-place transform: the digit reversal reads the input, so that no separate copy is needed.
+	void fft(const complex_type* in, complex_type* out, dsp::dft::sign::spec sign) const
+	{
+		if (dsp::dft::sign::backward == sign)
+			permute_copy(in, out, swapped_copy());
+		else
+			permute_copy(in, out, plain_copy());
+		stages(out, 1, n_);
+		if (dsp::dft::sign::backward == sign)
+			swap_real_imag(out, n_);
+	}
+
+	// Transforms are processed in groups of batch_group_size samples (at least one transform), so that the data
+	// of a group stays in cache while stage twiddle factors are reused for all of its transforms.
+	void fft_many(complex_type* in_out, size_t howmany, size_t dist, dsp::dft::sign::spec sign) const
+	{
+		const size_t group = std::max<size_t>(1, batch_group_size / n_);
+		for (size_t t = 0; t < howmany; t += group)
+			transform(in_out + t * dist, std::min(group, howmany - t), dist, sign);
+	}
+};
+
+/*!
+ * @brief Temporary storage preallocated by shared implementation objects, so that transforms don't allocate
+ * memory in the processing path. The buffer is claimed by the invocation for its duration, if it is already
+ * used by another thread the invocation falls back to temporary buffer allocated on its own.
+ */
+template<typename T>
+class scratch_buffer
+{
+	mutable std::vector<T> buf_;
+	mutable std::atomic<bool> busy_;
+
+public:
+	explicit scratch_buffer(size_t n): buf_(n), busy_(false) {}
+
+	//! @brief Claim of the scratch buffer (or fallback one) for the duration of single invocation.
+	class lease
+	{
+		const scratch_buffer& owner_;
+		const bool owned_;
+		std::vector<T> fallback_;
+
+		lease(const lease&);
+		lease& operator=(const lease&);
+
+	public:
+		explicit lease(const scratch_buffer& owner)
+		 :	owner_(owner)
+		 ,	owned_(!owner.busy_.exchange(true, std::memory_order_acquire))
+		 ,	fallback_(owned_ ? 0 : owner.buf_.size())
+		{}
+
+		~lease() {if (owned_) owner_.busy_.store(false, std::memory_order_release);}
+
+		T* get() {return (owned_ ? &owner_.buf_[0] : &fallback_[0]);}
+	};
+};
+
+/*!
+ * @brief Bluestein's (chirp-z) algorithm for transform lengths with large prime factors.
+ * The DFT is expressed as a circular convolution with a chirp sequence, which is evaluated with
+ * FFTs of fast length M >= 2N - 1.
+ * @note Contrary to other implementations this one needs M elements of temporary storage, which is
+ * preallocated (see scratch_buffer).
+ */
+template<typename T>
+class bluestein_impl: public dsp::dft::detail::fft_impl<T>
+{
+	typedef std::complex<T> complex_type;
+	typedef dsp::dft::fft<complex_type, complex_type> fft_type;
+
+	const size_t n_;
+	const size_t m_;
+	std::vector<complex_type> chirp_;	//!< exp(-i*pi*k^2/N), k = 0..N-1
+	std::vector<complex_type> kernel_;	//!< DFT of conjugated, circularly extended chirp, scaled by 1/M
+	fft_type fft_;
+	fft_type ifft_;
+	scratch_buffer<complex_type> scratch_;
+
+public:
+	explicit bluestein_impl(size_t n)
+	 :	n_(n)
+	 ,	m_(dsp::dft::fast_length(2 * n - 1))
+	 ,	chirp_(n)
+	 ,	kernel_(m_)
+	 ,	fft_(m_)
+	 ,	ifft_(m_, NULL, NULL, dsp::dft::sign::backward)
+	 ,	scratch_(m_)
+	{
+		for (size_t k = 0; k < n_; ++k) {
+			// reduce k^2 modulo 2N first to keep the argument of exp() accurate
+			const size_t k2 = static_cast<size_t>((static_cast<unsigned long long>(k) * k) % (2 * n_));
+			chirp_[k] = std::polar(T(1), static_cast<T>(-DSP_M_PI * k2 / n_));
+		}
+		const T scale = T(1) / m_;
+		kernel_[0] = scale;
+		for (size_t k = 1; k < n_; ++k)
+			kernel_[k] = kernel_[m_ - k] = std::conj(chirp_[k]) * scale;
+		fft_(&kernel_[0], NULL);
+	}
+
+	void fft(complex_type* in_out, dsp::dft::sign::spec sign) const
+	{
+		fft(static_cast<const complex_type*>(in_out), in_out, sign);
+	}
+
+	// The input is read only once (when multiplied by the chirp), so in-place transform is a special case.
+	void fft(const complex_type* in, complex_type* out, dsp::dft::sign::spec sign) const
+	{
+		typename scratch_buffer<complex_type>::lease lease(scratch_);
+		complex_type* const buf = lease.get();
+		if (dsp::dft::sign::backward == sign)
+			for (size_t k = 0; k < n_; ++k)
+				buf[k] = mul(swapped_copy()(in[k]), chirp_[k]);
+		else
+			for (size_t k = 0; k < n_; ++k)
+				buf[k] = mul(in[k], chirp_[k]);
+		std::fill(buf + n_, buf + m_, complex_type());
+		fft_(buf, NULL);
+		for (size_t k = 0; k < m_; ++k)
+			buf[k] = mul(buf[k], kernel_[k]);
+		ifft_(buf, NULL);
+		if (dsp::dft::sign::backward == sign)
+			for (size_t k = 0; k < n_; ++k)
+				out[k] = swapped_copy()(mul(buf[k], chirp_[k]));
+		else
+			for (size_t k = 0; k < n_; ++k)
+				out[k] = mul(buf[k], chirp_[k]);
+	}
+};
+
+/*!
+ * @brief Real-data transform implementation.
+ * For even N the real sequence x is treated as N/2-point complex sequence z[n] = x[2n] + i*x[2n+1], which is
+ * transformed with the complex FFT. The spectra of even (E) and odd (O) samples are then separated using
+ * their Hermitian symmetry and combined into X[k] = E[k] + W^k*O[k], where W = exp(-2*pi*i/N). The inverse
+ * transform performs the same steps in reverse order. Odd lengths are transformed with N-point complex FFT
+ * using preallocated temporary storage (see scratch_buffer).
+ */
+template<typename T>
+class real_fft_impl: public dsp::dft::detail::real_fft_impl<T>
+{
+	typedef dsp::dft::detail::real_fft_impl<T> base;
+	typedef std::complex<T> complex_type;
+	typedef dsp::dft::fft<complex_type, complex_type> fft_type;
+
+	const size_t n_;
+	const size_t m_;						//!< length of complex transforms (N/2 or N for odd N)
+	fft_type fft_;
+	fft_type ifft_;
+	const dsp::dft::detail::fft_impl<T>& impl_;	//!< M-point complex transform implementation for batched use
+	std::vector<complex_type> twiddles_;	//!< exp(-2*pi*i*k/N), k = 0..N/4
+	scratch_buffer<complex_type> scratch_;	//!< N-point complex sequence transformed for odd N
+
+	bool is_split() const {return m_ != n_;}
+
+	// separate spectra of even and odd samples from M-point DFT Z and combine them into N-point one
+	void split(complex_type* out) const
+	{
+		// the DC and Nyquist bins are both real, calculated from Z[0]
+		const complex_type z0 = out[0];
+		out[0] = real(z0) + imag(z0);
+		out[m_] = real(z0) - imag(z0);
+		const T half = T(.5);
+		for (size_t k = 1, l = m_ - 1; k <= l; ++k, --l) {
+			const complex_type zk = out[k], zl = std::conj(out[l]);
+			const complex_type e = half * (zk + zl);
+			const complex_type o = mul(mul_minus_i(half * (zk - zl)), twiddles_[k]);
+			out[k] = e + o;
+			out[l] = std::conj(e - o);
+		}
+	}
+
+	// inverse of split(), prepare M-point DFT Z of N-point Hermitian sequence
+	void merge(complex_type* in) const
+	{
+		const T x0 = real(in[0]), xm = real(in[m_]);
+		in[0] = complex_type(x0 + xm, x0 - xm);
+		for (size_t k = 1, l = m_ - 1; k <= l; ++k, --l) {
+			const complex_type xk = in[k], xl = std::conj(in[l]);
+			const complex_type e = xk + xl;
+			const complex_type o = mul(xk - xl, std::conj(twiddles_[k]));
+			// Z[k] = E[k] + i*O[k], Z[M-k] = conj(E[k]) + i*conj(O[k])
+			in[k] = e - mul_minus_i(o);
+			in[l] = std::conj(e) - mul_minus_i(std::conj(o));
+		}
+	}
+
+public:
+	explicit real_fft_impl(size_t n)
+	 :	n_(n)
+	 ,	m_((0 == n % 2 && n >= 4) ? n / 2 : n)
+	 ,	fft_(m_)
+	 ,	ifft_(m_, NULL, NULL, dsp::dft::sign::backward)
+	 ,	impl_(base::complex_impl(m_))
+	 ,	twiddles_(m_ / 2 + 1)
+	 ,	scratch_(is_split() ? 0 : n_)
+	{
+		for (size_t k = 0; k < twiddles_.size(); ++k)
+			twiddles_[k] = std::polar(T(1), static_cast<T>(-2 * DSP_M_PI * k / n_));
+	}
+
+	void forward(const T* in, complex_type* out) const
+	{
+		if (!is_split()) {
+			typename scratch_buffer<complex_type>::lease lease(scratch_);
+			complex_type* const buf = lease.get();
+			std::copy(in, in + n_, buf);
+			fft_(buf, NULL);
+			std::copy(buf, buf + (n_ / 2 + 1), out);
+			return;
+		}
+		forward_many(in, n_, out, m_ + 1, 1);
+	}
+
+	void backward(complex_type* in, T* out) const
+	{
+		if (!is_split()) {
+			typename scratch_buffer<complex_type>::lease lease(scratch_);
+			complex_type* const buf = lease.get();
+			std::copy(in, in + (n_ / 2 + 1), buf);
+			for (size_t i = n_ / 2 + 1; i < n_; ++i)
+				buf[i] = std::conj(buf[n_ - i]);
+			ifft_(buf, NULL);
+			for (size_t i = 0; i < n_; ++i)
+				out[i] = real(buf[i]);
+			return;
+		}
+		backward_many(in, m_ + 1, out, n_, 1);
+	}
+
+	void forward_many(const T* in, size_t idist, complex_type* out, size_t odist, size_t howmany) const
+	{
+		if (!is_split()) {
+			for (size_t t = 0; t < howmany; ++t)
+				forward(in + t * idist, out + t * odist);
+			return;
+		}
+		if (1 == howmany && reinterpret_cast<const T*>(out) != in) {
+			// the real input is read directly as M complex samples by out-of-place transform
+			base::fft(impl_, reinterpret_cast<const complex_type*>(in), out, dsp::dft::sign::forward);
+			split(out);
+			return;
+		}
+		for (size_t t = 0; t < howmany; ++t) {
+			const T* i = in + t * idist;
+			T* o = reinterpret_cast<T*>(out + t * odist);
+			if (o != i)
+				std::copy(i, i + n_, o);
+		}
+		base::fft_many(impl_, out, howmany, odist, dsp::dft::sign::forward);
+		for (size_t t = 0; t < howmany; ++t)
+			split(out + t * odist);
+	}
+
+	void backward_many(complex_type* in, size_t idist, T* out, size_t odist, size_t howmany) const
+	{
+		if (!is_split()) {
+			for (size_t t = 0; t < howmany; ++t)
+				backward(in + t * idist, out + t * odist);
+			return;
+		}
+		for (size_t t = 0; t < howmany; ++t)
+			merge(in + t * idist);
+		if (1 == howmany && reinterpret_cast<const T*>(in) != out) {
+			base::fft(impl_, in, reinterpret_cast<complex_type*>(out), dsp::dft::sign::backward);
+			return;
+		}
+		base::fft_many(impl_, in, howmany, idist, dsp::dft::sign::backward);
+		for (size_t t = 0; t < howmany; ++t) {
+			const T* i = reinterpret_cast<const T*>(in + t * idist);
+			T* o = out + t * odist;
+			if (o != i)
+				std::copy(i, i + n_, o);
+		}
+	}
+};
+
+template<typename T>
+const dsp::dft::detail::fft_impl<T>* create_fft_impl(size_t n)
+{
+	std::vector<size_t> radices;
+	if (factorize(n, radices) > radix_generic_max)
+		return new bluestein_impl<T>(n);
+	else
+		return new mixed_radix_impl<T>(n);
+}
+
+template<typename T>
+const dsp::dft::detail::real_fft_impl<T>* create_real_fft_impl(size_t n)
+{
+	return new real_fft_impl<T>(n);
+}
+
+/*!
+ * @brief Obtain cached implementation for given transform length, creating it upon first use.
+ * Implementations live until the program exits, so the references returned from fft_impl::get()
+ * stay valid the same way as for the static power-of-2 instances.
+ */
+template<class Impl>
+const Impl& cached_impl(size_t n, const Impl* (*create)(size_t))
+{
+	typedef std::map<size_t, std::shared_ptr<const Impl> > cache_type;
+	static std::mutex mutex;
+	static cache_type cache;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		typename cache_type::const_iterator it = cache.find(n);
+		if (cache.end() != it)
+			return *it->second;
+	}
+	// construct outside of the lock, implementations may request other lengths recursively
+	std::shared_ptr<const Impl> impl(create(n));
+	std::lock_guard<std::mutex> lock(mutex);
+	return *cache.insert(typename cache_type::value_type(n, impl)).first->second;
+}
+
+static void verify_size(size_t n)
+{
+	if (n < 2 || n > fft_size_max)
+		throw std::out_of_range("dsp::dft::fft transform size outside [2, 2^26]");
+}
+
+template<typename T>
+const dsp::dft::detail::fft_impl<T>& get_impl(const dsp::dft::detail::fft_impl<T>* const* pow2_impls, size_t n)
+{
+	verify_size(n);
+	if (dsp::ispow2(n) && !simd_butterflies_available<T>())
+		return *pow2_impls[fft_impl_index(n)];
+	return cached_impl(n, &create_fft_impl<T>);
+}
+
+template<typename T>
+const dsp::dft::detail::real_fft_impl<T>& get_real_impl(size_t n)
+{
+	verify_size(n);
+	return cached_impl(n, &create_real_fft_impl<T>);
+}
+
+// estimated cost (per point) of a single butterfly stage of given radix, see fast_length()
+static double radix_cost(size_t p, bool vectorized)
+{
+	// vectorized radix-2 and radix-4 stages process (at least) 2 butterflies at a time
+	const double factor = (vectorized ? .5 : 1.);
+	switch (p) {
+	case 2: return 6 * factor;
+	case 3: return 9;
+	case 4: return 9 * factor;
+	case 5: return 14;
+	case 7: return 20;
+	default: return static_cast<double>(3 * p);
+	}
+}
+
+}
+
+size_t dsp::dft::fast_length(size_t min_length)
+{
+	if (min_length <= 2)
+		return 2;
+	const size_t upper = dsp::nextpow2(min_length);
+	if (upper > fft_size_max)
+		return upper;
+	const bool vectorized = simd_butterflies_available<float>();
+	std::vector<size_t> radices;
+	// power-of-2 lengths use radix-2 Danielson-Lanczos recursion preceded by bit reversal, or
+	// vectorized radix-4 stages of mixed_radix_impl
+	size_t best = upper;
+	double best_cost = 3;
+	if (vectorized) {
+		factorize(upper, radices);
+		for (std::vector<size_t>::const_iterator it = radices.begin(); it != radices.end(); ++it)
+			best_cost += radix_cost(*it, true);
+	}
+	else
+		for (size_t n = upper; n > 1; n >>= 1)
+			best_cost += radix_cost(2, false);
+	double best_total = static_cast<double>(upper) * best_cost;
+	// enumerate all 7-smooth numbers in range [min_length, upper)
+	for (size_t p7 = 1; p7 < upper; p7 *= 7)
+		for (size_t p5 = p7; p5 < upper; p5 *= 5)
+			for (size_t p3 = p5; p3 < upper; p3 *= 3) {
+				size_t n = p3;
+				while (n < min_length)
+					n *= 2;
+				if (n >= upper || dsp::ispow2(n))
+					continue;
+				factorize(n, radices);
+				double cost = 3; // digit reversal permutation
+				for (std::vector<size_t>::const_iterator it = radices.begin(); it != radices.end(); ++it)
+					cost += radix_cost(*it, vectorized);
+				if (static_cast<double>(n) * cost < best_total) {
+					best_total = static_cast<double>(n) * cost;
+					best = n;
+				}
+			}
+	return best;
 }
 
 #define FFT_IMPL_DEFINE(type) \
 	dsp::dft::detail::fft_impl<type>::~fft_impl() {} \
+	void dsp::dft::detail::fft_impl<type>::fft_many(complex<type>* in_out, size_t howmany, size_t dist, sign::spec sign) const \
+	{for (size_t t = 0; t < howmany; ++t) fft(in_out + t * dist, sign);} \
 	const dsp::dft::detail::fft_impl<type>& dsp::dft::detail::fft_impl<type>::get(size_t n) \
-	{return *FFT_ARRAY_NAME(type)[fft_impl_index(n)];}
+	{return get_impl<type>(FFT_ARRAY_NAME(type), n);}
 
 FFT_IMPL_DEFINE(float);
 FFT_IMPL_DEFINE(double);
+
+#define REAL_FFT_IMPL_DEFINE(type) \
+	dsp::dft::detail::real_fft_impl<type>::~real_fft_impl() {} \
+	void dsp::dft::detail::real_fft_impl<type>::forward_many(const type* in, size_t idist, complex<type>* out, size_t odist, size_t howmany) const \
+	{for (size_t t = 0; t < howmany; ++t) forward(in + t * idist, out + t * odist);} \
+	void dsp::dft::detail::real_fft_impl<type>::backward_many(complex<type>* in, size_t idist, type* out, size_t odist, size_t howmany) const \
+	{for (size_t t = 0; t < howmany; ++t) backward(in + t * idist, out + t * odist);} \
+	const dsp::dft::detail::real_fft_impl<type>& dsp::dft::detail::real_fft_impl<type>::get(size_t n) \
+	{return get_real_impl<type>(n);}
+
+REAL_FFT_IMPL_DEFINE(float);
+REAL_FFT_IMPL_DEFINE(double);
+
+void dsp::simd::detail::generic_fft_radix2(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w)
+{butterfly_2(x, m, count, w);}
+
+void dsp::simd::detail::generic_fft_radix2(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w)
+{butterfly_2(x, m, count, w);}
+
+void dsp::simd::detail::generic_fft_radix4(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w)
+{butterfly_4(x, m, count, w);}
+
+void dsp::simd::detail::generic_fft_radix4(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w)
+{butterfly_4(x, m, count, w);}
+
+void dsp::simd::detail::resolve_fft_kernels(kernel_table& k, unsigned feat_flags)
+{
+	using namespace dsp::simd::detail;
+	k.fft_radix2 = generic_fft_radix2;
+	k.fft_radix4 = generic_fft_radix4;
+	k.fft_radix2d = generic_fft_radix2;
+	k.fft_radix4d = generic_fft_radix4;
+
+	// Each instruction set overrides the kernels it has implementations for, so go from the oldest to the newest.
+#ifdef DSP_ARCH_FAMILY_X86
+	if (feat_flags & dsp::simd::feat::x86_sse) {
+		k.fft_radix2 = stage_of_width<float, x86_sse_fft_radix2f, 2, generic_fft_radix2>;
+		k.fft_radix4 = stage_of_width<float, x86_sse_fft_radix4f, 2, generic_fft_radix4>;
+	}
+	if (feat_flags & dsp::simd::feat::x86_sse3) {
+		k.fft_radix2d = x86_sse3_fft_radix2d;
+		k.fft_radix4d = x86_sse3_fft_radix4d;
+	}
+#if !DSP_SIMD_AVX_DISABLED
+	// processors with AVX support SSE3 too, which handles the stages too short for AVX
+	if (feat_flags & dsp::simd::feat::x86_avx) {
+		k.fft_radix2 = stage_of_width<float, x86_avx_fft_radix2f, 4, stage_of_width<float, x86_sse_fft_radix2f, 2, generic_fft_radix2> >;
+		k.fft_radix4 = stage_of_width<float, x86_avx_fft_radix4f, 4, stage_of_width<float, x86_sse_fft_radix4f, 2, generic_fft_radix4> >;
+		k.fft_radix2d = stage_of_width<double, x86_avx_fft_radix2d, 2, x86_sse3_fft_radix2d>;
+		k.fft_radix4d = stage_of_width<double, x86_avx_fft_radix4d, 2, x86_sse3_fft_radix4d>;
+	}
+#endif // !DSP_SIMD_AVX_DISABLED
+#endif // DSP_ARCH_FAMILY_X86
+
+#if defined(DSP_ARCH_FAMILY_ARM) && !DSP_SIMD_NEON_DISABLED
+	// ARMv7 NEON has no double vectors, double precision stages stay generic
+	if (feat_flags & dsp::simd::feat::arm_neon) {
+		k.fft_radix2 = stage_of_width<float, arm_neon_fft_radix2f, 4, generic_fft_radix2>;
+		k.fft_radix4 = stage_of_width<float, arm_neon_fft_radix4f, 4, generic_fft_radix4>;
+	}
+#endif // DSP_ARCH_FAMILY_ARM && !DSP_SIMD_NEON_DISABLED
+}
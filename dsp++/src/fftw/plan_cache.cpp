@@ -0,0 +1,114 @@
+/*!
+ * @file plan_cache.cpp
+ * @brief Implementation of process-wide FFTW3 plan cache.
+ * @author Andrzej Ciarkowski <mailto:andrzej.ciarkowski@gmail.com>
+ */
+
+#include <dsp++/config.h>
+
+#if !DSP_FFTW_DISABLED
+
+#include <dsp++/fftw/plan_cache.h>
+
+#include <map>
+#include <mutex>
+
+using namespace dsp::dft::fftw;
+
+namespace {
+
+struct entry {
+	plan_cache::ref_type plan;
+	unsigned long last_use;		//!< value of cache_state::clock when the plan was last looked up
+};
+
+typedef std::map<plan_key, entry> plan_map;
+
+struct cache_state {
+	plan_map plans;
+	size_t capacity;
+	unsigned long clock;
+};
+
+// Function-local statics, so that the cache may be used during static initialization of other modules.
+// The mutex is recursive, since the plans are destroyed with the lock held (also when the cache is cleared).
+std::recursive_mutex& planner_mutex()
+{
+	static std::recursive_mutex mutex;
+	return mutex;
+}
+
+cache_state& state()
+{
+	static cache_state s = {plan_map(), plan_cache::default_capacity, 0};
+	return s;
+}
+
+// Release least recently used plans not held by any dft object until there are no more than limit plans.
+void evict(size_t limit)
+{
+	plan_map& plans = state().plans;
+	while (plans.size() > limit) {
+		plan_map::iterator lru = plans.end();
+		for (plan_map::iterator it = plans.begin(); it != plans.end(); ++it)
+			if (1 == it->second.plan.use_count() && (plans.end() == lru || it->second.last_use < lru->second.last_use))
+				lru = it;
+		if (plans.end() == lru)
+			break;
+		plans.erase(lru);
+	}
+}
+
+}
+
+plan_cache::lock::lock() {planner_mutex().lock();}
+
+plan_cache::lock::~lock() {planner_mutex().unlock();}
+
+plan_cache::ref_type plan_cache::find(const plan_key& key)
+{
+	cache_state& s = state();
+	plan_map::iterator it = s.plans.find(key);
+	if (s.plans.end() == it)
+		return ref_type();
+	it->second.last_use = ++s.clock;
+	return it->second.plan;
+}
+
+void plan_cache::insert(const plan_key& key, const ref_type& plan)
+{
+	cache_state& s = state();
+	if (0 == s.capacity)
+		return;
+	evict(s.capacity - 1);
+	entry& e = s.plans[key];
+	e.plan = plan;
+	e.last_use = ++s.clock;
+}
+
+void plan_cache::clear()
+{
+	lock l;
+	state().plans.clear();
+}
+
+size_t plan_cache::size()
+{
+	lock l;
+	return state().plans.size();
+}
+
+void plan_cache::set_capacity(size_t capacity)
+{
+	lock l;
+	state().capacity = capacity;
+	evict(capacity);
+}
+
+size_t plan_cache::capacity()
+{
+	lock l;
+	return state().capacity;
+}
+
+#endif // !DSP_FFTW_DISABLED
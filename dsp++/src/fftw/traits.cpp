@@ -78,6 +78,24 @@ namespace {
 #define INT(param) static_cast<int>(param)
 #define CPINT(param) reinterpret_cast<const int*>(param)
 
+#if DSP_FFTW_THREADS_DISABLED
+// libfftw3_threads is not linked in, plans are always single-threaded (plan<>::init_threads() returns false)
+#define DEFINE_THREADS_TRAITS(prefix, type) \
+void traits<type>::plan_with_nthreads(unsigned) {}\
+int traits<type>::init_threads(void) {return 0;}\
+void traits<type>::cleanup_threads(void) {MANGLE(prefix, cleanup)();}
+#else
+#define DEFINE_THREADS_TRAITS(prefix, type) \
+void traits<type>::plan_with_nthreads(unsigned nthreads)\
+{MANGLE(prefix, plan_with_nthreads)(INT(nthreads));}\
+\
+int traits<type>::init_threads(void)\
+{return MANGLE(prefix, init_threads)();}\
+\
+void traits<type>::cleanup_threads(void)\
+{MANGLE(prefix, cleanup_threads)();}
+#endif // DSP_FFTW_THREADS_DISABLED
+
 #define DEFINE_TRAITS(prefix, type) \
 BOOST_STATIC_ASSERT(sizeof(dsp::dft::fftw::r2r::kind) == sizeof(MANGLE(prefix, r2r_kind)));\
 \
@@ -326,14 +344,7 @@ void traits<type>::cleanup(void)\
 void traits<type>::set_timelimit(double t)\
 {MANGLE(prefix, set_timelimit)(t);}\
 \
-void traits<type>::plan_with_nthreads(unsigned nthreads)\
-{MANGLE(prefix, plan_with_nthreads)(INT(nthreads));}\
-\
-int traits<type>::init_threads(void)\
-{return MANGLE(prefix, init_threads)();}\
-\
-void traits<type>::cleanup_threads(void)\
-{MANGLE(prefix, cleanup_threads)();}\
+DEFINE_THREADS_TRAITS(prefix, type)\
 \
 int traits<type>::export_wisdom_to_filename(const char* filename)\
 {return MANGLE(prefix, export_wisdom_to_filename)(filename);}\
@@ -381,6 +392,9 @@ traits<type>::complex_type* traits<type>::alloc_complex(size_t n)\
 void traits<type>::free(void* p)\
 {MANGLE(prefix, free)(p);}\
 \
+int traits<type>::alignment_of(real_type* p)\
+{return MANGLE(prefix, alignment_of)(p);}\
+\
 void traits<type>::flops(const plan_type p,\
                           double* add, double* mul, double* fmas)\
 {MANGLE(prefix, flops)(p, add, mul, fmas);}\
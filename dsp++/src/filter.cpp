@@ -7,79 +7,303 @@
 #include <dsp++/simd.h>
 #include <cstring>
 
+#include "simd.h"
 #include "arch/x86/sse.h"
-
-#define noop() ((void)0)
+#include "arch/x86/avx.h"
+#include "arch/arm/neon.h"
 
 using namespace dsp;
 
-float dsp::simd::filter_sample_df2(float* w, const float* b, const size_t M, const float* a, const size_t N)
+void dsp::simd::detail::resolve_filter_kernels(kernel_table& k, unsigned feat_flags)
 {
-	if (false) noop();
+	using namespace dsp::simd::detail;
+	k.filter_sample_df2 = dsp::filter_sample_df2<float>;
+	k.filter_sample_tdf2 = dsp::filter_sample_tdf2<float>;
+	k.filter_sample_sos_df2 = dsp::filter_sample_sos_df2<float>;
+	k.filter_block_fir = dsp::filter_block_fir<float>;
+	k.filter_block_biquad = generic_filter_block_biquad;
+	k.filter_sos_lanes = dsp::filter_sos_lanes_tdf2<float>;
+
+	// Each instruction set overrides the kernels it has implementations for, so go from the oldest to the newest.
 #ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse41)
-		return dsp::simd::detail::x86_sse41_filter_df2(w, b, M, a, N);
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		return dsp::simd::detail::x86_sse_filter_df2(w, b, M, a, N);
+	if (feat_flags & dsp::simd::feat::x86_sse) {
+		k.filter_sample_df2 = x86_sse_filter_df2;
+		k.filter_sample_tdf2 = x86_sse_filter_tdf2;
+		k.filter_sample_sos_df2 = x86_sse_filter_sos_df2;
+		k.filter_block_fir = x86_sse_filter_block_fir;
+		k.filter_block_biquad = x86_sse_filter_block_biquad;
+		k.filter_sos_lanes = x86_sse_filter_sos_lanes;
+	}
+	if (feat_flags & dsp::simd::feat::x86_sse41)
+		k.filter_sample_df2 = x86_sse41_filter_df2;
+#if !DSP_SIMD_AVX_DISABLED
+	if (feat_flags & dsp::simd::feat::x86_avx) {
+		k.filter_sample_df2 = x86_avx_filter_df2;
+		k.filter_sample_tdf2 = x86_avx_filter_tdf2;
+		k.filter_sample_sos_df2 = x86_avx_filter_sos_df2;
+		k.filter_block_fir = x86_avx_filter_block_fir;
+		k.filter_block_biquad = x86_avx_filter_block_biquad;
+		k.filter_sos_lanes = x86_avx_filter_sos_lanes;
+	}
+	if (x86_fma_mask == (feat_flags & x86_fma_mask)) {
+		k.filter_sample_df2 = x86_fma_filter_df2;
+		k.filter_sample_tdf2 = x86_fma_filter_tdf2;
+		k.filter_sample_sos_df2 = x86_fma_filter_sos_df2;
+		k.filter_block_fir = x86_fma_filter_block_fir;
+		k.filter_block_biquad = x86_fma_filter_block_biquad;
+		k.filter_sos_lanes = x86_fma_filter_sos_lanes;
+	}
+#endif // !DSP_SIMD_AVX_DISABLED
 #endif // DSP_ARCH_FAMILY_X86
 
-	return dsp::filter_sample_df2(w, b, M, a, N);
+#if defined(DSP_ARCH_FAMILY_ARM) && !DSP_SIMD_NEON_DISABLED
+	if (feat_flags & dsp::simd::feat::arm_neon) {
+		k.filter_sample_df2 = arm_neon_filter_df2;
+		k.filter_sample_tdf2 = arm_neon_filter_tdf2;
+		k.filter_sample_sos_df2 = arm_neon_filter_sos_df2;
+		k.filter_block_fir = arm_neon_filter_block_fir;
+		k.filter_block_biquad = arm_neon_filter_block_biquad;
+		k.filter_sos_lanes = arm_neon_filter_sos_lanes;
+	}
+#endif // DSP_ARCH_FAMILY_ARM
+}
+
+float dsp::simd::filter_sample_df2(float* w, const float* b, const size_t M, const float* a, const size_t N)
+{
+	return dsp::simd::detail::active_kernels.filter_sample_df2(w, b, M, a, N);
 }
 
 float dsp::simd::filter_sample_df2(float* w, const float* b, const size_t M, const float* a, const size_t N, int feat_flags)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (feat_flags & dsp::simd::feat::x86_sse41)
-		return dsp::simd::detail::x86_sse41_filter_df2(w, b, M, a, N);
-	else if (feat_flags & dsp::simd::feat::x86_sse)
-		return dsp::simd::detail::x86_sse_filter_df2(w, b, M, a, N);
-#endif // DSP_ARCH_FAMILY_X86
+	dsp::simd::kernel_table k;
+	dsp::simd::detail::resolve_filter_kernels(k, feat_flags);
+	return k.filter_sample_df2(w, b, M, a, N);
+}
+
+float dsp::simd::filter_sample_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N)
+{
+	return dsp::simd::detail::active_kernels.filter_sample_tdf2(x, s, b, M, a, N);
+}
 
-	return dsp::filter_sample_df2(w, b, M, a, N);
+float dsp::simd::filter_sample_tdf2(float x, float* s, const float* b, const size_t M, const float* a, const size_t N, int feat_flags)
+{
+	dsp::simd::kernel_table k;
+	dsp::simd::detail::resolve_filter_kernels(k, feat_flags);
+	return k.filter_sample_tdf2(x, s, b, M, a, N);
 }
 
-namespace dsp { namespace detail {
+float dsp::simd::filter_sample_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step)
+{
+	return dsp::simd::detail::active_kernels.filter_sample_sos_df2(x, N, scale_only, w, b, a, step);
+}
 
+float dsp::simd::filter_sample_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step, int feat_flags)
+{
+	dsp::simd::kernel_table k;
+	dsp::simd::detail::resolve_filter_kernels(k, feat_flags);
+	return k.filter_sample_sos_df2(x, N, scale_only, w, b, a, step);
+}
 
-} }
 
-float dsp::simd::filter_sample_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step)
+void dsp::simd::filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		return dsp::simd::detail::x86_sse_filter_sos_df2(x, N, scale_only, w, b, a, step);
-#endif // DSP_ARCH_FAMILY_X86
+	dsp::simd::detail::active_kernels.filter_block_fir(y, x, L, b, M);
+}
 
-	return dsp::filter_sample_sos_df2(x, N, scale_only, w, b, a, step);
+void dsp::simd::filter_block_fir(float* y, const float* x, size_t L, const float* b, size_t M, int feat_flags)
+{
+	dsp::simd::kernel_table k;
+	dsp::simd::detail::resolve_filter_kernels(k, feat_flags);
+	k.filter_block_fir(y, x, L, b, M);
 }
 
-float dsp::simd::filter_sample_sos_df2(float x, size_t N, const bool* scale_only, float* w, const float* b, const float* a, size_t step, int feat_flags)
+void dsp::simd::detail::generic_filter_block_biquad(float* x, size_t L, float* s, const float* m)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (feat_flags & dsp::simd::feat::x86_sse)
-		return dsp::simd::detail::x86_sse_filter_sos_df2(x, N, scale_only, w, b, a, step);
-#endif // DSP_ARCH_FAMILY_X86
+	const float* const c = m + 4 * 12;
+	dsp::filter_block_biquad_tdf2(x, L, s, c, c + sos_length);
+}
 
-	return dsp::filter_sample_sos_df2(x, N, scale_only, w, b, a, step);
+void dsp::simd::biquad_block_coeffs(float* m, const float* b, const float* a)
+{
+	// Transposed Direct-Form II in state-space form: s[n + 1] = A * s[n] + B * x[n], y[n] = C * s[n] + D * x[n],
+	// with A = [-a1 1; -a2 0], B = [b1 - a1 * b0; b2 - a2 * b0], C = [1 0], D = b0.
+	const double a1 = a[1], a2 = a[2], b0 = b[0];
+	double h[4];				// impulse response: h[0] = D, h[k] = C * A^(k - 1) * B
+	double ab[4][2];			// A^k * B
+	double ca[5][2];			// C * A^k (rows), ca[4] is unused
+	double a4[2][2] = {{1., 0.}, {0., 1.}};	// A^k, finally A^4
+	ab[0][0] = b[1] - a1 * b0;
+	ab[0][1] = b[2] - a2 * b0;
+	ca[0][0] = 1.; ca[0][1] = 0.;
+	for (size_t k = 1; k < 4; ++k) {
+		ab[k][0] = -a1 * ab[k - 1][0] + ab[k - 1][1];
+		ab[k][1] = -a2 * ab[k - 1][0];
+		ca[k][0] = -a1 * ca[k - 1][0] - a2 * ca[k - 1][1];
+		ca[k][1] = ca[k - 1][0];
+	}
+	for (size_t k = 0; k < 4; ++k) {
+		const double r0 = -a1 * a4[0][0] + a4[1][0], r1 = -a1 * a4[0][1] + a4[1][1];
+		a4[1][0] = -a2 * a4[0][0];
+		a4[1][1] = -a2 * a4[0][1];
+		a4[0][0] = r0;
+		a4[0][1] = r1;
+	}
+	h[0] = b0;
+	for (size_t k = 1; k < 4; ++k)
+		h[k] = ab[k - 1][0];
+
+	std::fill_n(m, biquad_block_length, 0.f);
+	// columns for input samples x[n + k]
+	for (size_t k = 0; k < 4; ++k, m += 8) {
+		for (size_t j = k; j < 4; ++j)
+			m[j] = static_cast<float>(h[j - k]);
+		m[4] = static_cast<float>(ab[3 - k][0]);
+		m[5] = static_cast<float>(ab[3 - k][1]);
+	}
+	// columns for state variables s1, s2
+	for (size_t i = 0; i < 2; ++i, m += 8) {
+		for (size_t j = 0; j < 4; ++j)
+			m[j] = static_cast<float>(ca[j][i]);
+		m[4] = static_cast<float>(a4[0][i]);
+		m[5] = static_cast<float>(a4[1][i]);
+	}
+	// original coefficients for the trailing samples
+	m[0] = b[0]; m[1] = b[1]; m[2] = b[2];
+	m[3] = 1.f;  m[4] = a[1]; m[5] = a[2];
 }
 
+void dsp::simd::filter_block_biquad(float* x, size_t L, float* s, const float* m)
+{
+	dsp::simd::detail::active_kernels.filter_block_biquad(x, L, s, m);
+}
+
+void dsp::simd::filter_block_biquad(float* x, size_t L, float* s, const float* m, int feat_flags)
+{
+	dsp::simd::kernel_table k;
+	dsp::simd::detail::resolve_filter_kernels(k, feat_flags);
+	k.filter_block_biquad(x, L, s, m);
+}
+
+void dsp::simd::filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s)
+{
+	dsp::simd::detail::active_kernels.filter_sos_lanes(x, L, stride, C, N, c, s);
+}
+
+void dsp::simd::filter_sos_lanes(float* x, size_t L, size_t stride, size_t C, size_t N, const float* c, float* s, int feat_flags)
+{
+	dsp::simd::kernel_table k;
+	dsp::simd::detail::resolve_filter_kernels(k, feat_flags);
+	k.filter_sos_lanes(x, L, stride, C, N, c, s);
+}
 
 void dsp::block_filter<float>::operator()()
 {
+	if (0 == N_) {
+		// FIR-only filter keeps its P_ - 1 past input samples oldest-first in w_, so that together with the
+		// current block copied right after them they form the contiguous input expected by filter_block_fir().
+		float* const x = w_ + P_ - 1;
+		std::memcpy(x, x_, L_ * sizeof(float));
+		dsp::simd::detail::active_kernels.filter_block_fir(x_, x, L_, b_, M_);
+		// keep the last P_ - 1 input samples as the history for the next block
+		std::memmove(w_, w_ + L_, (P_ - 1) * sizeof(float));
+		return;
+	}
 	std::memmove(w_ + L_, w_, (P_ - 1) * sizeof(float));
 	float* w = w_ + L_ - 1;
 	float* x = x_;
+	// fetch the kernel once instead of going through dsp::simd::filter_sample_df2() for each sample
+	float (* const filter_sample)(float*, const float*, size_t, const float*, size_t) =
+		dsp::simd::detail::active_kernels.filter_sample_df2;
 	for (size_t n = 0; n != L_; ++n, --w, ++x) {
 		*w = *x;
-		*x = dsp::simd::filter_sample_df2(w, b_, M_pad_, a_, N_pad_);
+		*x = filter_sample(w, b_, M_pad_, a_, N_pad_);
 	}
 }
 
 float dsp::filter_sos<float>::operator()(float x)
 {
 	std::memmove(w_ + 1, w_, (N_ * step_ - 1) * sizeof(float));
-	return dsp::simd::filter_sample_sos_df2(x, N_, scale_only_.get(), w_, b_, a_, step_);
+	return dsp::simd::detail::active_kernels.filter_sample_sos_df2(x, N_, scale_only_.get(), w_, b_, a_, step_);
+}
+
+void dsp::block_filter_sos<float>::prepare()
+{
+	const float* b = b_;
+	const float* a = a_;
+	float* m = m_;
+	for (size_t i = 0; i < N_; ++i, b += step_, a += step_, m += dsp::simd::biquad_block_length)
+		dsp::simd::biquad_block_coeffs(m, b, a);
+}
+
+void dsp::block_filter_sos<float>::operator()()
+{
+	void (* const filter_block)(float*, size_t, float*, const float*) = dsp::simd::detail::active_kernels.filter_block_biquad;
+	float* w = w_;
+	const float* b = b_;
+	const float* m = m_;
+	// x_ is padded, which the vector kernels of scalar multiplication may need
+	const size_t len = dsp::simd::aligned_count<float>(L_);
+	for (size_t i = 0; i < N_; ++i, w += step_, b += step_, m += dsp::simd::biquad_block_length) {
+		if (scale_only_[i])
+			dsp::simd::detail::active_kernels.mul_scalar(x_, x_, *b, len);
+		else
+			filter_block(x_, L_, w, m);
+	}
+}
+
+void dsp::filter_sos_multichannel<float>::prepare()
+{
+	float* c = c_;
+	const float* b = b_;
+	const float* a = a_;
+	for (size_t j = 0; j < N_; ++j, c += sos_lanes_length, b += step_, a += step_) {
+		std::fill_n(c, sos_lanes_length, 0.f);
+		c[0] = b[0];
+		if (!scale_only_[j]) {
+			c[1] = b[1]; c[2] = b[2];
+			c[3] = a[1]; c[4] = a[2];
+		}
+	}
+}
+
+void dsp::filter_sos_multichannel<float>::operator()(const float* in, const snd::buffer_layout& bl_in, float* out, const snd::buffer_layout& bl_out, size_t length)
+{
+	void (* const filter_lanes)(float*, size_t, size_t, size_t, size_t, const float*, float*) =
+		dsp::simd::detail::active_kernels.filter_sos_lanes;
+	const unsigned frame_stride = static_cast<unsigned>(C_ * sizeof(float));
+	if (C_ == C_pad_ && sizeof(float) == bl_out.channel_stride && frame_stride == bl_out.sample_stride) {
+		// interleaved output with channel count matching vector lanes: filter it directly, in chunks, so that
+		// each section pass over the frames hits the cache; unless filtering in place, each chunk is gathered
+		// from the input right before it's filtered (in and out must not overlap then)
+		const bool in_place = (in == out && bl_in.channel_stride == bl_out.channel_stride && bl_in.sample_stride == bl_out.sample_stride);
+		const char* i = reinterpret_cast<const char*>(in);
+		while (0 != length) {
+			const size_t L = (length < chunk_length ? length : chunk_length);
+			if (!in_place) {
+				float* o = out;
+				for (size_t n = 0; n < L; ++n, i += bl_in.sample_stride)
+					for (size_t k = 0; k < C_; ++k, ++o)
+						*o = *reinterpret_cast<const float*>(i + k * bl_in.channel_stride);
+			}
+			filter_lanes(out, L, C_, C_, N_, c_, s_);
+			out += L * C_;
+			length -= L;
+		}
+		return;
+	}
+	const char* i = reinterpret_cast<const char*>(in);
+	char* o = reinterpret_cast<char*>(out);
+	while (0 != length) {
+		const size_t L = (length < chunk_length ? length : chunk_length);
+		float* x = x_;
+		for (size_t n = 0; n < L; ++n, i += bl_in.sample_stride, x += C_pad_ - C_)
+			for (size_t k = 0; k < C_; ++k, ++x)
+				*x = *reinterpret_cast<const float*>(i + k * bl_in.channel_stride);
+		filter_lanes(x_, L, C_pad_, C_pad_, N_, c_, s_);
+		x = x_;
+		for (size_t n = 0; n < L; ++n, o += bl_out.sample_stride, x += C_pad_ - C_)
+			for (size_t k = 0; k < C_; ++k, ++x)
+				*reinterpret_cast<float*>(o + k * bl_out.channel_stride) = *x;
+		length -= L;
+	}
 }
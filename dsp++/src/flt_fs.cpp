@@ -94,15 +94,13 @@ unsigned fir_fs_impl(
 {
 #if DSP_FFTW_DISABLED
 	fir_fs_check_preconditions(point_count, freqs);
-	if (!dsp::ispow2(fir_fs_length(order, amps)))
-		throw std::invalid_argument("dsp::fir::fs::design(): with fftw disabled only filters of power-of-2 length allowed");
 	dsp::trivial_array<std::complex<double>> H(order + 1);
 #else // !DSP_FFTW_DISABLED
 	dsp::trivial_array<std::complex<double>, dsp::dft::fftw::allocator<std::complex<double> > > H(order + 1);
 #endif // !DSP_FFTW_DISABLED
 
 	unsigned n = dsp::fir::fs::design(order, point_count, freqs, amps, H.begin());
-	if (dsp::ispow2(n)) {
+	if (DSP_FFTW_DISABLED || dsp::ispow2(n)) {
 		dsp::dft::fft<std::complex<double>, double> fft(n, H.begin(), h);
 		fft();
 	}
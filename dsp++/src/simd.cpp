@@ -21,7 +21,7 @@ void* dsp::simd::detail::generic_aligned_alloc(size_t size)
 #if defined(DSP_OS_ANDROID)
 		ptr = ::memalign(alignment_, size);
 #elif (_POSIX_C_SOURCE >= 200112L) || (_XOPEN_SOURCE >= 600)
-		if (0 != ::posix_memalign(&ptr, size, alignment_))
+		if (0 != ::posix_memalign(&ptr, alignment_, size))
 			ptr = NULL;
 #elif (_ISOC11_SOURCE)
 		ptr = ::aligned_alloc(alignment_, size);
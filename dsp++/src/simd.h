@@ -2,11 +2,32 @@
 #define DSP_INTERNAL_SIMD_H_INCLUDED
 #pragma once
 
+#include <dsp++/simd_kernels.h>
+
 namespace dsp { namespace simd {namespace detail {
 
 void* generic_aligned_alloc(size_t size);
 void generic_aligned_free(void* p);
 
+//! @brief Kernel table used by dsp::simd functions, generic implementations until it's resolved at load time.
+extern kernel_table active_kernels;
+
+//! @brief Fill vector math entries of the kernel table with the best kernels for given feat flags.
+void resolve_vectmath_kernels(kernel_table& k, unsigned feat_flags);
+//! @brief Fill filtering entries of the kernel table with the best kernels for given feat flags.
+void resolve_filter_kernels(kernel_table& k, unsigned feat_flags);
+//! @brief Fill FFT stage entries of the kernel table with the best kernels for given feat flags.
+void resolve_fft_kernels(kernel_table& k, unsigned feat_flags);
+
+//! @brief Generic implementation of dsp::simd::filter_block_biquad() (Transposed Direct-Form II).
+void generic_filter_block_biquad(float* x, size_t L, float* s, const float* m);
+
+//! @brief Generic implementations of kernel_table::fft_radix2 (fft_radix2d) and fft_radix4 (fft_radix4d).
+void generic_fft_radix2(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+void generic_fft_radix2(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+void generic_fft_radix4(std::complex<float>* x, size_t m, size_t count, const std::complex<float>* w);
+void generic_fft_radix4(std::complex<double>* x, size_t m, size_t count, const std::complex<double>* w);
+
 } } }
 
 #endif /* DSP_INTERNAL_SIMD_H_INCLUDED */
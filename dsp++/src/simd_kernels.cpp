@@ -0,0 +1,71 @@
+/*!
+ * @file simd_kernels.cpp
+ * @brief Load-time resolution of the kernels used by dsp::simd functions.
+ */
+#include <dsp++/simd_kernels.h>
+#include <dsp++/simd.h>
+#include <dsp++/vectmath.h>
+#include <dsp++/filter.h>
+
+#include "simd.h"
+
+// Generic implementations are set up through constant initialization, so that the table is usable even by code
+// running from static initializers of other translation units, before it is resolved below.
+dsp::simd::kernel_table dsp::simd::detail::active_kernels = {
+	0,
+	dsp::mul<float>,
+	dsp::mul<float>,
+	dsp::mul<std::complex<float> >,
+	dsp::div<float>,
+	dsp::div<float>,
+	dsp::add<float>,
+	dsp::add<float>,
+	dsp::sub<float>,
+	dsp::sub<float>,
+	dsp::dot<float>,
+	dsp::dot<std::complex<float> >,
+	dsp::sqrt<float>,
+	dsp::recip<float>,
+	dsp::rsqrt<float>,
+	dsp::log2<float>,
+	dsp::exp2<float>,
+	dsp::filter_sample_df2<float>,
+	dsp::filter_sample_tdf2<float>,
+	dsp::filter_sample_sos_df2<float>,
+	dsp::filter_block_fir<float>,
+	dsp::simd::detail::generic_filter_block_biquad,
+	dsp::filter_sos_lanes_tdf2<float>,
+	dsp::simd::detail::generic_fft_radix2,
+	dsp::simd::detail::generic_fft_radix4,
+	dsp::simd::detail::generic_fft_radix2,
+	dsp::simd::detail::generic_fft_radix4,
+};
+
+namespace {
+const bool kernels_resolved_ = (dsp::simd::reset_kernels(), true);
+}
+
+dsp::simd::kernel_table dsp::simd::resolve_kernels(unsigned feat_flags)
+{
+	kernel_table k;
+	k.feat_flags = feat_flags;
+	detail::resolve_vectmath_kernels(k, feat_flags);
+	detail::resolve_filter_kernels(k, feat_flags);
+	detail::resolve_fft_kernels(k, feat_flags);
+	return k;
+}
+
+const dsp::simd::kernel_table& dsp::simd::kernels()
+{
+	return detail::active_kernels;
+}
+
+void dsp::simd::set_kernels(const kernel_table& table)
+{
+	detail::active_kernels = table;
+}
+
+void dsp::simd::reset_kernels()
+{
+	detail::active_kernels = resolve_kernels(DSP_SIMD_FEATURES);
+}
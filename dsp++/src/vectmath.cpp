@@ -5,173 +5,184 @@
 #include <dsp++/platform.h>
 #include <dsp++/simd.h>
 #include <dsp++/vectmath.h>
+#include <dsp++/simd_kernels.h>
 #include <cmath>
 #include <cstring>
 
+#include "simd.h"
+
 #ifdef DSP_ARCH_FAMILY_X86
 #include "arch/x86/sse.h"
+#include "arch/x86/avx.h"
 #endif // DSP_ARCH_FAMILY_X86
 
-#define noop() ((void)0)
+#ifdef DSP_ARCH_FAMILY_ARM
+#include "arch/arm/neon.h"
+#endif // DSP_ARCH_FAMILY_ARM
 
 namespace dsp { namespace simd { namespace detail { } } }
 using namespace dsp::simd::detail;
 
-float dsp::simd::dot(const float* v0, const float* v1, size_t len)
+void dsp::simd::detail::resolve_vectmath_kernels(kernel_table& k, unsigned feat_flags)
 {
-	if (false) noop();
+	k.mul = dsp::mul<float>;
+	k.mul_scalar = dsp::mul<float>;
+	k.mul_complex = dsp::mul<std::complex<float> >;
+	k.div = dsp::div<float>;
+	k.div_scalar = dsp::div<float>;
+	k.add = dsp::add<float>;
+	k.add_scalar = dsp::add<float>;
+	k.sub = dsp::sub<float>;
+	k.sub_scalar = dsp::sub<float>;
+	k.dot = dsp::dot<float>;
+	k.dot_complex = dsp::dot<std::complex<float> >;
+	k.sqrt = dsp::sqrt<float>;
+	k.recip = dsp::recip<float>;
+	k.rsqrt = dsp::rsqrt<float>;
+	k.log2 = dsp::log2<float>;
+	k.exp2 = dsp::exp2<float>;
+
+	// Each instruction set overrides the kernels it has implementations for, so go from the oldest to the newest.
 #ifdef DSP_ARCH_FAMILY_X86
-	// TODO uncomment SSE4.1 block in dsp::simd::dot() when x86_sse41_dotf() is optimized
-	//else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse41)
-	//	return x86_sse41_dotf(v0, v1, len);
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse3)
-		return x86_sse3_dotf(v0, v1, len);
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		return x86_sse_dotf(v0, v1, len);
+	if (feat_flags & dsp::simd::feat::x86_sse) {
+		k.mul = x86_sse_mulf;
+		k.mul_scalar = x86_sse_mulf;
+		k.mul_complex = x86_sse_mulcf;
+		k.div = x86_sse_divf;
+		k.div_scalar = x86_sse_divf;
+		k.add = x86_sse_addf;
+		k.add_scalar = x86_sse_addf;
+		k.sub = x86_sse_subf;
+		k.sub_scalar = x86_sse_subf;
+		k.dot = x86_sse_dotf;
+		k.dot_complex = x86_sse_dotcf;
+		k.sqrt = x86_sse_sqrtf;
+		k.recip = x86_sse_rcpf;
+		k.rsqrt = x86_sse_rsqrtf;
+	}
+	if (feat_flags & dsp::simd::feat::x86_sse2) {
+		k.log2 = x86_sse2_log2f;
+		k.exp2 = x86_sse2_exp2f;
+	}
+	if (feat_flags & dsp::simd::feat::x86_sse3)
+		k.dot = x86_sse3_dotf;
+	// TODO use x86_sse41_dotf() for SSE4.1 when it is optimized
+#if !DSP_SIMD_AVX_DISABLED
+	if (feat_flags & dsp::simd::feat::x86_avx) {
+		k.mul = x86_avx_mulf;
+		k.mul_scalar = x86_avx_mulf;
+		k.div = x86_avx_divf;
+		k.div_scalar = x86_avx_divf;
+		k.add = x86_avx_addf;
+		k.add_scalar = x86_avx_addf;
+		k.sub = x86_avx_subf;
+		k.sub_scalar = x86_avx_subf;
+		k.dot = x86_avx_dotf;
+		k.sqrt = x86_avx_sqrtf;
+		k.recip = x86_avx_rcpf;
+		k.rsqrt = x86_avx_rsqrtf;
+	}
+	if (x86_fma_mask == (feat_flags & x86_fma_mask))
+		k.dot = x86_fma_dotf;
+#endif // !DSP_SIMD_AVX_DISABLED
 #endif // DSP_ARCH_FAMILY_X86
-	else
-		return dsp::dot(v0, v1, len);
+
+#if defined(DSP_ARCH_FAMILY_ARM) && !DSP_SIMD_NEON_DISABLED
+	if (feat_flags & dsp::simd::feat::arm_neon) {
+		k.mul = arm_neon_mulf;
+		k.mul_scalar = arm_neon_mulf;
+		k.mul_complex = arm_neon_mulcf;
+		k.div = arm_neon_divf;
+		k.div_scalar = arm_neon_divf;
+		k.add = arm_neon_addf;
+		k.add_scalar = arm_neon_addf;
+		k.sub = arm_neon_subf;
+		k.sub_scalar = arm_neon_subf;
+		k.dot = arm_neon_dotf;
+		k.dot_complex = arm_neon_dotcf;
+		k.sqrt = arm_neon_sqrtf;
+		k.recip = arm_neon_rcpf;
+		k.rsqrt = arm_neon_rsqrtf;
+	}
+#endif // DSP_ARCH_FAMILY_ARM
+}
+
+float dsp::simd::dot(const float* v0, const float* v1, size_t len)
+{
+	return active_kernels.dot(v0, v1, len);
 }
 
 std::complex<float> dsp::simd::dot(const std::complex<float>* a, const std::complex<float>* b, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		return x86_sse_dotcf(a, b, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		return dsp::dot(a, b, len);
+	return active_kernels.dot_complex(a, b, len);
 }
 
 void dsp::simd::mul(float* res, const float* a, const float* b, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_mulf(res, a, b, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::mul(res, a, b, len);
+	active_kernels.mul(res, a, b, len);
 }
 
 void dsp::simd::mul(float* res, const float* a, float s, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_mulf(res, a, s, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::mul(res, a, s, len);
+	active_kernels.mul_scalar(res, a, s, len);
 }
 
 void dsp::simd::div(float* res, const float* a, const float* b, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_divf(res, a, b, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::div(res, a, b, len);
+	active_kernels.div(res, a, b, len);
 }
 
 void dsp::simd::div(float* res, const float* a, float s, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_divf(res, a, s, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::div(res, a, s, len);
+	active_kernels.div_scalar(res, a, s, len);
 }
 
 void dsp::simd::add(float* res, const float* a, const float* b, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_addf(res, a, b, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::add(res, a, b, len);
+	active_kernels.add(res, a, b, len);
 }
 
 void dsp::simd::add(float* res, const float* a, float s, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_addf(res, a, s, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::add(res, a, s, len);
+	active_kernels.add_scalar(res, a, s, len);
 }
 
 void dsp::simd::sub(float* res, const float* a, const float* b, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_subf(res, a, b, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::sub(res, a, b, len);
+	active_kernels.sub(res, a, b, len);
 }
 
 void dsp::simd::sub(float* res, const float* a, float s, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_subf(res, a, s, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::sub(res, a, s, len);
+	active_kernels.sub_scalar(res, a, s, len);
 }
 
 void dsp::simd::mul(std::complex<float>* res, const std::complex<float>* a, const std::complex<float>* b, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_mulcf(res, a, b, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::mul(res, a, b, len);
+	active_kernels.mul_complex(res, a, b, len);
 }
 
 void dsp::simd::sqrt(float* res, const float* a, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_sqrtf(res, a, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::sqrt(res, a, len);
+	active_kernels.sqrt(res, a, len);
 }
 
 void dsp::simd::recip(float* res, const float* a, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_rcpf(res, a, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::recip(res, a, len);
+	active_kernels.recip(res, a, len);
 }
 
 void dsp::simd::rsqrt(float* res, const float* a, size_t len)
 {
-	if (false) noop();
-#ifdef DSP_ARCH_FAMILY_X86
-	else if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
-		x86_sse_rsqrtf(res, a, len);
-#endif // DSP_ARCH_FAMILY_X86
-	else
-		dsp::rsqrt(res, a, len);
+	active_kernels.rsqrt(res, a, len);
+}
+
+void dsp::simd::log2(float* res, const float* a, size_t len)
+{
+	active_kernels.log2(res, a, len);
+}
+
+void dsp::simd::exp2(float* res, const float* a, size_t len)
+{
+	active_kernels.exp2(res, a, len);
 }
@@ -0,0 +1,107 @@
+/*!
+ * @file dynamics_test.cpp
+ *
+ * @author Andrzej Ciarkowski <mailto:andrzej.ciarkowski@gmail.com>
+ */
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <dsp++/dynamics.h>
+
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(dynamics)
+
+namespace {
+
+const size_t length = 48000;
+
+// Noise bursts of varying level (-60dB to 0dB) separated by silence, long enough for attack and release to settle.
+void generate(std::vector<float>& x)
+{
+	x.resize(length);
+	unsigned seed = 12345;
+	for (size_t i = 0; i < length; ++i) {
+		seed = seed * 1664525u + 1013904223u;
+		const float noise = static_cast<float>(seed >> 8) / (1 << 24) - 0.5f;
+		const size_t burst = i / 4000;
+		x[i] = (burst % 3 == 2 ? 0.f : noise * std::pow(10.f, -3.f * (burst % 5) / 4.f));
+	}
+}
+
+void setup(dsp::compressor<float>& c)
+{
+	c.set_threshold_dB(-20.f);
+	c.set_ratio(4.f);
+	c.set_gain_dB(6.f);
+	c.set_attack(240);
+	c.set_release(2400);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(compressor_block)
+{
+	std::vector<float> x, ys(length), yb(length), cs(length), cb(length);
+	generate(x);
+
+	dsp::compressor<float> per_sample(480), block(480);
+	setup(per_sample);
+	setup(block);
+
+	for (size_t i = 0; i < length; ++i)
+		ys[i] = per_sample(x[i], &cs[i]);
+	// odd block length to exercise partial chunks
+	for (size_t i = 0; i < length; i += 509)
+		block(&x[i], &yb[i], std::min<size_t>(509, length - i), &cb[i]);
+
+	float err = 0.f, err_dB = 0.f;
+	for (size_t i = 0; i < length; ++i) {
+		BOOST_REQUIRE(std::abs(yb[i]) <= 10.f);	// finite, silence included
+		if (0.f != ys[i])
+			err = std::max(err, std::abs(yb[i] - ys[i]) / std::abs(ys[i]));
+		if (0.f != x[i])
+			err_dB = std::max(err_dB, std::abs(cb[i] - cs[i]));
+	}
+	printf("compressor block rel err:\t%g, dB err:\t%g\n", err, err_dB);
+	BOOST_CHECK(err < 1e-4f);
+	BOOST_CHECK(err_dB < 1e-3f);
+}
+
+BOOST_AUTO_TEST_CASE(compressor_perf)
+{
+	std::vector<float> x, y(length);
+	generate(x);
+	dsp::compressor<float> per_sample(480), block(480);
+	setup(per_sample);
+	setup(block);
+
+	// 100 passes over 1 s of signal, best of 3 runs so that a single preemption doesn't decide the outcome
+	const int iter_count = 100;
+	std::clock_t per_sample_time = 0, block_time = 0;
+	for (int r = 0; r < 3; ++r) {
+		std::clock_t t = std::clock();
+		for (int k = 0; k < iter_count; ++k)
+			for (size_t i = 0; i < length; ++i)
+				y[i] = per_sample(x[i]);
+		t = std::clock() - t;
+		if (0 == r || t < per_sample_time)
+			per_sample_time = t;
+
+		t = std::clock();
+		for (int k = 0; k < iter_count; ++k)
+			for (size_t i = 0; i < length; i += 512)
+				block(&x[i], &y[i], std::min<size_t>(512, length - i));
+		t = std::clock() - t;
+		if (0 == r || t < block_time)
+			block_time = t;
+	}
+	printf("compressor:\t%g ms, compressor block:\t%g ms\n",
+			1000. * per_sample_time / CLOCKS_PER_SEC, 1000. * block_time / CLOCKS_PER_SEC);
+	BOOST_CHECK(block_time <= per_sample_time);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
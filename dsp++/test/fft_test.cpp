@@ -13,9 +13,14 @@
 #include <stdexcept>
 #include <dsp++/fftw/dft.h>
 #include <dsp++/fft.h>
+#include <dsp++/pow2.h>
+#include <dsp++/simd.h>
+#include <dsp++/simd_kernels.h>
 #include <vector>
 #include <functional>
 #include <algorithm>
+#include <string>
+#include <thread>
 
 typedef std::vector<std::complex<float>, dsp::dft::fftw::allocator<std::complex<float> > > fcvec;
 typedef std::vector<float, dsp::dft::fftw::allocator<float> > fvec;
@@ -32,7 +37,12 @@ BOOST_AUTO_TEST_CASE(test_fft_64)
 
 BOOST_AUTO_TEST_CASE(test_fft_65)
 {
-	BOOST_CHECK_THROW(fftf(65, NULL, NULL), std::domain_error);
+	BOOST_CHECK_NO_THROW(fftf(65, NULL, NULL));
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_1)
+{
+	BOOST_CHECK_THROW(fftf(1, NULL, NULL), std::out_of_range);
 }
 
 BOOST_AUTO_TEST_CASE(test_fft_536870912)
@@ -76,6 +86,65 @@ BOOST_AUTO_TEST_CASE(test_fft_r2c)
 			dsp::within_range<std::complex<float> >(std::numeric_limits<float>::epsilon() * 1000)));
 }
 
+BOOST_AUTO_TEST_CASE(test_fftw_plan_cache)
+{
+	const size_t N = 1000;
+	fvec in1(N), in2(N);
+	fcvec out1(N / 2 + 1), out2(N / 2 + 1);
+	dsp::dft::fftw::dft<float, std::complex<float> > dft1(N, &in1[0], &out1[0]);
+	const size_t cached = dsp::dft::fftw::plan_cache::size();
+	dsp::dft::fftw::dft<float, std::complex<float> > dft2(N, &in2[0], &out2[0]);
+	BOOST_CHECK_EQUAL(cached, dsp::dft::fftw::plan_cache::size());
+
+	std::copy(fin, fin + N, in1.begin());
+	std::copy(fin, fin + N, in2.begin());
+	dft1();
+	dft2();
+	BOOST_CHECK(std::equal(out1.begin(), out1.end(), out2.begin()));
+
+	const std::string wisdom = dsp::dft::fftw::plan<float>::export_wisdom_string();
+	BOOST_CHECK(dsp::dft::fftw::plan<float>::import_wisdom_string(wisdom));
+}
+
+BOOST_AUTO_TEST_CASE(test_fftw_plan_cache_capacity)
+{
+	typedef dsp::dft::fftw::plan_cache cache;
+	const size_t N = 512;
+	fvec in(N);
+	fcvec out(N / 2 + 1);
+	dsp::dft::fftw::dft<float, std::complex<float> > used(N, &in[0], &out[0]);
+	cache::set_capacity(2);
+	BOOST_CHECK(cache::size() <= 2);
+	// plans released by their dft objects are evicted, the one still in use is kept
+	for (size_t n = N / 2; n > N / 16; n /= 2)
+		dsp::dft::fftw::dft<float, std::complex<float> >(n, &in[0], &out[0]);
+	BOOST_CHECK_EQUAL(2, cache::size());
+	dsp::dft::fftw::dft<float, std::complex<float> > reused(N, &in[0], &out[0]);
+	BOOST_CHECK_EQUAL(2, cache::size());
+
+	cache::set_capacity(0);
+	BOOST_CHECK_EQUAL(1, cache::size());
+	cache::set_capacity(cache::default_capacity);
+}
+
+BOOST_AUTO_TEST_CASE(test_fftw_threads)
+{
+	const size_t N = 1024;
+	fcvec in(N), out1(N), out2(N);
+	for (size_t i = 0; i < N; ++i)
+		in[i] = std::complex<float>(fin[i], fin[N - 1 - i]);
+
+	dsp::dft::fftw::dft<std::complex<float>, std::complex<float> > dft1(N, &in[0], &out1[0], dsp::dft::sign::forward,
+			dsp::dft::fftw::flag::estimate, 1);
+	dsp::dft::fftw::dft<std::complex<float>, std::complex<float> > dft2(N, &in[0], &out2[0], dsp::dft::sign::forward,
+			dsp::dft::fftw::flag::estimate, 4);
+	BOOST_CHECK_EQUAL(!DSP_FFTW_THREADS_DISABLED, dsp::dft::fftw::plan<float>::init_threads());
+	dft1();
+	dft2();
+	BOOST_CHECK(std::equal(out1.begin(), out1.end(), out2.begin(),
+			dsp::within_range<std::complex<float> >(std::numeric_limits<float>::epsilon() * 100)));
+}
+
 BOOST_AUTO_TEST_CASE(test_fft_two_way)
 {
 	const size_t N = 256;
@@ -96,4 +165,252 @@ BOOST_AUTO_TEST_CASE(test_fft_two_way)
 			dsp::within_range<std::complex<float> >(std::numeric_limits<float>::epsilon() * 10)));
 }
 
+static void naive_dft(const std::complex<double>* in, std::complex<double>* out, size_t N, int sign)
+{
+	for (size_t k = 0; k < N; ++k) {
+		out[k] = 0.;
+		for (size_t n = 0; n < N; ++n)
+			out[k] += in[n] * std::polar(1., sign * 2 * DSP_M_PI * ((k * n) % N) / N);
+	}
+}
+
+template<class Real = float>
+static void check_fft_equals_dft(size_t N, dsp::dft::sign::spec sign)
+{
+	std::vector<std::complex<double> > in(N), ref(N);
+	std::vector<std::complex<Real> > out(N);
+	for (size_t i = 0; i < N; ++i)
+		out[i] = in[i] = std::complex<double>(fin[i % 1024], fin[(i + 512) % 1024]);
+
+	naive_dft(&in[0], &ref[0], N, sign);
+	dsp::dft::fft<std::complex<Real>, std::complex<Real> > fft(N, NULL, NULL, sign);
+	fft(&out[0], NULL);
+
+	double err = 0.;
+	for (size_t i = 0; i < N; ++i)
+		err = std::max(err, std::abs(ref[i] - std::complex<double>(out[i])));
+	BOOST_CHECK_MESSAGE(err < std::sqrt(static_cast<double>(N)) * 1e-5, "N=" << N << " error: " << err);
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_mixed_radix)
+{
+	const size_t sizes[] = {3, 6, 12, 15, 49, 60, 98, 121, 960, 1155, 3 * 59};
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		check_fft_equals_dft(sizes[i], dsp::dft::sign::forward);
+		check_fft_equals_dft(sizes[i], dsp::dft::sign::backward);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_pow2)
+{
+	for (size_t N = 2; N <= 2048; N *= 2) {
+		check_fft_equals_dft<float>(N, dsp::dft::sign::forward);
+		check_fft_equals_dft<float>(N, dsp::dft::sign::backward);
+		check_fft_equals_dft<double>(N, dsp::dft::sign::forward);
+		check_fft_equals_dft<double>(N, dsp::dft::sign::backward);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_bluestein)
+{
+	const size_t sizes[] = {67, 2 * 127, 1009};
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		check_fft_equals_dft(sizes[i], dsp::dft::sign::forward);
+		check_fft_equals_dft(sizes[i], dsp::dft::sign::backward);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_kernel_table)
+{
+	// radix-2/radix-4 stages are taken from dsp::simd::kernels(), so they follow the table set by the user
+	const dsp::simd::kernel_table generic = dsp::simd::resolve_kernels(0);
+#ifdef DSP_ARCH_FAMILY_X86
+	if (DSP_SIMD_FEATURES & dsp::simd::feat::x86_sse)
+		BOOST_CHECK(dsp::simd::kernels().fft_radix4 != generic.fft_radix4);
+#endif // DSP_ARCH_FAMILY_X86
+	dsp::simd::set_kernels(generic);
+	const size_t sizes[] = {64, 960, 1024};
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		check_fft_equals_dft<float>(sizes[i], dsp::dft::sign::forward);
+		check_fft_equals_dft<double>(sizes[i], dsp::dft::sign::backward);
+	}
+	dsp::simd::reset_kernels();
+	BOOST_CHECK(dsp::simd::kernels().fft_radix4 == dsp::simd::resolve_kernels(DSP_SIMD_FEATURES).fft_radix4);
+}
+
+template<class Real>
+static void check_fft_out_of_place(size_t N, dsp::dft::sign::spec sign)
+{
+	typedef std::complex<Real> cr;
+	std::vector<cr> in(N), ref(N), out(N);
+	for (size_t i = 0; i < N; ++i)
+		ref[i] = in[i] = cr(fin[i % 1024], fin[(i + 512) % 1024]);
+	const std::vector<cr> orig(in);
+
+	dsp::dft::fft<cr, cr> fft(N, NULL, NULL, sign);
+	fft(&ref[0], NULL);
+	fft(static_cast<const cr*>(&in[0]), &out[0]);
+	BOOST_CHECK(in == orig);
+	double err = 0.;
+	for (size_t i = 0; i < N; ++i)
+		err = std::max(err, static_cast<double>(std::abs(ref[i] - out[i])));
+	BOOST_CHECK_MESSAGE(err < std::sqrt(static_cast<double>(N)) * 1e-6, "N=" << N << " error: " << err);
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_out_of_place)
+{
+	const size_t sizes[] = {2, 4, 16, 60, 67, 256, 1155, 4096};
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		check_fft_out_of_place<float>(sizes[i], dsp::dft::sign::forward);
+		check_fft_out_of_place<float>(sizes[i], dsp::dft::sign::backward);
+		check_fft_out_of_place<double>(sizes[i], dsp::dft::sign::forward);
+		check_fft_out_of_place<double>(sizes[i], dsp::dft::sign::backward);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_real)
+{
+	const size_t sizes[] = {2, 3, 8, 15, 16, 60, 64, 98, 960, 1024, 2 * 1009};
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		const size_t N = sizes[i];
+		std::vector<std::complex<double> > ref_in(N), ref(N);
+		std::vector<float> in(N), res(N);
+		std::vector<std::complex<float> > out(N / 2 + 1);
+		for (size_t n = 0; n < N; ++n)
+			ref_in[n] = in[n] = fin[n % 1024];
+		naive_dft(&ref_in[0], &ref[0], N, dsp::dft::sign::forward);
+
+		dsp::dft::fft<float, std::complex<float> > fft(N, &in[0], &out[0]);
+		fft();
+		double err = 0.;
+		for (size_t k = 0; k <= N / 2; ++k)
+			err = std::max(err, std::abs(ref[k] - std::complex<double>(out[k])));
+		BOOST_CHECK_MESSAGE(err < std::sqrt(static_cast<double>(N)) * 1e-5, "N=" << N << " error: " << err);
+
+		dsp::dft::fft<std::complex<float>, float> ifft(N, &out[0], &res[0]);
+		ifft();
+		err = 0.;
+		for (size_t n = 0; n < N; ++n)
+			err = std::max(err, std::abs(static_cast<double>(res[n]) / N - in[n]));
+		BOOST_CHECK_MESSAGE(err < 1e-5, "N=" << N << " error: " << err);
+	}
+}
+
+// Odd real and Bluestein transforms use scratch storage preallocated by implementations shared by all the fft
+// instances, make sure concurrent invocations (which fall back to temporary buffers) still give the same results.
+template<class Input, class Output>
+static void transform_repeatedly(size_t N, const std::vector<Input>* in, const std::vector<Output>* ref, bool* ok)
+{
+	dsp::dft::fft<Input, Output> fft(N);
+	std::vector<Input> buf(in->size());
+	std::vector<Output> out(ref->size());
+	for (int k = 0; k < 200 && *ok; ++k) {
+		buf = *in;
+		fft(&buf[0], &out[0]);
+		*ok = (out == *ref);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_scratch_concurrent)
+{
+	typedef std::complex<float> cf;
+	const size_t N = 45, M = 67;
+	std::vector<float> rin(N);
+	std::vector<cf> rref(N / 2 + 1), cin(M), cref(M);
+	for (size_t n = 0; n < N; ++n)
+		rin[n] = fin[n];
+	for (size_t n = 0; n < M; ++n)
+		cin[n] = cf(fin[n], fin[n + 512]);
+	const dsp::dft::fft<float, cf> rfft(N);
+	const dsp::dft::fft<cf, cf> cfft(M);
+	rfft(&rin[0], &rref[0]);
+	cfft(&cin[0], &cref[0]);
+
+	bool ok[4] = {true, true, true, true};
+	std::thread t0(transform_repeatedly<float, cf>, N, &rin, &rref, &ok[0]);
+	std::thread t1(transform_repeatedly<float, cf>, N, &rin, &rref, &ok[1]);
+	std::thread t2(transform_repeatedly<cf, cf>, M, &cin, &cref, &ok[2]);
+	std::thread t3(transform_repeatedly<cf, cf>, M, &cin, &cref, &ok[3]);
+	t0.join(); t1.join(); t2.join(); t3.join();
+	for (int i = 0; i < 4; ++i)
+		BOOST_CHECK(ok[i]);
+}
+
+BOOST_AUTO_TEST_CASE(test_fft_many)
+{
+	typedef std::complex<float> cf;
+	const size_t sizes[] = {2, 16, 60, 67, 1024};
+	const size_t H = 5;
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+		const size_t N = sizes[i], K = N / 2 + 1;
+		std::vector<cf> in(N * H), ref(N * H), out(N * H), inter(N * H);
+		std::vector<float> rin(N * H), rres(N * H);
+		std::vector<cf> rref(K * H), rout(K * H);
+		for (size_t n = 0; n < N * H; ++n) {
+			in[n] = cf(fin[n % 1024], fin[(n + 512) % 1024]);
+			rin[n] = fin[(n + 256) % 1024];
+		}
+		fftf single(N, NULL, NULL);
+		dsp::dft::fft<float, cf> rsingle(N, NULL, NULL);
+		for (size_t t = 0; t < H; ++t) {
+			single(&in[t * N], &ref[t * N]);
+			rsingle(&rin[t * N], &rref[t * K]);
+		}
+
+		// back-to-back sequences, out-of-place and in-place
+		fftf many(N, H, &in[0], 1, N, &out[0], 1, N);
+		BOOST_CHECK_EQUAL(many.howmany(), H);
+		many();
+		double err = 0.;
+		for (size_t n = 0; n < N * H; ++n)
+			err = std::max(err, static_cast<double>(std::abs(ref[n] - out[n])));
+		BOOST_CHECK_MESSAGE(err < 1e-4, "N=" << N << " contiguous error: " << err);
+		std::copy(in.begin(), in.end(), out.begin());
+		fftf(N, H, &out[0], 1, N, NULL, 1, N)();
+		err = 0.;
+		for (size_t n = 0; n < N * H; ++n)
+			err = std::max(err, static_cast<double>(std::abs(ref[n] - out[n])));
+		BOOST_CHECK_MESSAGE(err < 1e-4, "N=" << N << " in-place error: " << err);
+
+		// interleaved sequences (channel-major layout)
+		for (size_t t = 0; t < H; ++t)
+			for (size_t n = 0; n < N; ++n)
+				inter[n * H + t] = in[t * N + n];
+		fftf(N, H, &inter[0], H, 1, &out[0], H, 1)();
+		err = 0.;
+		for (size_t t = 0; t < H; ++t)
+			for (size_t n = 0; n < N; ++n)
+				err = std::max(err, static_cast<double>(std::abs(ref[t * N + n] - out[n * H + t])));
+		BOOST_CHECK_MESSAGE(err < 1e-4, "N=" << N << " interleaved error: " << err);
+
+		// real-to-complex and back
+		dsp::dft::fft<float, cf>(N, H, &rin[0], 1, N, &rout[0], 1, K)();
+		err = 0.;
+		for (size_t n = 0; n < K * H; ++n)
+			err = std::max(err, static_cast<double>(std::abs(rref[n] - rout[n])));
+		BOOST_CHECK_MESSAGE(err < 1e-4, "N=" << N << " r2c error: " << err);
+		dsp::dft::fft<cf, float>(N, H, &rout[0], 1, K, &rres[0], H, 1)();
+		err = 0.;
+		for (size_t t = 0; t < H; ++t)
+			for (size_t n = 0; n < N; ++n)
+				err = std::max(err, std::abs(static_cast<double>(rres[n * H + t]) / N - rin[t * N + n]));
+		BOOST_CHECK_MESSAGE(err < 1e-5, "N=" << N << " c2r error: " << err);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_fast_length)
+{
+	BOOST_CHECK_EQUAL(dsp::dft::fast_length(0), 2);
+	BOOST_CHECK_EQUAL(dsp::dft::fast_length(1024), 1024);
+	for (size_t n = 3; n < 5000; n += 7) {
+		size_t N = dsp::dft::fast_length(n);
+		BOOST_CHECK(N >= n && N <= dsp::nextpow2(n));
+		while (0 == N % 2) N /= 2;
+		while (0 == N % 3) N /= 3;
+		while (0 == N % 5) N /= 5;
+		while (0 == N % 7) N /= 7;
+		BOOST_CHECK_EQUAL(N, 1);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,9 @@
 
 #include <dsp++/mean.h>
 
+#include <algorithm>
+#include <cmath>
+
 BOOST_AUTO_TEST_SUITE(mean)
 
 BOOST_AUTO_TEST_CASE(arithmetic)
@@ -46,4 +49,17 @@ BOOST_AUTO_TEST_CASE(harmonic)
 	BOOST_CHECK(y[149] = 26.827965511373677f);
 }
 
+BOOST_AUTO_TEST_CASE(quadratic_block)
+{
+	float x[150], y[150], yb[150];
+	dsp::quadratic_mean<float> ps(40), bl(40);
+	for (int i = 0; i < 150; ++i) {
+		x[i] = std::sin(i * 0.1f);
+		y[i] = ps(x[i]);
+	}
+	bl(x, yb, 67);
+	bl(x + 67, yb + 67, 83);
+	BOOST_CHECK(std::equal(y, y + 150, yb));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -7,11 +7,16 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <dsp++/simd.h>
+#include <dsp++/simd_kernels.h>
 #include <dsp++/vectmath.h>
 #include <dsp++/float.h>
 #include <dsp++/norm.h>
 #include "execution_timer.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using dsp::test::execution_timer;
 
 const size_t N = 1024;
@@ -298,4 +303,89 @@ BOOST_AUTO_TEST_CASE(rsqrt)
 	BOOST_CHECK(err < 1e-3);
 }
 
+BOOST_AUTO_TEST_CASE(log2)
+{
+	float DSP_ALIGNED(16) outs[N], outv[N];
+	float DSP_ALIGNED(16) absin[N];
+	for (size_t i = 0; i < N; ++i)
+		absin[i] = std::ldexp(std::abs(a[i]) + 1e-3f, static_cast<int>(i % 200) - 100);
+
+	et.start("log2");
+	for (int i = 0; i < iter_count; ++i)
+		dsp::log2(outv, absin, N);
+	for (size_t i = 0; i < N; ++i)	// float reference rounds the product, compare with double one
+		outv[i] = static_cast<float>(std::log(static_cast<double>(absin[i])) / std::log(2.));
+
+	et.next("log2 simd");
+	for (int i = 0; i < iter_count; ++i)
+		dsp::simd::log2(outs, absin, N);
+
+	et.stop();
+	float err = dsp::norm_inf<dsp::norm::abs>(outs, outv, N);
+	printf("log2 err:\t%g\n", err);
+	BOOST_CHECK(err < 1e-5);	// 1 ulp of values up to 128
+}
+
+BOOST_AUTO_TEST_CASE(log2_clamp)
+{
+	// non-positive and denormal arguments give the same finite result with every kernel
+	float DSP_ALIGNED(16) in[4] = {0.f, -1.f, std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min()};
+	float DSP_ALIGNED(16) outs[4], outv[4];
+	dsp::log2(outv, in, 4);
+	dsp::simd::log2(outs, in, 4);
+	for (size_t i = 0; i < 4; ++i) {
+		BOOST_CHECK_CLOSE(outv[i], -126.f, 1e-4);
+		BOOST_CHECK_CLOSE(outs[i], outv[i], 1e-4);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(exp2)
+{
+	float DSP_ALIGNED(16) outs[N], outv[N];
+	float DSP_ALIGNED(16) in[N];
+	for (size_t i = 0; i < N; ++i)
+		in[i] = 20.f * a[i];
+
+	et.start("exp2");
+	for (int i = 0; i < iter_count; ++i)
+		dsp::exp2(outv, in, N);
+	for (size_t i = 0; i < N; ++i)
+		outv[i] = static_cast<float>(std::exp(in[i] * std::log(2.)));
+
+	et.next("exp2 simd");
+	for (int i = 0; i < iter_count; ++i)
+		dsp::simd::exp2(outs, in, N);
+
+	et.stop();
+	float err = 0.f;
+	for (size_t i = 0; i < N; ++i)
+		err = std::max(err, std::abs(outs[i] - outv[i]) / outv[i]);
+	printf("exp2 rel err:\t%g\n", err);
+	BOOST_CHECK(err < 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(kernel_table)
+{
+	const size_t n = 1021; // not a multiple of SIMD vector length, only padded ones are processed by SSE kernels
+	const dsp::simd::kernel_table generic = dsp::simd::resolve_kernels(0);
+	BOOST_CHECK_EQUAL(generic.feat_flags, 0u);
+	BOOST_CHECK_EQUAL(dsp::simd::kernels().feat_flags, static_cast<unsigned>(DSP_SIMD_FEATURES));
+
+	// forcing generic kernels must give exactly the naive results
+	dsp::simd::set_kernels(generic);
+	BOOST_CHECK_EQUAL(dsp::simd::kernels().feat_flags, 0u);
+	BOOST_CHECK_EQUAL(dsp::simd::dot(a, b, n), dsp::dot(a, b, n));
+	float DSP_ALIGNED(16) outs[N], outv[N];
+	dsp::simd::mul(outs, a, b, n);
+	dsp::mul(outv, a, b, n);
+	BOOST_CHECK(std::equal(outs, outs + n, outv));
+
+	dsp::simd::reset_kernels();
+	BOOST_CHECK_EQUAL(dsp::simd::kernels().feat_flags, static_cast<unsigned>(DSP_SIMD_FEATURES));
+	const size_t len = N;
+	const float ref = dsp::dot(a, b, len);
+	BOOST_CHECK_CLOSE(dsp::simd::kernels().dot(a, b, len), ref, 1e-2);
+	BOOST_CHECK_CLOSE(dsp::simd::dot(a, b, len), ref, 1e-2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,86 @@
+/*!
+ * @file multiband_compressor/benchmark/main.cpp
+ * @brief Throughput benchmark of dsp::rt::multiband_compressor.
+ * For each channel count & band count processes a fixed duration of noise and reports real-time factor
+ * (seconds of audio processed per wall-clock second) and throughput in channels x bands per core, that is
+ * the number of band-channels a single core could process in real-time (based on the CPU time of all threads).
+ * Usage: multiband_compressor_benchmark [block_size [duration_s [fir|lr4 [thread_count]]]]
+ */
+#include <dsp++/rt/multiband_compressor.h>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+typedef dsp::rt::multiband_compressor mbc;
+
+static mbc::params make_params(unsigned sample_rate, unsigned channel_count, unsigned block_size, unsigned band_count, mbc::crossover_type crossover, unsigned thread_count) {
+	mbc::params p;
+	p.sample_rate = sample_rate;
+	p.channel_count = channel_count;
+	p.block_size = block_size;
+	p.max_band_count = band_count;
+	p.crossover = crossover;
+	p.thread_count = thread_count;
+	p.worker_priority = 0;
+	p.limiter_threshold_dB = -1.f;
+	p.limiter_bypass = false;
+
+	mbc::band_params b;
+	b.envelope_period_ms = 10.f;
+	b.threshold_dB = -20.f;
+	b.gain_dB = 6.f;
+	b.ratio = 4.f;
+	b.attack_ms = 5.f;
+	b.release_ms = 50.f;
+	b.bypass = false;
+	b.mute = false;
+	p.bands.assign(band_count, b);
+
+	// crossovers spaced logarithmically between 100 Hz and 10 kHz
+	for (unsigned i = 1; i < band_count; ++i)
+		p.crossover_frequencies.push_back(100.f * std::pow(100.f, (i - 1.f) / std::max(band_count - 2.f, 1.f)));
+	return p;
+}
+
+int main(int argc, const char* argv[]) {
+	const unsigned sample_rate = 48000;
+	const unsigned block_size = (argc > 1 ? std::atoi(argv[1]) : 256);
+	const double duration_s = (argc > 2 ? std::atof(argv[2]) : 10.);
+	const mbc::crossover_type crossover = (argc > 3 && 0 == std::strcmp(argv[3], "lr4") ? mbc::crossover_lr4 : mbc::crossover_fir);
+	const unsigned thread_count = (argc > 4 ? std::atoi(argv[4]) : 1);
+	const unsigned channel_counts[] = {1, 2, 6, 8, 16};
+	const unsigned band_counts[] = {1, 2, 3, 4, 6, 8};
+
+	std::printf("block_size: %u, duration: %g s, crossover: %s, threads: %u\n", block_size, duration_s, (mbc::crossover_lr4 == crossover ? "lr4" : "fir"), thread_count);
+	std::printf("%8s %6s %12s %20s\n", "channels", "bands", "realtime", "channels*bands/core");
+	for (size_t ci = 0; ci < sizeof(channel_counts) / sizeof(channel_counts[0]); ++ci) {
+		for (size_t bi = 0; bi < sizeof(band_counts) / sizeof(band_counts[0]); ++bi) {
+			const unsigned cc = channel_counts[ci], bc = band_counts[bi];
+			mbc m(make_params(sample_rate, cc, block_size, bc, crossover, thread_count));
+
+			std::vector<float> in(cc * block_size), out(cc * block_size);
+			for (size_t i = 0; i < in.size(); ++i)
+				in[i] = std::rand() / (RAND_MAX + 1.f) - .5f;
+
+			const size_t block_count = static_cast<size_t>(duration_s * sample_rate / block_size);
+			m(&in[0], &out[0]);	// let the crossover filters settle in first
+			const boost::posix_time::ptime wall_start = boost::posix_time::microsec_clock::universal_time();
+			const std::clock_t start = std::clock();
+			for (size_t i = 0; i < block_count; ++i)
+				m(&in[0], &out[0]);
+			const double cpu_s = double(std::clock() - start) / CLOCKS_PER_SEC;
+			const double wall_s = (boost::posix_time::microsec_clock::universal_time() - wall_start).total_microseconds() / 1e6;
+
+			const double audio_s = block_count * block_size / double(sample_rate);
+			std::printf("%8u %6u %12.1f %20.1f\n", cc, bc, audio_s / wall_s, audio_s / cpu_s * cc * bc);
+		}
+	}
+	return EXIT_SUCCESS;
+}
@@ -15,11 +15,32 @@ namespace dsp { namespace rt {
 
 namespace detail { struct mbc_impl;}
 
+/*!
+ * @brief Multiband compressor with tanh-shaped limiter at the output.
+ * Setters & getters may be called from any number of control threads concurrently with operator(), which
+ * never blocks nor allocates memory. Filters are designed and settings are prepared on the calling thread,
+ * then published without locking, and picked up by the processing thread at the start of the next block.
+ * If constructed with nonzero max_band_count, state of all the bands is allocated upfront and no memory is
+ * allocated after construction, neither by the processing thread nor by the control ones. Otherwise adding bands
+ * beyond those allocated so far replaces the state of all the bands, which restarts their filters and compressors.
+ * If constructed with params::thread_count > 1, band filters and compressors are run in parallel by an internal
+ * pool of worker threads together with the thread calling operator(), which waits for them at the end of each
+ * block. The workers run at default priority unless params::worker_priority is set, which a real-time caller
+ * should do to avoid waiting for workers preempted by less important threads.
+ */
 class multiband_compressor {
 public:
 
 	typedef float sample_type; //!< This component uses float type as its sample representation
 
+	static const float envelope_period_ms_default; //!< Envelope period of the bands allocated before their band_params are known.
+
+	//! @brief Type of filters splitting the signal into bands.
+	enum crossover_type {
+		crossover_fir,	//!< Linear-phase FIR filters (Parks-McClellan) realized with FFT convolution; adds latency of half their length.
+		crossover_lr4	//!< 4th-order Linkwitz-Riley IIR filters with allpass phase compensation, realized as cascades of second-order sections; no latency, far less CPU.
+	};
+
 	//! @brief Parameters of a single band.
 	struct band_params 
 	{
@@ -57,14 +78,30 @@ public:
 		std::vector<band_params> bands;				//!< Parameters of compressors in each of the bands.
 		float limiter_threshold_dB;	//!< Threshold above which tanh-shaped limiter is activated, if limiter_bypass is not set.
 		bool limiter_bypass;		//!< Controls whether limiter is enabled.
+		unsigned max_band_count;	//!< Capacity of preallocated band pool; if 0, state of all the bands is reallocated and reset whenever
+									//!< band count grows past the largest one used so far (audible as a discontinuity in the output).
+		crossover_type crossover;	//!< Type of crossover filters, can't be changed after construction.
+		unsigned thread_count;		//!< Number of threads processing the bands in parallel, including the one calling operator(); 0 or 1 disables the worker pool.
+		std::vector<int> cpu_affinity;	//!< CPUs the worker threads are pinned to (worker i to cpu_affinity[i % size()]); empty for no pinning.
+		int worker_priority;		//!< Scheduling priority of the worker threads (SCHED_FIFO priority on POSIX, THREAD_PRIORITY_* on Windows),
+									//!< applied best-effort; 0 keeps the default.
+
+		//! @brief Fields fixed at construction default to a growing band pool, FIR crossover (as in the other constructor)
+		//! and processing on the calling thread only.
+		params(): max_band_count(0), crossover(crossover_fir), thread_count(1), worker_priority(0) {}
 	};
 
-	multiband_compressor(unsigned sample_rate, unsigned channel_count, unsigned block_size);
+	multiband_compressor(unsigned sample_rate, unsigned channel_count, unsigned block_size, unsigned max_band_count = 0, crossover_type crossover = crossover_fir);
 	explicit multiband_compressor(const params& p);
 
 	~multiband_compressor();
 
 	void fill_params(params& p) const;
+	/*!
+	 * @brief Apply all the parameters at once (those fixed at construction are ignored).
+	 * @note May spin like set_crossover_frequency() if the crossover filters change.
+	 * @throw std::length_error if max_band_count() is nonzero and p.bands exceeds it.
+	 */
 	void set_params(const params& p);
 
 	unsigned sample_rate() const;
@@ -73,10 +110,22 @@ public:
 	
 	void fill_format(dsp::snd::format& f) const;
 
+	/*!
+	 * @brief Move crossover frequency index, redesigning the filters of the bands it separates.
+	 * @note With crossover_fir the new filters are staged for the processing thread. If the previous filter
+	 * of the same band is being activated by operator() at the moment, the call spins (yielding the CPU)
+	 * until it is done, which takes less than a single operator() call. The processing thread never waits.
+	 */
 	void set_crossover_frequency(unsigned index, float frequency);
 	float crossover_frequency(unsigned index) const;
 
 	unsigned band_count() const;
+	//! @return capacity of the preallocated band pool, 0 if it's not fixed.
+	unsigned max_band_count() const;
+	//! @return type of crossover filters.
+	crossover_type crossover() const;
+	//! @return number of threads processing the bands, including the one calling operator().
+	unsigned thread_count() const;
 
 	void fill_band_params(unsigned index, band_params& p) const;
 	void set_band_params(unsigned index, const band_params& p);
@@ -87,6 +136,11 @@ public:
 	bool is_limiter_bypass() const;
 	void set_limiter_bypass(bool b);
 
+	/*!
+	 * @brief Process a single block of block_size() interleaved sample frames.
+	 * @param input input samples (block_size() * channel_count()).
+	 * @param output output samples (block_size() * channel_count()).
+	 */
 	void operator()(const sample_type* input, sample_type* output);
 
 private:
@@ -2,82 +2,539 @@
 #include <dsp++/snd/format.h>
 #include <dsp++/filter_design.h>
 #include <dsp++/overlap_add.h>
+#include <dsp++/filter.h>
 #include <dsp++/dynamics.h>
+#include <dsp++/vectmath.h>
+#include <dsp++/stride_iterator.h>
+#include <dsp++/snd/buffer.h>
 
-#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/locks.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/noncopyable.hpp>
 
+#include <climits>
+#include <cmath>
+#include <new>
 #include <stdexcept>
 
+#if defined(_WIN32)
+# include <windows.h>
+#else
+# include <pthread.h>
+# include <sched.h>
+# if defined(__APPLE__)
+#  include <dispatch/dispatch.h>
+# else
+#  include <semaphore.h>
+#  include <cerrno>
+# endif
+#endif
+
 namespace d = dsp;
 namespace s = d::snd;
 namespace r = d::rt;
 namespace det = r::detail;
 
 namespace dsp { namespace rt { namespace detail {
-	typedef boost::upgrade_mutex mutex;
-	typedef boost::shared_lock<mutex> shared_lock;
-	typedef boost::upgrade_lock<mutex> upgrade_lock;
-	typedef boost::unique_lock<mutex> unique_lock;
-	typedef boost::upgrade_to_unique_lock<mutex> upgrade_to_unique_lock;
+	typedef boost::mutex mutex;
+	typedef boost::lock_guard<mutex> lock_guard;
 
 	typedef r::multiband_compressor::sample_type s_t;
+
+	/*!
+	 * @brief Wait-free single-producer, single-consumer triple buffer. Producer fills back() and publishes it,
+	 * consumer picks the most recently published value up with update() and reads it through front(). Neither
+	 * side ever blocks, and the value used by the consumer is never touched by the producer.
+	 */
+	template<class T>
+	class triple_buffer {
+	public:
+		triple_buffer(): back_(0), middle_(1), front_(2) {}
+
+		//! @return value being prepared by the producer.
+		T& back() {return buf_[back_];}
+		//! @brief Make back() visible to the consumer, the producer gets the spare value to prepare next time.
+		void publish() {back_ = middle_.exchange(back_ | dirty, boost::memory_order_acq_rel) & index_mask;}
+
+		//! @return true if a new value was published since the last call and front() has been replaced with it.
+		bool update()
+		{
+			if (!(middle_.load(boost::memory_order_relaxed) & dirty))
+				return false;
+			front_ = middle_.exchange(front_, boost::memory_order_acq_rel) & index_mask;
+			return true;
+		}
+		//! @return value used by the consumer.
+		const T& front() const {return buf_[front_];}
+
+		//! @return any of the values, for initialization only (before producer and consumer start).
+		T& operator[](unsigned index) {return buf_[index];}
+
+	private:
+		enum {index_mask = 3, dirty = 4};
+		T buf_[3];
+		unsigned back_;
+		boost::atomic<unsigned> middle_;
+		unsigned front_;
+	};
+
+	/*!
+	 * @brief Preallocated state of a fixed number of band slots. Band filters, compressors of all the channels and
+	 * band work buffers are laid out in single contiguous block, in the order they are accessed by the processing
+	 * thread: band descriptors (with the filters) first, then compressors (band-major), then work buffers.
+	 * Depending on crossover type, each band uses either FIR filter (realized with FFT convolution) or IIR one
+	 * (cascade of second-order sections).
+	 * @note Buffers owned by the filters and envelope detectors themselves are allocated by them upon construction.
+	 */
+	class band_pool: private boost::noncopyable {
+	public:
+		typedef d::multichannel_overlap_add<s_t> filter_type;
+		typedef d::filter_sos_multichannel<s_t> iir_type;
+		typedef d::compressor<s_t> compressor_type;
+
+		struct band {
+			boost::scoped_ptr<filter_type> filter_;	//!< FIR band filter shared by all the channels, so that they use single copy of its impulse response transform.
+			boost::scoped_ptr<iir_type> iir_;		//!< IIR band filter, processing all the channels in SIMD lanes.
+			compressor_type* compressors_;	//!< Compressors of consecutive channels.
+			s_t* buffer_;					//!< Planar work buffer of channel_count channels, channel_stride() samples each.
+
+			band(r::multiband_compressor::crossover_type crossover, size_t block_size, size_t channel_count, const s_t* ir, size_t ir_length,
+					size_t section_count, compressor_type* c, s_t* buf)
+			 :	compressors_(c)
+			 ,	buffer_(buf)
+			{
+				if (r::multiband_compressor::crossover_fir == crossover)
+					filter_.reset(new filter_type(block_size, channel_count, ir, ir_length, true));
+				else {
+					// start with pass-through sections
+					std::vector<double> num(section_count * iir_type::section_length), den(num.size());
+					for (size_t i = 0; i < num.size(); i += iir_type::section_length)
+						num[i] = den[i] = 1.;
+					iir_.reset(new iir_type(channel_count, section_count, &num[0], &den[0]));
+				}
+			}
+		};
+
+		/*!
+		 * @param capacity number of band slots.
+		 * @param channel_count number of channels.
+		 * @param block_size number of sample frames in a processing block.
+		 * @param envelope_lengths envelope averaging periods (in samples) of consecutive band slots [capacity].
+		 * @param crossover type of band filters.
+		 * @param ir initial impulse response of FIR band filters.
+		 * @param ir_length length of FIR band filters impulse response.
+		 * @param section_count number of second-order sections of IIR band filters.
+		 */
+		band_pool(unsigned capacity, unsigned channel_count, unsigned block_size, const size_t* envelope_lengths,
+				r::multiband_compressor::crossover_type crossover, const s_t* ir, size_t ir_length, size_t section_count)
+		 :	capacity_(capacity)
+		 ,	channel_count_(channel_count)
+		 ,	section_count_(section_count)
+		 ,	channel_stride_(d::simd::aligned_count<s_t>(block_size))
+		 ,	stride_(channel_stride_ * channel_count)
+		 ,	bands_size_(aligned_size(capacity * sizeof(band)))
+		 ,	compressors_size_(aligned_size(capacity * channel_count * sizeof(compressor_type)))
+		 ,	block_(static_cast<char*>(d::simd::aligned_alloc(bands_size_ + compressors_size_ + capacity * stride_ * sizeof(s_t))))
+		 ,	bands_(reinterpret_cast<band*>(block_))
+		 ,	compressors_(reinterpret_cast<compressor_type*>(block_ + bands_size_))
+		 ,	buffers_(reinterpret_cast<s_t*>(block_ + bands_size_ + compressors_size_))
+		 ,	band_count_(0)
+		 ,	compressor_count_(0)
+		{
+			if (NULL == block_)
+				throw std::bad_alloc();
+			try {
+				for (unsigned i = 0; i < capacity_; ++i)
+					for (unsigned c = 0; c < channel_count_; ++c, ++compressor_count_)
+						new (compressors_ + compressor_count_) compressor_type(envelope_lengths[i]);
+				for (; band_count_ < capacity_; ++band_count_)
+					new (bands_ + band_count_) band(crossover, block_size, channel_count_, ir, ir_length, section_count,
+							compressors_ + band_count_ * channel_count_, buffers_ + band_count_ * stride_);
+			}
+			catch (...) {
+				destroy();
+				throw;
+			}
+			std::fill_n(buffers_, capacity_ * stride_, s_t());
+		}
+
+		~band_pool() {destroy();}
+
+		unsigned capacity() const {return capacity_;}
+		//! @return distance between the starts of consecutive channels in band work buffers (SIMD-aligned).
+		size_t channel_stride() const {return channel_stride_;}
+		//! @return number of second-order sections of IIR band filters.
+		size_t section_count() const {return section_count_;}
+		band& operator[](unsigned index) {return bands_[index];}
+
+	private:
+		//! Round the size of pool sections up to cache line.
+		static size_t aligned_size(size_t size) {return (size + 63) & ~size_t(63);}
+
+		void destroy()
+		{
+			while (band_count_ != 0)
+				bands_[--band_count_].~band();
+			while (compressor_count_ != 0)
+				compressors_[--compressor_count_].~compressor_type();
+			d::simd::aligned_free(block_);
+		}
+
+		const unsigned capacity_;
+		const unsigned channel_count_;
+		const size_t section_count_;
+		const size_t channel_stride_;
+		const size_t stride_;
+		const size_t bands_size_;
+		const size_t compressors_size_;
+		char* const block_;
+		band* const bands_;
+		compressor_type* const compressors_;
+		s_t* const buffers_;
+		unsigned band_count_;		//!< Number of constructed bands.
+		unsigned compressor_count_;	//!< Number of constructed compressors.
+	};
+
+	typedef boost::shared_ptr<band_pool> band_pool_ptr;
+
+	/*!
+	 * @brief Counting semaphore built directly on the OS primitive, so that post() is safe on the processing
+	 * thread: it takes no lock in user space and only enters the kernel to wake a waiting thread.
+	 */
+	class semaphore: private boost::noncopyable {
+	public:
+#if defined(_WIN32)
+		semaphore(): handle_(::CreateSemaphore(NULL, 0, LONG_MAX, NULL)) {
+			if (NULL == handle_)
+				throw std::runtime_error("dsp::rt::detail::semaphore::semaphore() CreateSemaphore() failed");
+		}
+		~semaphore() {::CloseHandle(handle_);}
+		void post(unsigned count) {::ReleaseSemaphore(handle_, static_cast<LONG>(count), NULL);}
+		void wait() {::WaitForSingleObject(handle_, INFINITE);}
+	private:
+		HANDLE handle_;
+#elif defined(__APPLE__)
+		semaphore(): sem_(::dispatch_semaphore_create(0)) {
+			if (NULL == sem_)
+				throw std::runtime_error("dsp::rt::detail::semaphore::semaphore() dispatch_semaphore_create() failed");
+		}
+		~semaphore() {::dispatch_release(sem_);}
+		void post(unsigned count) {while (count-- != 0) ::dispatch_semaphore_signal(sem_);}
+		void wait() {::dispatch_semaphore_wait(sem_, DISPATCH_TIME_FOREVER);}
+	private:
+		dispatch_semaphore_t sem_;
+#else
+		semaphore() {
+			if (0 != ::sem_init(&sem_, 0, 0))
+				throw std::runtime_error("dsp::rt::detail::semaphore::semaphore() sem_init() failed");
+		}
+		~semaphore() {::sem_destroy(&sem_);}
+		void post(unsigned count) {while (count-- != 0) ::sem_post(&sem_);}
+		void wait() {while (0 != ::sem_wait(&sem_) && EINTR == errno) {}}
+	private:
+		sem_t sem_;
+#endif
+	};
+
+	/*!
+	 * @brief Pool of worker threads executing batches of independent tasks together with the calling thread.
+	 * Tasks of each batch are split evenly between the threads, which execute their own share first (so that the
+	 * same thread tends to process the same band in consecutive blocks) and then steal the remaining tasks from
+	 * the others. run() returns only after all the threads are done with the batch, which makes it a barrier.
+	 * Idle workers spin for a while and then sleep on a semaphore, so run() never blocks nor takes a lock, but may
+	 * need to post it. Note that the calling thread waits for the workers at the end of each batch, so if it runs
+	 * at real-time priority, the workers should be given a similar one (see multiband_compressor::params).
+	 */
+	class worker_pool: private boost::noncopyable {
+	public:
+		typedef void (*task_fn)(void* context, unsigned index);
+
+		/*!
+		 * @param thread_count total number of threads executing tasks, including the one calling run().
+		 * @param cpu_affinity CPUs worker threads are pinned to (worker i to cpu_affinity[i % size()]), may be empty.
+		 * @param priority scheduling priority of worker threads, 0 to keep the default.
+		 */
+		worker_pool(unsigned thread_count, const std::vector<int>& cpu_affinity, int priority)
+		 :	queues_(thread_count)
+		 ,	fn_(NULL)
+		 ,	context_(NULL)
+		 ,	generation_(0)
+		 ,	busy_(0)
+		 ,	sleeping_(0)
+		 ,	stop_(false)
+		{
+			try {
+				for (unsigned i = 1; i < thread_count; ++i) {
+					threads_.push_back(new boost::thread(&worker_pool::worker, this, i));
+					if (!cpu_affinity.empty())
+						set_affinity(*threads_.back(), cpu_affinity[(i - 1) % cpu_affinity.size()]);
+					if (0 != priority)
+						set_priority(*threads_.back(), priority);
+				}
+			}
+			catch (...) {
+				stop();
+				throw;
+			}
+		}
+
+		~worker_pool() {stop();}
+
+		//! @return number of threads executing tasks, including the one calling run().
+		unsigned thread_count() const {return static_cast<unsigned>(queues_.size());}
+
+		//! @brief Execute fn(context, i) for each i in [0, count) and wait until all of them are done.
+		void run(task_fn fn, void* context, unsigned count) {
+			fn_ = fn;
+			context_ = context;
+			const unsigned n = thread_count();
+			for (unsigned t = 0; t < n; ++t) {
+				queues_[t].next_.store(count * t / n, boost::memory_order_relaxed);
+				queues_[t].end_ = count * (t + 1) / n;
+			}
+			busy_.store(n - 1, boost::memory_order_relaxed);
+			generation_.fetch_add(1);
+			// paired with worker(): either the sleeper is counted here, or it sees the new generation itself
+			if (const unsigned sleeping = sleeping_.exchange(0))
+				wake_.post(sleeping);
+			execute(0);
+			for (unsigned spin = 0; 0 != busy_.load(boost::memory_order_acquire); ++spin)
+				if (spin >= spin_count)
+					boost::this_thread::yield();
+		}
+
+	private:
+		static const unsigned spin_count = 1024;	//!< Number of polls before waiting thread yields or blocks.
+
+		//! Range of task indexes assigned to a single thread, cache line sized to avoid false sharing.
+		struct queue {
+			boost::atomic<unsigned> next_;
+			unsigned end_;
+			char pad_[64 - sizeof(boost::atomic<unsigned>) - sizeof(unsigned)];
+
+			queue(): next_(0), end_(0) {}
+		};
+
+		static void set_affinity(boost::thread& t, int cpu) {
+#if defined(_WIN32)
+			::SetThreadAffinityMask(t.native_handle(), DWORD_PTR(1) << cpu);
+#elif defined(__linux__)
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(cpu, &set);
+			::pthread_setaffinity_np(t.native_handle(), sizeof(set), &set);
+#else
+			(void)t; (void)cpu; // not supported
+#endif
+		}
+
+		//! @brief Best-effort: SCHED_FIFO priority on POSIX systems (usually requires privileges), THREAD_PRIORITY_* on Windows.
+		static void set_priority(boost::thread& t, int priority) {
+#if defined(_WIN32)
+			::SetThreadPriority(t.native_handle(), priority);
+#else
+			sched_param param = sched_param();
+			param.sched_priority = priority;
+			::pthread_setschedparam(t.native_handle(), SCHED_FIFO, &param);
+#endif
+		}
+
+		//! @brief Drain own queue, then steal from the others.
+		void execute(unsigned self) {
+			const unsigned n = thread_count();
+			for (unsigned k = 0; k < n; ++k) {
+				queue& q = queues_[(self + k) % n];
+				for (unsigned i; (i = q.next_.fetch_add(1, boost::memory_order_relaxed)) < q.end_; )
+					fn_(context_, i);
+			}
+		}
+
+		void worker(unsigned self) {
+			unsigned seen = 0;
+			for (;;) {
+				unsigned gen;
+				for (unsigned spin = 0; seen == (gen = generation_.load()) && !stop_.load(); ++spin) {
+					if (spin < spin_count)
+						continue;
+					if (spin < 2 * spin_count) {
+						boost::this_thread::yield();
+						continue;
+					}
+					// count self in before the final check; if run() took the count already, a spurious wakeup follows later
+					sleeping_.fetch_add(1);
+					if (seen == generation_.load() && !stop_.load())
+						wake_.wait();
+				}
+				if (stop_.load())
+					return;
+				seen = gen;
+				execute(self);
+				busy_.fetch_sub(1, boost::memory_order_release);
+			}
+		}
+
+		void stop() {
+			stop_.store(true);
+			wake_.post(static_cast<unsigned>(threads_.size()));
+			for (size_t i = 0; i < threads_.size(); ++i) {
+				threads_[i]->join();
+				delete threads_[i];
+			}
+			threads_.clear();
+		}
+
+		std::vector<queue> queues_;		//!< Task ranges of the threads, queues_[0] belongs to the one calling run().
+		std::vector<boost::thread*> threads_;
+		task_fn fn_;
+		void* context_;
+		boost::atomic<unsigned> generation_;	//!< Incremented by run() to start a new batch.
+		boost::atomic<unsigned> busy_;		//!< Number of workers still executing the current batch.
+		boost::atomic<unsigned> sleeping_;	//!< Number of workers (about to be) waiting on wake_, reset by run() when it posts.
+		boost::atomic<bool> stop_;
+		semaphore wake_;
+	};
 } } }
 
-struct det::mbc_impl 
+struct det::mbc_impl
 {
 	static const size_t ir_length_max = 256;
 
-	mutex mutex_;
+	mutex mutex_;	//!< Serializes control threads (setters & getters), never taken by the processing thread.
 	const unsigned sample_rate_;
 	const unsigned channel_count_;
 	const unsigned block_size_;
-
-	d::trivial_array<s_t> ir_;
-
-	struct band_channel
-	{
-		d::overlap_add<s_t> filter_;
-		d::compressor<s_t> compressor_;
-
-		//band_channel(size_t 
+	const size_t channel_stride_;	//!< Distance between the starts of consecutive channels in planar buffers.
+
+	const unsigned max_band_count_;	//!< Fixed capacity of the band pool, 0 if the pool is reallocated as needed.
+	const r::multiband_compressor::crossover_type crossover_;
+	const std::vector<int> cpu_affinity_;
+	const int worker_priority_;
+
+	d::trivial_array<s_t> ir_;	//!< Initial (all-zero) impulse response of band filters.
+
+	typedef band_pool::band band;
+
+	//! Settings of a single band, in the form applied directly to its compressors.
+	struct band_settings {
+		band* band_;
+		float threshold_;
+		float gain_;
+		float ratio_;
+		size_t attack_;
+		size_t release_;
+		bool bypass_;
+		bool mute_;
 	};
 
-	typedef boost::shared_ptr<band_channel> band_channel_ptr;
+	//! Snapshot of the settings published to the processing thread.
+	struct settings {
+		band_pool_ptr pool_;	//!< Keeps the bands referenced by this snapshot alive.
+		std::vector<band_settings> bands_;
+		std::vector<double> sos_;	//!< IIR band filter coefficients, see mbc_impl::sos_.
+		s_t limiter_threshold_;
+		bool limiter_bypass_;
 
-	struct band {
-		std::vector<band_channel_ptr> channels_;
-		r::multiband_compressor::band_params params_;
+		settings(): limiter_threshold_(1), limiter_bypass_(false) {}
 	};
 
+	// control state, guarded by mutex_
 	std::vector<float> xover_;
-	std::vector<band> bands_;
-	d::limiter<s_t> limiter_;
+	band_pool_ptr pool_;
+	std::vector<float> envelope_periods_ms_;	//!< Envelope periods of the band slots in pool_.
+	std::vector<double> sos_;	//!< IIR band filter coefficients: numerators of all the sections of a band followed by denominators, band after band.
+	std::vector<r::multiband_compressor::band_params> band_params_;
+	float limiter_threshold_dB_;
 	bool limiter_bypass_;
 
-	mbc_impl(unsigned sample_rate, unsigned channel_count, unsigned block_size)
+	// processing state, touched by the processing thread only
+	triple_buffer<settings> settings_;
+	d::limiter<s_t> limiter_;
+	d::trivial_array<s_t> input_;	//!< Deinterleaved input block (channel_count_ * block_size_).
+	d::trivial_array<s_t, d::simd::allocator<s_t> > output_;	//!< Planar sum of the bands (channel_count_ * channel_stride_).
+	boost::scoped_ptr<worker_pool> workers_;	//!< Threads processing the bands in parallel, if enabled; destroyed first.
+
+	mbc_impl(unsigned sample_rate, unsigned channel_count, unsigned block_size, unsigned max_band_count,
+			r::multiband_compressor::crossover_type crossover, const std::vector<r::multiband_compressor::band_params>& bands,
+			unsigned thread_count, const std::vector<int>& cpu_affinity, int worker_priority)
 	 :	sample_rate_(sample_rate)
 	 ,	channel_count_(channel_count)
 	 ,	block_size_(block_size)
+	 ,	channel_stride_(d::simd::aligned_count<s_t>(block_size))
+	 ,	max_band_count_(max_band_count)
+	 ,	crossover_(crossover)
+	 ,	cpu_affinity_(cpu_affinity)
+	 ,	worker_priority_(worker_priority)
 	 ,	ir_(ir_length_max)
+	 ,	limiter_threshold_dB_(-1.f)
 	 ,	limiter_bypass_(false)
+	 ,	input_(channel_count * block_size)
+	 ,	output_(channel_count * channel_stride_)
 	{
+		if (0 != max_band_count_) {
+			reallocate_pool(max_band_count_, bands);
+			for (unsigned i = 0; i < 3; ++i) {
+				settings_[i].bands_.reserve(max_band_count_);
+				settings_[i].sos_.reserve(sos_.size());
+			}
+		}
+		publish();
+		if (thread_count > 1)
+			workers_.reset(new worker_pool(thread_count, cpu_affinity, worker_priority));
 	}
 
-	void set_crossover_frequency_impl(unsigned index, float freq, det::upgrade_lock& rl, bool force);
-
-	void set_band_params_direct(band& b, const r::multiband_compressor::band_params& p, bool force);
-	void set_band_params_impl(unsigned index, const r::multiband_compressor::band_params& p, det::upgrade_lock& rl);
+	void reallocate_pool(unsigned capacity, const std::vector<r::multiband_compressor::band_params>& bands);
+	void band_edges(const std::vector<float>& xover, size_t index, float& lo, float& hi) const;
+	void update_crossovers(const std::vector<float>& xover, const std::vector<r::multiband_compressor::band_params>& bands);
+	void design_sos(const std::vector<float>& xover, size_t band_count);
+	void set_crossover_frequency_impl(unsigned index, float freq, bool force);
+	void set_band_params_impl(unsigned index, const r::multiband_compressor::band_params& p);
+
+	void publish();
+	void update_settings();
+	void process(const s_t* input, s_t* output);
+	void filter_band(unsigned index);
+	void compress_band(unsigned index, unsigned channel);
+
+	static void filter_task(void* context, unsigned index);
+	static void compress_task(void* context, unsigned index);
 };
 
-r::multiband_compressor::multiband_compressor(unsigned sample_rate, unsigned channel_count, unsigned block_size)
- : impl_(new det::mbc_impl(sample_rate, channel_count, block_size))
+const float r::multiband_compressor::envelope_period_ms_default = 10.f;
+
+r::multiband_compressor::multiband_compressor(unsigned sample_rate, unsigned channel_count, unsigned block_size, unsigned max_band_count, crossover_type crossover)
+ : impl_(new det::mbc_impl(sample_rate, channel_count, block_size, max_band_count, crossover, std::vector<band_params>(), 1, std::vector<int>(), 0))
 {
 }
 
 r::multiband_compressor::multiband_compressor(const r::multiband_compressor::params& p)
- : impl_(new det::mbc_impl(p.sample_rate, p.channel_count, p.block_size))
+ : impl_(new det::mbc_impl(p.sample_rate, p.channel_count, p.block_size, p.max_band_count, p.crossover, p.bands, p.thread_count, p.cpu_affinity, p.worker_priority))
 {
+	set_params(p);
+}
+
+/*!
+ * @brief Replace the band pool with a new one of specified capacity. Band slots present in the current pool keep
+ * their envelope periods, the remaining ones take them from bands (or use the default). This is the only place
+ * where band state is allocated, always on the control thread.
+ */
+void det::mbc_impl::reallocate_pool(unsigned capacity, const std::vector<r::multiband_compressor::band_params>& bands) {
+	std::vector<float> periods(capacity, r::multiband_compressor::envelope_period_ms_default);
+	std::vector<size_t> lengths(capacity);
+	for (unsigned i = 0; i < capacity; ++i) {
+		if (i < envelope_periods_ms_.size())
+			periods[i] = envelope_periods_ms_[i];
+		else if (i < bands.size())
+			periods[i] = bands[i].envelope_period_ms;
+		lengths[i] = std::max<size_t>(1, static_cast<size_t>(sample_rate_ * periods[i] / 1000.f + .5f));
+	}
+	// Linkwitz-Riley band needs 2 sections for each crossover below it, otherwise 2 for the one above and 1 for each further one
+	const size_t section_count = std::max<size_t>(1, 2 * (capacity - 1));
+	pool_.reset(new band_pool(capacity, channel_count_, block_size_, &lengths[0], crossover_, &ir_[0], ir_length_max, section_count));
+	envelope_periods_ms_.swap(periods);
+	if (r::multiband_compressor::crossover_lr4 == crossover_)
+		sos_.resize(capacity * 2 * section_count * band_pool::iir_type::section_length);
 }
 
 r::multiband_compressor::~multiband_compressor()
@@ -85,29 +542,179 @@ r::multiband_compressor::~multiband_compressor()
 	impl_.reset();
 }
 
+/*!
+ * @brief Prepare the settings snapshot from current control state and hand it over to the processing thread.
+ * Must be called with mutex_ held. Band objects referenced only by the spare snapshot being overwritten are
+ * released here, so they are never destroyed on the processing thread.
+ */
+void det::mbc_impl::publish() {
+	settings& s = settings_.back();
+	s.pool_ = pool_;
+	s.bands_.resize(band_params_.size());
+	for (size_t i = 0; i < band_params_.size(); ++i) {
+		const r::multiband_compressor::band_params& p = band_params_[i];
+		band_settings& b = s.bands_[i];
+		b.band_ = &(*pool_)[i];
+		b.threshold_ = std::pow(10.f, p.threshold_dB / 20.f);
+		b.gain_ = std::pow(10.f, p.gain_dB / 20.f);
+		b.ratio_ = p.ratio;
+		b.attack_ = static_cast<size_t>(sample_rate_ * p.attack_ms / 1000.f + .5f);
+		b.release_ = static_cast<size_t>(sample_rate_ * p.release_ms / 1000.f + .5f);
+		b.bypass_ = p.bypass;
+		b.mute_ = p.mute;
+	}
+	s.sos_ = sos_;
+	s.limiter_threshold_ = std::pow(10.f, limiter_threshold_dB_ / 20.f);
+	s.limiter_bypass_ = limiter_bypass_;
+	settings_.publish();
+}
+
+//! @brief Pick up the most recently published settings snapshot and apply it to the compressors & limiter.
+void det::mbc_impl::update_settings() {
+	if (!settings_.update())
+		return;
+
+	const settings& s = settings_.front();
+	for (size_t i = 0; i < s.bands_.size(); ++i) {
+		const band_settings& b = s.bands_[i];
+		if (band_pool::iir_type* f = b.band_->iir_.get()) {
+			const size_t len = f->section_count() * band_pool::iir_type::section_length;
+			const double* num = &s.sos_[2 * len * i];
+			f->set(num, num + len);
+		}
+		for (size_t c = 0; c < channel_count_; ++c) {
+			band_pool::compressor_type& comp = b.band_->compressors_[c];
+			comp.set_threshold(b.threshold_);
+			comp.set_gain(b.gain_);
+			comp.set_ratio(b.ratio_);
+			comp.set_attack(b.attack_);
+			comp.set_release(b.release_);
+		}
+	}
+	limiter_.set_threshold(s.limiter_threshold_);
+}
+
+//! @brief Run the band filter over the deinterleaved input, even if the band is muted, so that its state is up-to-date.
+void det::mbc_impl::filter_band(unsigned index) {
+	const band_settings& b = settings_.front().bands_[index];
+	if (band_pool::filter_type* const f = b.band_->filter_.get()) {
+		for (size_t c = 0; c < channel_count_; ++c)
+			std::copy(&input_[c * block_size_], &input_[(c + 1) * block_size_], f->begin(c));
+		(*f)();
+	}
+	else {
+		const s::buffer_layout input_layout = s::buffer_layout::planar(channel_count_, block_size_, sizeof(s_t));
+		const s::buffer_layout band_layout = s::buffer_layout::planar(channel_count_, channel_stride_, sizeof(s_t));
+		(*b.band_->iir_)(input_.get(), input_layout, b.band_->buffer_, band_layout, block_size_);
+	}
+}
+
+//! @brief Compress single channel of the filtered band into its work buffer.
+void det::mbc_impl::compress_band(unsigned index, unsigned channel) {
+	const band_settings& b = settings_.front().bands_[index];
+	if (b.mute_)
+		return;
+	const band_pool::filter_type* const f = b.band_->filter_.get();
+	s_t* y = b.band_->buffer_ + channel * channel_stride_;
+	const s_t* x = (NULL != f ? f->begin(channel) : y);
+	if (b.bypass_) {
+		if (x != y)
+			std::copy(x, x + block_size_, y);
+	}
+	else {
+		band_pool::compressor_type& comp = b.band_->compressors_[channel];
+		comp(x, y, block_size_);
+	}
+}
+
+void det::mbc_impl::filter_task(void* context, unsigned index) {
+	static_cast<mbc_impl*>(context)->filter_band(index);
+}
+
+void det::mbc_impl::compress_task(void* context, unsigned index) {
+	mbc_impl* impl = static_cast<mbc_impl*>(context);
+	impl->compress_band(index / impl->channel_count_, index % impl->channel_count_);
+}
+
+/*!
+ * @brief Block-based processing pipeline. Input is deinterleaved once, then each band is filtered (all the
+ * channels at once, either through the shared crossover spectrum or SIMD lanes of the IIR filter) and each of
+ * its channels compressed into its planar work buffer; with worker pool enabled band filters and then
+ * band x channel compressors run in parallel, each batch followed by a barrier. Finally the bands are summed
+ * into output_ with SIMD, the limiter is applied and the result interleaved back.
+ */
+void det::mbc_impl::process(const s_t* input, s_t* output) {
+	update_settings();
+
+	const settings& s = settings_.front();
+	const unsigned band_count = static_cast<unsigned>(s.bands_.size());
+	s::buffer_deinterleave(input, input_.begin(), channel_count_, block_size_);
+	if (workers_) {
+		workers_->run(&filter_task, this, band_count);
+		workers_->run(&compress_task, this, band_count * channel_count_);
+	}
+	else {
+		for (unsigned i = 0; i < band_count; ++i) {
+			filter_band(i);
+			for (unsigned c = 0; c < channel_count_; ++c)
+				compress_band(i, c);
+		}
+	}
+
+	const size_t len = channel_count_ * channel_stride_;
+	std::fill_n(output_.begin(), len, s_t());
+	for (unsigned i = 0; i < band_count; ++i)
+		if (!s.bands_[i].mute_)
+			d::simd::add(output_.begin(), output_.begin(), s.bands_[i].band_->buffer_, len);
+	if (!s.limiter_bypass_)
+		for (size_t c = 0; c < channel_count_; ++c)
+			for (s_t* y = &output_[c * channel_stride_], *end = y + block_size_; y != end; ++y)
+				*y = limiter_(*y);
+	for (size_t c = 0; c < channel_count_; ++c)
+		std::copy(&output_[c * channel_stride_], &output_[c * channel_stride_] + block_size_, d::make_stride(output, channel_count_, c));
+}
+
+void r::multiband_compressor::operator()(const sample_type* input, sample_type* output) {
+	impl_->process(input, output);
+}
+
 void r::multiband_compressor::set_limiter_threshold_dB(float t) {
-	det::unique_lock l(impl_->mutex_);
-	impl_->limiter_.set_threshold_dB(t);
+	det::lock_guard l(impl_->mutex_);
+	impl_->limiter_threshold_dB_ = t;
+	impl_->publish();
 }
 
 float r::multiband_compressor::limiter_threshold_dB() const {
-	det::shared_lock l(impl_->mutex_);
-	return impl_->limiter_.threshold_dB();
+	det::lock_guard l(impl_->mutex_);
+	return impl_->limiter_threshold_dB_;
 }
 
 void r::multiband_compressor::set_limiter_bypass(bool b) {
-	det::unique_lock l(impl_->mutex_);
+	det::lock_guard l(impl_->mutex_);
 	impl_->limiter_bypass_ = b;
+	impl_->publish();
 }
 
 bool r::multiband_compressor::is_limiter_bypass() const {
-	det::shared_lock l(impl_->mutex_);
+	det::lock_guard l(impl_->mutex_);
 	return impl_->limiter_bypass_;
 }
 
 unsigned r::multiband_compressor::band_count() const {
-	det::shared_lock l(impl_->mutex_);
-	return impl_->bands_.size();
+	det::lock_guard l(impl_->mutex_);
+	return impl_->band_params_.size();
+}
+
+unsigned r::multiband_compressor::max_band_count() const {
+	return impl_->max_band_count_;
+}
+
+r::multiband_compressor::crossover_type r::multiband_compressor::crossover() const {
+	return impl_->crossover_;
+}
+
+unsigned r::multiband_compressor::thread_count() const {
+	return (impl_->workers_ ? impl_->workers_->thread_count() : 1);
 }
 
 unsigned r::multiband_compressor::block_size() const {
@@ -123,162 +730,247 @@ unsigned r::multiband_compressor::sample_rate() const {
 }
 
 void r::multiband_compressor::fill_format(s::format& f) const {
-	f.set_channel_mask(0);
+	f.set_channel_config(0);
 	f.set_channel_count(impl_->channel_count_);
 	f.set_sample_format(s::sample::label::f32);
 	f.set_sample_rate(impl_->sample_rate_);
 }
 
 float r::multiband_compressor::crossover_frequency(unsigned index) const {
-	det::shared_lock l(impl_->mutex_);
+	det::lock_guard l(impl_->mutex_);
 	if (index >= impl_->xover_.size())
 		throw std::out_of_range("dsp::rt::multiband_compressor::crossover_frequency() index out of range");
 	return impl_->xover_[index];
 }
 
 void r::multiband_compressor::fill_band_params(unsigned index, band_params& p) const {
-	det::shared_lock l(impl_->mutex_);
-	if (index >= impl_->bands_.size())
+	det::lock_guard l(impl_->mutex_);
+	if (index >= impl_->band_params_.size())
 		throw std::out_of_range("dsp::rt::multiband_compressor::fill_band_params() index out of range");
-	p = impl_->bands_[index].params_;
-}
-
-void det::mbc_impl::set_band_params_direct(det::mbc_impl::band& b, const r::multiband_compressor::band_params& p, bool force) {
-	if (p.attack_ms != b.params_.attack_ms || force) {
-		for (unsigned i = 0; i < channel_count_; ++i)
-			b.channels_[i]->compressor_.set_attack(static_cast<size_t>(sample_rate_ * p.attack_ms / 1000.f + .5f));
-		b.params_.attack_ms = p.attack_ms;
-	}
-	b.params_.bypass = p.bypass;
-	if (p.gain_dB != b.params_.gain_dB || force) {
-		for (unsigned i = 0; i < channel_count_; ++i)
-			b.channels_[i]->compressor_.set_gain_dB(p.gain_dB);
-		b.params_.gain_dB = p.gain_dB;
-	}
-	b.params_.mute = p.mute;
-	if (p.ratio != b.params_.ratio || force) {
-		for (unsigned i = 0; i < channel_count_; ++i)
-			b.channels_[i]->compressor_.set_ratio(p.ratio);
-		b.params_.ratio = p.ratio;
-	}
-	if (p.release_ms != b.params_.release_ms || force) {
-		for (unsigned i = 0; i < channel_count_; ++i)
-			b.channels_[i]->compressor_.set_release(static_cast<size_t>(sample_rate_ * p.release_ms / 1000.f + .5f));
-		b.params_.release_ms = p.release_ms;
-	}
-	if (p.threshold_dB != b.params_.threshold_dB || force) {
-		for (unsigned i = 0; i < channel_count_; ++i)
-			b.channels_[i]->compressor_.set_threshold_dB(p.threshold_dB);
-		b.params_.threshold_dB = p.threshold_dB;
-	}
+	p = impl_->band_params_[index];
 }
 
-void det::mbc_impl::set_band_params_impl(unsigned index, const r::multiband_compressor::band_params& p, det::upgrade_lock& rl) {
-	if (index >= bands_.size())
+void det::mbc_impl::set_band_params_impl(unsigned index, const r::multiband_compressor::band_params& p) {
+	if (index >= band_params_.size())
 		throw std::out_of_range("dsp::rt::multiband_compressor::set_band_params() index out of range");
 
-	band& b = bands_[index];
-	if (p == b.params_)
+	r::multiband_compressor::band_params& bp = band_params_[index];
+	if (p == bp)
 		return;
 
-	det::upgrade_to_unique_lock wl(rl);
-	set_band_params_direct(b, p, false);
+	const float envelope_period_ms = bp.envelope_period_ms; // envelope period can't be changed once set
+	bp = p;
+	bp.envelope_period_ms = envelope_period_ms;
+	publish();
 }
 
 void r::multiband_compressor::set_band_params(unsigned index, const r::multiband_compressor::band_params& p) {
-	det::upgrade_lock rl(impl_->mutex_);
-	impl_->set_band_params_impl(index, p, rl);
+	det::lock_guard l(impl_->mutex_);
+	impl_->set_band_params_impl(index, p);
 }
 
 namespace {
+/*!
+ * @brief Design odd-length (type I) linear-phase FIR lowpass filter with Parks-McClellan algorithm.
+ * @param f normalized crossover frequency (cutoff in the middle of transition band).
+ * @param h designed impulse response [len].
+ * @param len filter length (odd).
+ */
+static void design_lowpass(double f, double* h, size_t len) {
+	if (f > 0.25) {
+		// remez exchange is ill-conditioned (and may even overrun its buffers) for narrow stopbands near Nyquist,
+		// design the complementary highpass as frequency-shifted lowpass at (0.5 - f) instead
+		design_lowpass(0.5 - f, h, len);
+		for (size_t i = 0; i < len; ++i)
+			h[i] = ((i + len / 2) % 2 ? h[i] : -h[i]);
+		h[len / 2] += 1.;
+		return;
+	}
+	// transition band is 10% of f wide, but not narrower than what len taps can realistically achieve
+	const double d = std::max(0.05 * f, 2. / len);
+	double freqs[4] = {0, std::max(f - d, 0.5 * f), std::min(f + d, 0.5 * (f + 0.5)), 0.5};
+	const double amps[4] = {1, 1, 0, 0}, weights[2] = {1, 1};
+	if (!d::fir::pm::design(len - 1, 2, freqs, amps, weights, h))
+		throw std::runtime_error("dsp::rt::multiband_compressor::set_crossover_frequency() crossover filter design failed to converge");
+}
+
+/*!
+ * @brief Design linear-phase FIR band filter passing frequencies [lo, hi] as a difference of lowpass filters
+ * with cutoff at hi and lo (or pure delay for hi at Nyquist). Filters of adjacent bands are complementary
+ * this way, so that the bands sum up to the delayed input regardless of the design accuracy. Odd-length
+ * filter is designed, as it's the only one which can be highpass; the last element of ir is set to 0.
+ */
 static void design_fir(float lo, float hi, unsigned fs, double* ir, size_t ir_max_length) {
 	float nl = lo / fs, nh = hi / fs;
 	if (1.1 * nl >= 0.9 * nh)
 		throw std::range_error("dsp::rt::multiband_compressor::set_crossover_frequency() resulting frequency band too narrow");
 
-	double f[6], a[6] = {0, 0, 1, 1, 0, 0}, w[3] = {1, 1, 1};
-	f[0] = 0; f[1] = 0.95 * nl; f[2] = 1.05 * nl; f[3] = 0.95 * nh; f[4] = 1.05 * nh; f[5] = 0.5;
-	bool res;
-	if (lo <= 20.f) {
-		f[2] = 0;
-		res = d::firpm(ir_max_length - 1, ir, 2, &f[2], &a[2], &w[1]);
-	}
-	else if (hi >= fs - 20.f) {
-		f[3] = 0.5;
-		res = d::firpm(ir_max_length - 1, ir, 2, f, a, w);
-	}
+	const size_t len = ir_max_length - 1;
+	std::fill_n(ir, ir_max_length, 0.);
+	if (nh < 0.5f)
+		design_lowpass(nh, ir, len);
 	else
-		res = d::firpm(ir_max_length - 1, ir, 3, f, a, w);
+		ir[len / 2] = 1.;
+	if (nl > 0.f) {
+		std::vector<double> h(len);
+		design_lowpass(nl, &h[0], len);
+		for (size_t i = 0; i < len; ++i)
+			ir[i] -= h[i];
+	}
+}
+
+/*!
+ * @brief Hand the new crossover filter over to the processing thread. Filter of a band which is already
+ * in use is crossfaded in to avoid clicks, the new bands start with their filters right away.
+ */
+static void stage_fir(det::mbc_impl::band& b, const double* ir, size_t len, bool crossfade) {
+	while (!b.filter_->stage_impulse_response(ir, len, crossfade))
+		boost::this_thread::yield();	// previous filter is being activated right now, this takes at most one block
 }
 }
 
-void det::mbc_impl::set_crossover_frequency_impl(unsigned index, float freq, det::upgrade_lock& rl, bool force) {
-	size_t sz = xover_.size();
-	if (index >= sz)
-		throw std::out_of_range("dsp::rt::multiband_compressor::set_crossover_frequency() index out of range");
-	if (freq == xover_[index] && !force)
-		return;
+//! @brief Get the frequency range of band index, given crossover frequencies xover.
+void det::mbc_impl::band_edges(const std::vector<float>& xover, size_t index, float& lo, float& hi) const {
+	lo = (index > 0 ? xover[index - 1] : 0.f);
+	hi = (index < xover.size() ? xover[index] : sample_rate_ / 2.f);
+}
 
+/*!
+ * @brief Redesign the crossover filters of the bands whose frequency range changes by switching to crossover
+ * frequencies xover and bands.size() bands, growing the band pool if needed (which requires redesigning them
+ * all). Filters are designed on the calling thread before any state is changed, so that exceptions leave the
+ * component intact, and the processing thread keeps running meanwhile. Must be called with mutex_ held.
+ */
+void det::mbc_impl::update_crossovers(const std::vector<float>& xover, const std::vector<r::multiband_compressor::band_params>& bands) {
 	float prev = 0.f;
-	float next = sample_rate_ / 2.f;
-	if (index > 0)
-		prev = xover_[index - 1];
-	if (sz > 0 && index < sz - 1)
-		next = xover_[index + 1];
-	if (freq <= prev || freq >= next)
-		throw std::domain_error("dsp::rt::multiband_compressor::set_crossover_frequency() frequency no monotonically increasing or outside Nyquist range");
+	for (size_t i = 0; i < xover.size(); ++i) {
+		if (xover[i] <= prev || xover[i] >= sample_rate_ / 2.f)
+			throw std::domain_error("dsp::rt::multiband_compressor::set_crossover_frequency() frequency no monotonically increasing or outside Nyquist range");
+		prev = xover[i];
+	}
+
+	const bool grow = (!bands.empty() && (!pool_ || bands.size() > pool_->capacity()));
+	if (r::multiband_compressor::crossover_lr4 == crossover_) {
+		// allpass compensation makes every band depend on all the crossovers, so they are always redesigned
+		if (grow)
+			reallocate_pool(bands.size(), bands);
+		xover_ = xover;
+		design_sos(xover, bands.size());
+		return;
+	}
 
 	const size_t len = ir_length_max;
-	d::trivial_array<double> arr(len * 2);
-	design_fir(prev, freq, sample_rate_, &arr[0], len);
-	design_fir(freq, next, sample_rate_, &arr[len], len);
-
-	det::upgrade_to_unique_lock wl(rl);
-	xover_[index] = freq;
-	for (unsigned i = 0; i < channel_count_; ++i) {
-		bands_[index].channels_[i]->filter_.set_impulse_response(&arr[0], len);
-		bands_[index + 1].channels_[i]->filter_.set_impulse_response(&arr[len], len);
+	std::vector<size_t> indices;
+	std::vector<bool> in_use;
+	std::vector<double> arr;
+	for (size_t i = 0; i < bands.size(); ++i) {
+		float lo, hi, prev_lo, prev_hi;
+		band_edges(xover, i, lo, hi);
+		const bool used = (!grow && i < band_params_.size());
+		if (used) {
+			band_edges(xover_, i, prev_lo, prev_hi);
+			if (lo == prev_lo && hi == prev_hi)
+				continue;
+		}
+		arr.resize(arr.size() + len);
+		design_fir(lo, hi, sample_rate_, &arr[arr.size() - len], len);
+		indices.push_back(i);
+		in_use.push_back(used);
 	}
+
+	if (grow)
+		reallocate_pool(bands.size(), bands);
+	xover_ = xover;
+	for (size_t i = 0; i < indices.size(); ++i)
+		stage_fir((*pool_)[indices[i]], &arr[i * len], len, in_use[i]);
+}
+
+/*!
+ * @brief Design 4th-order Linkwitz-Riley crossovers as cascades of second-order sections of each band, writing
+ * them to sos_. Band k is a cascade of squared Butterworth highpass sections at crossovers below it, squared
+ * lowpass one at the crossover above it and allpass sections at the remaining ones, which compensate the phase
+ * shift of the crossovers splitting higher bands, so that all the bands sum up to an allpass response.
+ * Unused sections are set to pass-through.
+ */
+void det::mbc_impl::design_sos(const std::vector<float>& xover, size_t band_count) {
+	const size_t sl = band_pool::iir_type::section_length;
+	const size_t len = pool_->section_count() * sl;
+	std::fill(sos_.begin(), sos_.end(), 0.);
+	for (size_t k = 0; k < band_count; ++k) {
+		double* num = &sos_[2 * len * k];
+		double* den = num + len;
+		for (size_t j = 0; j < xover.size(); ++j) {
+			double f = xover[j] / sample_rate_;
+			if (j > k) {
+				// allpass with the poles of Butterworth section, equal to the sum of squared lowpass & highpass
+				d::iir::sos_design(2, d::iir::type::butterworth | d::iir::resp::lowpass, &f, num, den);
+				num[0] = den[2]; num[1] = den[1]; num[2] = den[0];
+				num += sl; den += sl;
+				continue;
+			}
+			const unsigned resp = (j < k ? d::iir::resp::highpass : d::iir::resp::lowpass);
+			for (int n = 0; n < 2; ++n, num += sl, den += sl)
+				d::iir::sos_design(2, d::iir::type::butterworth | resp, &f, num, den);
+		}
+		for (double* end = &sos_[2 * len * k] + len; num != end; num += sl, den += sl)
+			num[0] = den[0] = 1.;
+	}
+}
+
+void det::mbc_impl::set_crossover_frequency_impl(unsigned index, float freq, bool force) {
+	if (index >= xover_.size())
+		throw std::out_of_range("dsp::rt::multiband_compressor::set_crossover_frequency() index out of range");
+	if (freq == xover_[index] && !force)
+		return;
+
+	std::vector<float> xover = xover_;
+	xover[index] = freq;
+	update_crossovers(xover, band_params_);
+	publish();
 }
 
 void r::multiband_compressor::set_crossover_frequency(unsigned index, float freq) {
-	det::upgrade_lock rl(impl_->mutex_);
-	impl_->set_crossover_frequency_impl(index, freq, rl, false);
+	det::lock_guard l(impl_->mutex_);
+	impl_->set_crossover_frequency_impl(index, freq, false);
 }
 
 void r::multiband_compressor::fill_params(r::multiband_compressor::params& p) const {
-	det::shared_lock l(impl_->mutex_);
+	det::lock_guard l(impl_->mutex_);
 	p.sample_rate = impl_->sample_rate_;
 	p.channel_count = impl_->channel_count_;
 	p.block_size = impl_->block_size_;
+	p.max_band_count = impl_->max_band_count_;
+	p.crossover = impl_->crossover_;
+	p.thread_count = (impl_->workers_ ? impl_->workers_->thread_count() : 1);
+	p.cpu_affinity = impl_->cpu_affinity_;
+	p.worker_priority = impl_->worker_priority_;
 	p.crossover_frequencies = impl_->xover_;
-	p.bands.resize(impl_->bands_.size());
-	for (size_t i = 0; i < p.bands.size(); ++i)
-		p.bands[i] = impl_->bands_[i].params_;
-	p.limiter_threshold_dB = impl_->limiter_.threshold_dB();
+	p.bands = impl_->band_params_;
+	p.limiter_threshold_dB = impl_->limiter_threshold_dB_;
 	p.limiter_bypass = impl_->limiter_bypass_;
 }
 
 void r::multiband_compressor::set_params(const r::multiband_compressor::params& p) {
-	if (p.bands.size() > 1 && p.crossover_frequencies.size() != p.bands.size() - 1)
+	if (p.crossover_frequencies.size() != (p.bands.empty() ? 0 : p.bands.size() - 1))
 		throw std::logic_error("dsp::rt::multiband_compressor::set_params() crossover frequency/bands count mismatch");
+	if (impl_->max_band_count_ != 0 && p.bands.size() > impl_->max_band_count_)
+		throw std::length_error("dsp::rt::multiband_compressor::set_params() band count exceeds max_band_count");
 
-	det::upgrade_lock rl(impl_->mutex_);
+	det::lock_guard l(impl_->mutex_);
 	bool changed = false;
-	bool bands_changed = false;
 	bool xover_changed = false;
 	if (p.crossover_frequencies != impl_->xover_)
 		xover_changed = changed = true;
-	else if (p.bands.size() != impl_->bands_.size()) 
-		bands_changed = changed = true;
+	else if (p.bands.size() != impl_->band_params_.size())
+		changed = true;
 	else {
 		for (size_t i = 0; i < p.bands.size(); ++i)
-			if (p.bands[i] != impl_->bands_[i].params_) {
-				bands_changed = changed = true;
+			if (p.bands[i] != impl_->band_params_[i]) {
+				changed = true;
 				break;
 			}
 	}
-	if (!changed && p.limiter_threshold_dB != impl_->limiter_.threshold_dB())
+	if (!changed && p.limiter_threshold_dB != impl_->limiter_threshold_dB_)
 		changed = true;
 	if (!changed && p.limiter_bypass != impl_->limiter_bypass_)
 		changed = true;
@@ -286,24 +978,18 @@ void r::multiband_compressor::set_params(const r::multiband_compressor::params&
 	if (!changed)
 		return;
 
-	det::upgrade_to_unique_lock wl(rl);
-	int xover_force = -1;
-	if (p.bands.size() < impl_->bands_.size()) {
-		// number of bands decreased, last band will need to be recalculated to become HP
-		xover_force = int(p.bands.size()) - 1;
-		impl_->bands_.resize(p.bands.size());
-	}
-	else if (p.bands.size() > impl_->bands_.size()) {
-		// number of bands increased, all bands starting from current last one need to be recalculated
-		xover_force = impl_->xover_.size();
-		size_t start = impl_->bands_.size();
-		// add missing band entries
-		impl_->bands_.resize(p.bands.size());
-
-		//for (size_t i = start; i < p.bands.size(); ++i) 
-		//	impl_->add_band_direct(p.bands[i]);
-		// TODO implement add_band_direct
-	}
+	if (xover_changed || p.bands.size() != impl_->band_params_.size())
+		impl_->update_crossovers(p.crossover_frequencies, p.bands);
 
+	// copy band params, keeping the envelope periods of band slots, which can't be changed once set
+	impl_->band_params_.resize(p.bands.size());
+	for (size_t i = 0; i < p.bands.size(); ++i) {
+		r::multiband_compressor::band_params& bp = impl_->band_params_[i];
+		bp = p.bands[i];
+		bp.envelope_period_ms = impl_->envelope_periods_ms_[i];
+	}
 
-}
\ No newline at end of file
+	impl_->limiter_threshold_dB_ = p.limiter_threshold_dB;
+	impl_->limiter_bypass_ = p.limiter_bypass;
+	impl_->publish();
+}
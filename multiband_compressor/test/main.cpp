@@ -0,0 +1,9 @@
+/*!
+ * @file main.cpp
+ * 
+ * @author Andrzej Ciarkowski <mailto:andrzej.ciarkowski@gmail.com>
+ */
+ 
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
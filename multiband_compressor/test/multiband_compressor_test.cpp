@@ -0,0 +1,278 @@
+/*!
+ * @file multiband_compressor_test.cpp
+ *
+ * @author Andrzej Ciarkowski <mailto:andrzej.ciarkowski@gmail.com>
+ */
+#include <boost/test/auto_unit_test.hpp>
+
+#include <dsp++/const.h>
+#include <dsp++/rt/multiband_compressor.h>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+typedef dsp::rt::multiband_compressor mbc;
+
+BOOST_AUTO_TEST_SUITE(multiband_compressor)
+
+namespace {
+
+const unsigned sample_rate = 48000;
+const unsigned fir_delay = 127;		// latency of FIR crossover (half the length of the filters)
+
+mbc::band_params transparent_band()
+{
+	mbc::band_params b;
+	b.envelope_period_ms = 10.f;
+	b.threshold_dB = -20.f;
+	b.gain_dB = 0.f;
+	b.ratio = 1.f;
+	b.attack_ms = 5.f;
+	b.release_ms = 50.f;
+	b.bypass = true;
+	b.mute = false;
+	return b;
+}
+
+// All the bands bypassed at 0 dB gain and no limiter, so that the output is the sum of the bands.
+mbc::params transparent_params(unsigned channel_count, unsigned block_size, unsigned band_count, mbc::crossover_type crossover)
+{
+	mbc::params p;
+	p.sample_rate = sample_rate;
+	p.channel_count = channel_count;
+	p.block_size = block_size;
+	p.max_band_count = 0;
+	p.crossover = crossover;
+	p.thread_count = 1;
+	p.worker_priority = 0;
+	p.bands.assign(band_count, transparent_band());
+	for (unsigned i = 1; i < band_count; ++i)
+		p.crossover_frequencies.push_back(250.f * std::pow(4.f, i - 1.f));
+	p.limiter_threshold_dB = -1.f;
+	p.limiter_bypass = true;
+	return p;
+}
+
+// Append block_count blocks of noise to x and their output to y.
+void process(mbc& m, size_t block_count, std::vector<float>& x, std::vector<float>& y)
+{
+	const size_t len = m.block_size() * m.channel_count();
+	for (size_t b = 0; b < block_count; ++b) {
+		const size_t off = x.size();
+		x.resize(off + len);
+		y.resize(off + len);
+		for (size_t i = off; i < off + len; ++i)
+			x[i] = std::rand() / (RAND_MAX + 1.f) - .5f;
+		m(&x[off], &y[off]);
+	}
+}
+
+// @return maximum absolute difference between y and x delayed by delay frames, ignoring first skip frames.
+float delay_error(const std::vector<float>& x, const std::vector<float>& y, unsigned channel_count, unsigned delay, size_t skip = 0)
+{
+	const size_t d = delay * channel_count;
+	float err = 0.f;
+	for (size_t i = skip * channel_count; i < y.size(); ++i)
+		err = std::max(err, std::abs(y[i] - (i < d ? 0.f : x[i - d])));
+	return err;
+}
+
+// Processing thread of the concurrency tests: feed noise to m until stop is set, checking that the output stays bounded.
+void process_until(mbc* m, const boost::atomic<bool>* stop, size_t* block_count, bool* bounded)
+{
+	std::vector<float> x(m->block_size() * m->channel_count()), y(x.size());
+	unsigned seed = 12345;
+	while (!stop->load()) {
+		for (size_t i = 0; i < x.size(); ++i) {
+			seed = seed * 1664525u + 1013904223u;
+			x[i] = static_cast<float>(seed >> 8) / (1 << 24) - .5f;
+		}
+		(*m)(&x[0], &y[0]);
+		for (size_t i = 0; i < y.size(); ++i)
+			if (!(std::abs(y[i]) < 2.f))	// NaN fails too
+				*bounded = false;
+		++*block_count;
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(fir_bypass_delay)
+{
+	const unsigned C = 2, N = 200;
+	for (unsigned band_count = 1; band_count <= 4; ++band_count) {
+		mbc m(transparent_params(C, N, band_count, mbc::crossover_fir));
+		std::vector<float> x, y;
+		process(m, 20, x, y);
+		const float err = delay_error(x, y, C, fir_delay);
+		printf("multiband_compressor fir bypass %u bands delay err:\t%g\n", band_count, err);
+		BOOST_CHECK(err < 1e-5f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(lr4_flat_magnitude)
+{
+	const unsigned N = 256, L = 32 * N;
+	for (unsigned band_count = 2; band_count <= 5; ++band_count) {
+		mbc m(transparent_params(1, N, band_count, mbc::crossover_lr4));
+		std::vector<float> x(L), h(L);
+		x[0] = 1.f;
+		for (unsigned i = 0; i < L; i += N)
+			m(&x[i], &h[i]);
+
+		// bands sum up to an allpass, so the magnitude response should be flat across the whole band
+		float min_dB = 0.f, max_dB = 0.f;
+		for (float f = 20.f; f < 20000.f; f *= 1.05f) {
+			const double w = 2 * DSP_M_PI * f / sample_rate;
+			double re = 0., im = 0.;
+			for (unsigned n = 0; n < L; ++n) {
+				re += h[n] * std::cos(w * n);
+				im -= h[n] * std::sin(w * n);
+			}
+			const float dB = static_cast<float>(10 * std::log10(re * re + im * im));
+			min_dB = std::min(min_dB, dB);
+			max_dB = std::max(max_dB, dB);
+		}
+		printf("multiband_compressor lr4 %u bands magnitude:\t%g, %g dB\n", band_count, min_dB, max_dB);
+		BOOST_CHECK(min_dB > -0.01f);
+		BOOST_CHECK(max_dB < 0.01f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(pool_growth_resets_bands)
+{
+	const unsigned C = 2, N = 200;
+	mbc m(transparent_params(C, N, 2, mbc::crossover_fir));
+	BOOST_CHECK_EQUAL(0u, m.max_band_count());
+	std::vector<float> x, y;
+	process(m, 5, x, y);
+
+	m.set_params(transparent_params(C, N, 3, mbc::crossover_fir));
+	BOOST_CHECK_EQUAL(3u, m.band_count());
+	// reallocated bands start from silence, so the output is a pure delay of the input fed after the growth
+	x.clear();
+	y.clear();
+	process(m, 10, x, y);
+	const float err = delay_error(x, y, C, fir_delay);
+	printf("multiband_compressor pool growth delay err:\t%g\n", err);
+	BOOST_CHECK(err < 1e-5f);
+}
+
+// Fields added to params over time must default to the original behaviour for callers unaware of them.
+BOOST_AUTO_TEST_CASE(params_defaults)
+{
+	mbc::params p;
+	p.sample_rate = sample_rate;
+	p.channel_count = 2;
+	p.block_size = 200;
+	p.bands.assign(5, transparent_band());
+	for (unsigned i = 1; i < 5; ++i)
+		p.crossover_frequencies.push_back(250.f * std::pow(4.f, i - 1.f));
+	p.limiter_threshold_dB = -1.f;
+	p.limiter_bypass = true;
+	mbc m(p);
+	BOOST_CHECK_EQUAL(0u, m.max_band_count());
+	BOOST_CHECK_EQUAL(mbc::crossover_fir, m.crossover());
+	BOOST_CHECK_EQUAL(1u, m.thread_count());
+	mbc::params q;
+	m.fill_params(q);
+	BOOST_CHECK(q.cpu_affinity.empty());
+	BOOST_CHECK_EQUAL(0, q.worker_priority);
+	BOOST_CHECK_EQUAL(5u, m.band_count());
+}
+
+BOOST_AUTO_TEST_CASE(max_band_count_contract)
+{
+	const unsigned C = 2, N = 200;
+	mbc::params p = transparent_params(C, N, 2, mbc::crossover_fir);
+	p.max_band_count = 3;
+	mbc m(p);
+	BOOST_CHECK_EQUAL(3u, m.max_band_count());
+	mbc::params q;
+	m.fill_params(q);
+	BOOST_CHECK_EQUAL(3u, q.max_band_count);
+
+	BOOST_CHECK_THROW(m.set_params(transparent_params(C, N, 4, mbc::crossover_fir)), std::length_error);
+	BOOST_CHECK_EQUAL(2u, m.band_count());
+	mbc::params r = transparent_params(C, N, 4, mbc::crossover_fir);
+	r.max_band_count = 3;
+	BOOST_CHECK_THROW(mbc n(r), std::length_error);
+
+	// growing within the capacity keeps the band state, output returns to a pure delay once the filters are crossfaded
+	std::vector<float> x, y;
+	process(m, 2, x, y);
+	m.set_params(transparent_params(C, N, 3, mbc::crossover_fir));
+	BOOST_CHECK_EQUAL(3u, m.band_count());
+	process(m, 10, x, y);
+	const float err = delay_error(x, y, C, fir_delay, 5 * N);
+	printf("multiband_compressor growth within capacity delay err:\t%g\n", err);
+	BOOST_CHECK(err < 1e-5f);
+}
+
+BOOST_AUTO_TEST_CASE(worker_pool_matches_single_thread)
+{
+	const unsigned C = 2, N = 256, B = 50;
+	const mbc::crossover_type types[] = {mbc::crossover_fir, mbc::crossover_lr4};
+	for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+		// compressors engaged and limiter enabled, so that every stage contributes to the output
+		mbc::params p = transparent_params(C, N, 4, types[t]);
+		for (size_t i = 0; i < p.bands.size(); ++i) {
+			p.bands[i].bypass = false;
+			p.bands[i].ratio = 4.f;
+			p.bands[i].gain_dB = 3.f;
+		}
+		p.limiter_bypass = false;
+		mbc single(p);
+		p.thread_count = 3;
+		mbc parallel(p);
+		BOOST_CHECK_EQUAL(3u, parallel.thread_count());
+
+		std::vector<float> x, y1, y3(B * N * C);
+		process(single, B, x, y1);
+		for (unsigned b = 0; b < B; ++b) {
+			if (b % 10 == 5)	// let the workers fall asleep, so that they have to be woken up
+				boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+			parallel(&x[b * N * C], &y3[b * N * C]);
+		}
+		size_t mismatch = 0;
+		for (size_t i = 0; i < y1.size(); ++i)
+			if (y1[i] != y3[i])
+				++mismatch;
+		BOOST_CHECK_EQUAL(0u, mismatch);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_crossover_change)
+{
+	const unsigned C = 2, N = 64;
+	mbc m(transparent_params(C, N, 3, mbc::crossover_fir));
+	boost::atomic<bool> stop(false);
+	size_t block_count = 0;
+	bool bounded = true;
+	boost::thread t(&process_until, &m, &stop, &block_count, &bounded);
+	for (int i = 0; i < 100; ++i) {
+		m.set_crossover_frequency(0, (i % 2 ? 400.f : 200.f));
+		m.set_crossover_frequency(1, (i % 2 ? 4000.f : 2000.f));
+	}
+	stop = true;
+	t.join();
+	BOOST_CHECK(block_count > 0);
+	BOOST_CHECK(bounded);
+	BOOST_CHECK_EQUAL(400.f, m.crossover_frequency(0));
+	BOOST_CHECK_EQUAL(4000.f, m.crossover_frequency(1));
+
+	// once the last filters are activated the bands sum up to the delayed input again
+	std::vector<float> x, y;
+	process(m, 10, x, y);
+	const float err = delay_error(x, y, C, fir_delay, 2 * N + fir_delay);
+	printf("multiband_compressor concurrent crossover change (%u blocks) delay err:\t%g\n", unsigned(block_count), err);
+	BOOST_CHECK(err < 1e-5f);
+}
+
+BOOST_AUTO_TEST_SUITE_END()